@@ -115,50 +115,183 @@ static inline void OscBmpWriteHdrInfo(uint8 *pHdr,
 }
 
 /*********************************************************************//*!
- * @brief Reverse the row order of an OSC_PICTURE
+ * @brief Map a file into memory
  * 
- * @param pPic Pointer to the fully initialized OSC picture.
+ * The mapping is private, so the pages may be written without changing
+ * the file.
+ * 
+ * @param strFileName The file name of the picture to map.
+ * @param ppFile Where to store the address of the mapping.
+ * @param pFileSize Where to store the size of the file.
  * @return SUCCESS or an appropriate error code otherwise
  *//*********************************************************************/
-static OSC_ERR OscBmpReverseRowOrder(struct OSC_PICTURE *pPic)
+static OSC_ERR OscBmpMapFile(const char *strFileName, uint8 **ppFile,
+		size_t *pFileSize)
 {
-	void        *pTempRow;
-	uint8       bytesPerPixel;
-	uint32      rowLength;
-	int         i;
-	uint32      curFIndex, curBIndex;
-	uint8       *pData = (uint8*)pPic->data;
+	int             fd;
+	struct stat     fileStat;
+	void            *pFile;
 	
-	if(pPic->type == OSC_PICTURE_BGR_24)
+	fd = open(strFileName, O_RDONLY);
+	if(fd < 0)
+	{
+		OscLog(ERROR, "%s: Unable to open picture %s!\n",
+				__func__, strFileName);
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+	
+	if(fstat(fd, &fileStat) != 0 ||
+			(size_t)fileStat.st_size < sizeof(aryBmpHeadRGB))
+	{
+		OscLog(ERROR, "%s: Error reading in image header of %s!\n",
+				__func__, strFileName);
+		close(fd);
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+	
+	pFile = mmap(NULL, fileStat.st_size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE, fd, 0);
+	/* The mapping stays valid after closing the file */
+	close(fd);
+	if(pFile == MAP_FAILED)
+	{
+		OscLog(ERROR, "%s: Unable to map picture %s!\n",
+				__func__, strFileName);
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+	
+	*ppFile = (uint8*)pFile;
+	*pFileSize = fileStat.st_size;
+	return SUCCESS;
+}
+
+/*********************************************************************//*!
+ * @brief Check the header of a BMP file in memory
+ * 
+ * Fills in the picture structure after checking it against the
+ * format of the file if the caller has specified one.
+ * 
+ * @param pFile Pointer to the BMP file in memory.
+ * @param fileSize Size of the file.
+ * @param pPic Pointer to the OSC picture to check and fill in.
+ * @param ppPixels Where to store the address of the first pixel row
+ * in the file.
+ * @param pRowLen Where to store the padded length of a row in the file.
+ * @param pIsReversed Where to store whether the rows are stored bottom
+ * to top.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscBmpParse(const uint8 *pFile, size_t fileSize,
+		struct OSC_PICTURE *pPic, const uint8 **ppPixels,
+		uint32 *pRowLen, bool *pIsReversed)
+{
+	int32           dataOffset, width, height;
+	int16           colorDepth;
+	uint32          rowLen;
+	
+	OscBmpReadHdrInfo(pFile,
+			&width,
+			&height,
+			&dataOffset,
+			&colorDepth);
+	if(height > 0)
 	{
-		bytesPerPixel = 3;
-	} else if(pPic->type == OSC_PICTURE_GREYSCALE) {
-		bytesPerPixel = 1;
+		/* The row order is reversed (mirrored on y axis). This is
+		 * the default way that bitmaps are stored (reversed, so to
+		 * speak). */
+		*pIsReversed = TRUE;
 	} else {
+		*pIsReversed = FALSE;
+		height = height * (-1);
+	}
+	
+	/* Check the header for validity */
+	if(unlikely(colorDepth != 24 && colorDepth != 8))
+	{
+		OscLog(ERROR, "%s: Unsupported color depth: %d.\n",
+				__func__, colorDepth);
+		return -EUNSUPPORTED_FORMAT;
+	}
+	if(unlikely(dataOffset != sizeof(aryBmpHeadRGB) &&
+			dataOffset != sizeof(aryBmpHeadGrey)))
+	{
+		/* Only supported uncompressed headers without color table */
+		OscLog(ERROR, "%s: Unsupported BMP header size: %d.\n",
+				__func__, dataOffset);
 		return -EUNSUPPORTED_FORMAT;
 	}
 	
-	/* Temporary buffer to store one row */
-	rowLength = pPic->width * bytesPerPixel;
-	pTempRow = (void*)malloc(rowLength);
-	if(!pTempRow)
+	/* Padded to 4 bytes. */
+	rowLen = ((((uint32)width*(colorDepth/8)) + 3)/4)*4;
+	if(unlikely(width <= 0 || width > 0xffff || height > 0xffff ||
+			fileSize < dataOffset + (size_t)rowLen*height))
 	{
-		OscLog(CRITICAL, "%s: Memory allocation failed!\n", __func__);
-		return -EOUT_OF_MEMORY;
+		OscLog(ERROR, "%s: Error reading in image!\n", __func__);
+		return -EUNABLE_TO_OPEN_FILE;
 	}
 	
-	for(i = 0; i < pPic->height/2; i++)
+	/* If the caller has specified the desired image format check it
+	 * against the values from the header. */
+	if(unlikely((pPic->width != 0) && ((pPic->width != (uint32)width) ||
+					(pPic->height != (uint32)height))))
+	{
+		OscLog(ERROR, "%s: Wrong image format. %dx%d instead of %dx%d.\n",
+				__func__, width, height, pPic->width, pPic->height);
+		return -EWRONG_IMAGE_FORMAT;
+	}
+	if(pPic->data != NULL && pPic->width == 0)
 	{
-		/* Swap the rows */
-		curFIndex = i * rowLength;
-		curBIndex = (pPic->height - i - 1) * rowLength;
-		memcpy(pTempRow, &pData[curFIndex], rowLength);
-		memcpy(&pData[curFIndex], &pData[curBIndex], rowLength);
-		memcpy(&pData[curBIndex], pTempRow, rowLength);
+		/* Memory is already allocated by the caller, he needs to know
+		 * and supply the expected image format. */
+		OscLog(ERROR,
+				"%s: Unable to verify image format assumptions.\n",
+				__func__);
+		return -EUNABLE_TO_VERIFY_IMAGE_FORMAT;
 	}
 	
-	free(pTempRow);
-	return 0;
+	pPic->width = (uint32)width;
+	pPic->height = (uint32)height;
+	if(colorDepth == 24)
+	{
+		pPic->type = OSC_PICTURE_BGR_24;
+	} else { /* colorDepth == 8 */
+		pPic->type = OSC_PICTURE_GREYSCALE;
+	}
+	
+	*ppPixels = pFile + dataOffset;
+	*pRowLen = rowLen;
+	return SUCCESS;
+}
+
+/*********************************************************************//*!
+ * @brief Copy the pixels of a BMP file to a picture
+ * 
+ * Drops the row padding and, if the rows are stored bottom to top,
+ * reverses the row order during the copy.
+ * 
+ * @param pPic Pointer to the fully initialized OSC picture.
+ * @param pPixels Address of the first pixel row in the file.
+ * @param rowLen Padded length of a row in the file.
+ * @param bIsReversed Whether the rows are stored bottom to top.
+ *//*********************************************************************/
+static void OscBmpCopyRows(struct OSC_PICTURE *pPic, const uint8 *pPixels,
+		uint32 rowLen, bool bIsReversed)
+{
+	uint32      row, width = pPic->width*(OSC_PICTURE_TYPE_COLOR_DEPTH(pPic->type)/8);
+	uint8       *pData = (uint8*)pPic->data;
+	
+	if(!bIsReversed && rowLen == width)
+	{
+		memcpy(pData, pPixels, width*pPic->height);
+		return;
+	}
+	
+	for(row = 0; row < pPic->height; row++)
+	{
+		memcpy(&pData[row*width],
+				&pPixels[(bIsReversed ? pPic->height - 1 - row : row)*rowLen],
+				width);
+	}
 }
 
 uint8 OSC_PICTURE_TYPE_COLOR_DEPTH(enum EnOscPictureType enType)
@@ -169,6 +302,8 @@ uint8 OSC_PICTURE_TYPE_COLOR_DEPTH(enum EnOscPictureType enType)
 		return 24;
 	case OSC_PICTURE_RGB_24:
 		return 24;
+	case OSC_PICTURE_HSL_24:
+		return 24;
 	case OSC_PICTURE_YUV_444:
 		return 24;
 	case OSC_PICTURE_YUV_422:
@@ -177,6 +312,8 @@ uint8 OSC_PICTURE_TYPE_COLOR_DEPTH(enum EnOscPictureType enType)
 		return 24;
 	case OSC_PICTURE_YUV_400:
 		return 8;
+	case OSC_PICTURE_BINARY_PACKED:
+		return 1;
 	default:
 		return 8;
 	}
@@ -184,15 +321,12 @@ uint8 OSC_PICTURE_TYPE_COLOR_DEPTH(enum EnOscPictureType enType)
 
 OSC_ERR OscBmpRead(struct OSC_PICTURE *pPic, const char *strFileName)
 {
-	FILE            *pPicFile;
-	/* Temporary buffer to store the header */
-	unsigned char   *pHeader[sizeof(aryBmpHeadRGB)];
-	int32           dataOffset, width, height;
-	int16           colorDepth;
-	uint32          imgSize;
-	int             bIsReversed = FALSE;
-	uint16          row, rowLen;
-	uint8           *pData;
+	uint8           *pFile;
+	size_t          fileSize;
+	const uint8     *pPixels;
+	uint32          rowLen;
+	bool            bIsReversed;
+	OSC_ERR         err;
 	
 	if(pPic == NULL || strFileName == NULL || strFileName[0] == '\0')
 	{
@@ -201,122 +335,197 @@ OSC_ERR OscBmpRead(struct OSC_PICTURE *pPic, const char *strFileName)
 		return -EINVALID_PARAMETER;
 	}
 	
-	pPicFile = fopen(strFileName, "rb");
-	if(pPicFile == NULL)
+	err = OscBmpMapFile(strFileName, &pFile, &fileSize);
+	if(err != SUCCESS)
 	{
-		OscLog(ERROR, "%s: Unable to open picture %s!\n",
-				__func__, strFileName);
-		return -EUNABLE_TO_OPEN_FILE;
+		return err;
 	}
 	
-	/* Read in the header and extract the interesting fields */
-	if(fread(pHeader, 1, sizeof(aryBmpHeadRGB), pPicFile) != sizeof(aryBmpHeadRGB))
+	err = OscBmpParse(pFile, fileSize, pPic, &pPixels, &rowLen,
+			&bIsReversed);
+	if(err != SUCCESS)
 	{
-	    OscLog(ERROR, "%s: Error reading in image header of %s!\n",
-		   __func__, strFileName);
-	    fclose(pPicFile);
-	    return -EUNABLE_TO_OPEN_FILE;
+		munmap(pFile, fileSize);
+		return err;
 	}
-	OscBmpReadHdrInfo((uint8*)pHeader,
-			&width,
-			&height,
-			&dataOffset,
-			&colorDepth);
-	if(height > 0)
+	
+	if(pPic->data == NULL)
 	{
-		/* The row order is reversed (mirrored on y axis). This is
-		 * the default way that bitmaps are stored (reversed, so to
-		 * speak). */
-		bIsReversed = TRUE;
-	} else {
-		height = height * (-1);
+		/* We allocate the memory for the picture */
+		pPic->data = (void*)malloc((uint32)pPic->width*pPic->height*
+				(OSC_PICTURE_TYPE_COLOR_DEPTH(pPic->type)/8));
+		if(pPic->data == NULL)
+		{
+			OscLog(ERROR, "%s: Memory allocation error!\n", __func__);
+			munmap(pFile, fileSize);
+			return -EOUT_OF_MEMORY;
+		}
 	}
 	
-	/* Check the header for validity */
-	if(unlikely(colorDepth != 24 && colorDepth != 8))
+	/* Copy the pixels straight from the mapped file, in the right row
+	 * order */
+	OscBmpCopyRows(pPic, pPixels, rowLen, bIsReversed);
+	
+	munmap(pFile, fileSize);
+	return SUCCESS;
+}
+
+OSC_ERR OscBmpReadRegion(struct OSC_PICTURE *pPic, const char *strFileName,
+		const uint16 colOff, const uint16 rowOff, const uint32 bufferSize)
+{
+	struct OSC_PICTURE  filePic;
+	uint8               *pFile;
+	size_t              fileSize;
+	const uint8         *pPixels;
+	uint32              rowLen, width, row, srcRow;
+	bool                bIsReversed;
+	OSC_ERR             err;
+	
+	if(pPic == NULL || pPic->data == NULL || pPic->width == 0 ||
+			pPic->height == 0 || strFileName == NULL ||
+			strFileName[0] == '\0')
 	{
-		OscLog(ERROR, "%s: Unsupported color depth: %d.\n",
-				__func__, colorDepth);
-		fclose(pPicFile);
-		return -EUNSUPPORTED_FORMAT;
+		OscLog(ERROR, "%s(0x%x, %s): Invalid parameter.\n",
+				__func__, pPic, strFileName);
+		return -EINVALID_PARAMETER;
 	}
-	if(unlikely(dataOffset != sizeof(aryBmpHeadRGB) &&
-			dataOffset != sizeof(aryBmpHeadGrey)))
+	
+	err = OscBmpMapFile(strFileName, &pFile, &fileSize);
+	if(err != SUCCESS)
 	{
-		/* Only supported uncompressed headers without color table */
-		OscLog(ERROR, "%s: Unsupported BMP header size: %d.\n",
-				__func__, dataOffset);
-		fclose(pPicFile);
-		return -EUNSUPPORTED_FORMAT;
+		return err;
 	}
 	
-	imgSize = width*height*(colorDepth/8);
-	/* If the caller has specified the desired image format check it
-	 * against the values from the header. */
-	if(unlikely((pPic->width != 0) && ((pPic->width != (uint32)width) ||
-					(pPic->height != (uint32)height))))
+	/* Get the format of the whole picture in the file */
+	memset(&filePic, 0, sizeof(struct OSC_PICTURE));
+	err = OscBmpParse(pFile, fileSize, &filePic, &pPixels, &rowLen,
+			&bIsReversed);
+	if(err != SUCCESS)
 	{
-		OscLog(ERROR, "%s: Wrong image format. %dx%d instead of %dx%d.\n",
-				__func__, width, height, pPic->width, pPic->height);
-		fclose(pPicFile);
+		munmap(pFile, fileSize);
+		return err;
+	}
+	
+	if(unlikely(filePic.width < (uint32)colOff + pPic->width ||
+			filePic.height < (uint32)rowOff + pPic->height))
+	{
+		OscLog(ERROR, "%s: Region (%dx%d @ %d/%d) outside of picture "
+				"(%dx%d).\n", __func__, pPic->width, pPic->height,
+				colOff, rowOff, filePic.width, filePic.height);
+		munmap(pFile, fileSize);
 		return -EWRONG_IMAGE_FORMAT;
 	}
-	if(pPic->data != NULL)
+	
+	width = pPic->width*(OSC_PICTURE_TYPE_COLOR_DEPTH(filePic.type)/8);
+	if(unlikely(width*pPic->height > bufferSize))
 	{
-		/* Memory is already allocated by the caller, he needs to know
-		 * and supply the expected image format. */
-		if(pPic->width == 0)
+		OscLog(ERROR, "%s: Buffer too small (%u < %u).\n",
+				__func__, bufferSize, width*pPic->height);
+		munmap(pFile, fileSize);
+		return -EBUFFER_TOO_SMALL;
+	}
+	pPic->type = filePic.type;
+	
+	/* Copy only the rows and columns of the region, only the pages of
+	 * the file containing them are read. */
+	pPixels += colOff*(OSC_PICTURE_TYPE_COLOR_DEPTH(filePic.type)/8);
+	for(row = 0; row < pPic->height; row++)
+	{
+		srcRow = rowOff + row;
+		if(bIsReversed)
 		{
-			fclose(pPicFile);
-			OscLog(ERROR,
-					"%s: Unable to verify image format assumptions.\n",
-					__func__);
-			return -EUNABLE_TO_VERIFY_IMAGE_FORMAT;
+			srcRow = filePic.height - 1 - srcRow;
 		}
+		memcpy((uint8*)pPic->data + row*width, pPixels + srcRow*rowLen,
+				width);
+	}
+	
+	munmap(pFile, fileSize);
+	return SUCCESS;
+}
+
+OSC_ERR OscBmpMap(struct OSC_PICTURE *pPic, const char *strFileName,
+		void **phBmp)
+{
+	struct BMP_MAPPING  *pMapping;
+	const uint8         *pPixels;
+	uint32              rowLen;
+	bool                bIsReversed;
+	OSC_ERR             err;
+	
+	if(pPic == NULL || phBmp == NULL || pPic->data != NULL ||
+			strFileName == NULL || strFileName[0] == '\0')
+	{
+		OscLog(ERROR, "%s(0x%x, %s): Invalid parameter.\n",
+				__func__, pPic, strFileName);
+		return -EINVALID_PARAMETER;
+	}
+	
+	pMapping = (struct BMP_MAPPING*)malloc(sizeof(struct BMP_MAPPING));
+	if(pMapping == NULL)
+	{
+		OscLog(ERROR, "%s: Memory allocation error!\n", __func__);
+		return -EOUT_OF_MEMORY;
+	}
+	pMapping->pCopy = NULL;
+	
+	err = OscBmpMapFile(strFileName, &pMapping->pFile, &pMapping->fileSize);
+	if(err != SUCCESS)
+	{
+		free(pMapping);
+		return err;
+	}
+	
+	err = OscBmpParse(pMapping->pFile, pMapping->fileSize, pPic, &pPixels,
+			&rowLen, &bIsReversed);
+	if(err != SUCCESS)
+	{
+		OscBmpUnmap(pMapping);
+		return err;
+	}
+	
+	if(!bIsReversed &&
+			rowLen == pPic->width*(OSC_PICTURE_TYPE_COLOR_DEPTH(pPic->type)/8))
+	{
+		/* The pixels can be used where they are */
+		pPic->data = (void*)pPixels;
 	} else {
-		/* We allocate the memory for the picture */
-		pPic->data = (void*)malloc(imgSize);
-		if(pPic->data == NULL)
+		pMapping->pCopy = malloc((uint32)pPic->width*pPic->height*
+				(OSC_PICTURE_TYPE_COLOR_DEPTH(pPic->type)/8));
+		if(pMapping->pCopy == NULL)
 		{
 			OscLog(ERROR, "%s: Memory allocation error!\n", __func__);
+			OscBmpUnmap(pMapping);
 			return -EOUT_OF_MEMORY;
 		}
+		pPic->data = pMapping->pCopy;
+		OscBmpCopyRows(pPic, pPixels, rowLen, bIsReversed);
+		
+		/* The file is not needed anymore */
+		munmap(pMapping->pFile, pMapping->fileSize);
+		pMapping->pFile = NULL;
 	}
 	
-	pPic->width = (uint32)width;
-	pPic->height = (uint32)height;
-	if(colorDepth == 24)
-	{
-		pPic->type = OSC_PICTURE_BGR_24;
-	} else { /* colorDepth == 8 */
-		pPic->type = OSC_PICTURE_GREYSCALE;
-	}
-		
-	/* Seek the pixel data portion of the file and read it in */
-	fseek(pPicFile, dataOffset, SEEK_SET);
+	*phBmp = pMapping;
+	return SUCCESS;
+}
+
+OSC_ERR OscBmpUnmap(void *hBmp)
+{
+	struct BMP_MAPPING  *pMapping = (struct BMP_MAPPING*)hBmp;
 	
-	/* Padded to 4 bytes. */
-	rowLen = ((((uint32)pPic->width*(colorDepth/8)) + 3)/4)*4;
-	pData = (uint8*)pPic->data;
-	for(row = 0; row < pPic->height; row++)
+	if(pMapping == NULL)
 	{
-	  if(fread(&pData[row*pPic->width*colorDepth/8], 1,
-		   rowLen, pPicFile) != rowLen)
-	    {
-	      OscLog(ERROR, "%s: Error reading in image from %s!\n",
-		   __func__, strFileName);
-	      fclose(pPicFile);
-	      return -EUNABLE_TO_OPEN_FILE;
-	    }
+		OscLog(ERROR, "%s: Invalid parameter.\n", __func__);
+		return -EINVALID_PARAMETER;
 	}
 	
-	fclose(pPicFile);
-	
-	if(bIsReversed)
+	if(pMapping->pFile != NULL)
 	{
-		/* The row order is reversed */
-		return OscBmpReverseRowOrder(pPic);
+		munmap(pMapping->pFile, pMapping->fileSize);
 	}
+	free(pMapping->pCopy);
+	free(pMapping);
 	return SUCCESS;
 }
 
@@ -27,6 +27,10 @@
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "oscar.h"
 
@@ -43,6 +47,13 @@
 /*! @brief Offset of image size field in BMP header */
 #define BMP_HEADER_FIELD_IMAGE_SIZE 34
 
+/*! @brief A picture returned by OscBmpMap(). */
+struct BMP_MAPPING {
+	uint8 *pFile;       /*!< @brief The mapped file or NULL if it has been unmapped */
+	size_t fileSize;    /*!< @brief Size of the mapping */
+	void *pCopy;        /*!< @brief The pixels if they had to be copied, NULL otherwise */
+};
+
 /*! @brief The color depth of a RGB image in the BMP header */
 #define BMP_BPP_RGB             24
 
@@ -25,6 +25,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <pthread.h>
 
 #include "oscar.h"
 
@@ -32,6 +33,8 @@
 #include "mt9v032.h"
 /*! @brief The multi buffer class */
 #include "cam_multibuffer.h"
+/*! @brief The frame ring class */
+#include "cam_ring.h"
 
 /*! @brief The device node which represents the camera */
 #define VIDEO_DEVICE_FILE "/dev/video0"
@@ -68,7 +71,124 @@
 /*! @brief The config file used to set up the filename reader. */
 #define FILENAME_READER_CONFIG_FILE "cam.frdconf"
 
+/*! @brief The auto exposure, see OscCamSetAutoExposure(). */
+struct CAM_AEC
+{
+	/*! @brief Whether the auto exposure is enabled. */
+	bool bEnabled;
+	/*! @brief The configuration. */
+	struct OSC_CAM_AEC_CONFIG config;
+	/*! @brief The statistics reported to the application. */
+	struct OSC_CAM_AEC_STATS stats;
+	/*! @brief Pictures to read until the next analysis. */
+	uint16 framesToUpdate;
+	/*! @brief Pictures read since enabled or since convergence was
+	 * lost. */
+	uint32 framesUnconverged;
+	/*! @brief The automatic exposure and gain control of the sensor
+	 * before the loop was enabled, restored when it is disabled. */
+	uint16 sensorAecAgc;
+};
+
+/*! @brief Host only: Frame rate the times of the pictures are derived
+ * from, see struct OSC_CAM_FRAME_INFO. */
+#define CAM_HOST_FRAME_RATE 60
+
+/*! @brief Time in microseconds the capture stream waits before it
+ * retries when all frames are held. */
+#define CAM_STREAM_RETRY_DELAY 1000
+
+/*! @brief A thread capturing continuously into the frame ring, see
+ * OscCamStartStreaming(). */
+struct CAM_STREAM
+{
+	/*! @brief Whether the threads are running. */
+	bool bRunning;
+	/*! @brief Set to make the threads stop. */
+	volatile bool bStop;
+	/*! @brief The capturing thread. */
+	pthread_t captureThread;
+	/*! @brief The thread calling the callback if one is given. */
+	pthread_t callbackThread;
+	/*! @brief Read and write end of the pipe signalling captured
+	 * frames. */
+	int fds[2];
+	/*! @brief The function to call with every frame or NULL. */
+	OscCamFrameCallback pCallback;
+	/*! @brief Passed to the callback. */
+	void *pUserData;
+	/*! @brief Timeout passed to OscCamReadPicture(). */
+	uint16 timeout;
+	/*! @brief The last error of the capture, to only log it once. */
+	OSC_ERR lastError;
+#if defined(OSC_HOST) || defined(OSC_SIM)
+	/*! @brief Host only: The simulation time step of the last capture. */
+	uint32 lastTimeStep;
+#endif /* OSC_HOST or OSC_SIM*/
+};
+
 #if defined(OSC_HOST) || defined(OSC_SIM)
+#include <sys/stat.h>
+
+/*! @brief Host only: The maximum number of frames in the frame cache. */
+#define CAM_MAX_CACHED_FRAMES 64
+/*! @brief Host only: The default number of frames in the frame cache. */
+#define CAM_DEFAULT_CACHED_FRAMES 8
+/*! @brief Host only: The default number of frames loaded ahead. */
+#define CAM_DEFAULT_PREFETCH_DEPTH 4
+/*! @brief Host only: The maximum length of a test image file name. */
+#define CAM_MAX_FILE_NAME_LEN 1024
+
+/*! @brief Host only: The states of an entry in the frame cache */
+enum EnOscCamCacheEntryStatus {
+	CACHE_ENTRY_EMPTY,
+	CACHE_ENTRY_QUEUED,    /*!< @brief To be loaded by the prefetcher */
+	CACHE_ENTRY_LOADING,
+	CACHE_ENTRY_VALID
+};
+
+/*! @brief Host only: A decoded test image in the frame cache */
+struct CAM_CACHED_FRAME
+{
+	enum EnOscCamCacheEntryStatus status;
+	/*! @brief The file the picture was read from. */
+	char strFileName[CAM_MAX_FILE_NAME_LEN];
+	/*! @brief The full, uncropped picture. */
+	struct OSC_PICTURE pic;
+	/*! @brief Identity and modification time of the file when it was
+	 * read, to notice when it is replaced. */
+	dev_t dev;
+	ino_t ino;
+	off_t size;
+	struct timespec mtime;
+	/*! @brief Value of the use counter at the last access. */
+	uint32 lastUse;
+	/*! @brief Number of readers currently using the picture. */
+	uint16 users;
+};
+
+/*! @brief Host only: Cache of decoded test images, filled ahead of the
+ * simulation by a prefetch thread. */
+struct CAM_FRAME_CACHE
+{
+	struct CAM_CACHED_FRAME frames[CAM_MAX_CACHED_FRAMES];
+	/*! @brief Number of frames used, 0 if the cache is disabled. */
+	uint16 nrOfFrames;
+	/*! @brief Number of time steps loaded ahead. */
+	uint16 prefetchDepth;
+	/*! @brief Incremented on every access, for the LRU replacement. */
+	uint32 useCounter;
+	
+	pthread_mutex_t lock;
+	/*! @brief Signals the prefetch thread that frames are queued. */
+	pthread_cond_t queued;
+	/*! @brief Signals waiting readers that a frame has been loaded. */
+	pthread_cond_t loaded;
+	pthread_t thread;
+	bool bThreadRunning;
+	bool bStopThread;
+};
+
 /*! @brief Host only: The different states a frame buffer can be in */
 enum EnOscFrameBufferStatus {
 	STATUS_UNITIALIZED,
@@ -88,6 +208,11 @@ struct OSC_CAM
 	/*! @brief Describes a multi buffer for automatic buffer management
 	 * if activated */
 	struct OSC_CAM_MULTIBUFFER multiBuffer;
+	/*! @brief Frame buffers shared between a capturing thread and
+	 * processing threads if activated */
+	struct OSC_CAM_FRAME_RING frameRing;
+	/*! @brief Captures continuously into the frame ring if started */
+	struct CAM_STREAM stream;
 	/*! @brief Video driver device file descriptor */
 	int vidDev;
 
@@ -106,8 +231,17 @@ struct OSC_CAM
 	uint16 curHorizBlank;
 	/*! @brief The current exposure time in microseconds. */
 	uint32 curExpTime;
+	/*! @brief The current black level offset. */
+	uint16 curBlackLevel;
+	
+	/*! @brief Description of the picture captured to every frame
+	 * buffer */
+	struct OSC_CAM_FRAME_INFO frameInfo[MAX_NR_FRAME_BUFFERS];
+	/*! @brief Whether the picture of a frame buffer has been read */
+	bool bFrameInfoValid[MAX_NR_FRAME_BUFFERS];
+	/*! @brief Number of captures set up so far */
+	uint32 nCaptures;
 	
-#ifdef OSC_TARGET
 	/*! @brief Pointer to callback fxn for image correction */
 	int (*pCallback)(
 			uint8 *pImg,
@@ -115,7 +249,12 @@ struct OSC_CAM
 					const uint16 lowY,
 					const uint16 width,
 					const uint16 height);
-#endif /*OSC_TARGET*/
+	/*! @brief Whether the built-in correction is enabled */
+	bool bCorrection;
+	/*! @brief Calibration tables of the built-in correction */
+	struct OSC_CAM_CORRECTION correction;
+	/*! @brief The auto exposure */
+	struct CAM_AEC aec;
 	
 	/* Members only needed for the host implementation */
 #if defined(OSC_HOST) || defined(OSC_SIM)
@@ -133,9 +272,62 @@ struct OSC_CAM
 	/*! @brief Host only: The handle to the file name reader used to
 	 * generate the file names of the test images. */
 	void *hFNReader;
+	/*! @brief Host only: Decoded test images. */
+	struct CAM_FRAME_CACHE cache;
 #endif /* OSC_HOST or OSC_SIM*/
 };
 
 /*======================= Private methods ==============================*/
 
+/*********************************************************************//*!
+ * @brief Get the time of the monotonic clock in microseconds.
+ *//*********************************************************************/
+uint64_t OscCamGetTime();
+
+/*********************************************************************//*!
+ * @brief Start the description of the picture captured to a frame
+ * buffer with the current settings.
+ * 
+ * Called when a capture has been set up.
+ * 
+ * @param fb The frame buffer captured to.
+ *//*********************************************************************/
+void OscCamFrameInfoSetup(const uint8 fb);
+
+/*********************************************************************//*!
+ * @brief Copy a row of a picture and apply the built-in correction.
+ * 
+ * The source and destination may be the same to correct in place.
+ * 
+ * @param pDst Where to write the corrected pixels.
+ * @param pSrc The raw pixels.
+ * @param width Number of pixels in the row.
+ * @param bytesPerPixel 1 for raw pictures, 3 for BGR pictures.
+ * @param col Sensor column of the first pixel.
+ * @param row Sensor row of the pixels.
+ *//*********************************************************************/
+void OscCamCorrectRow(uint8 *pDst, const uint8 *pSrc, const uint16 width,
+		const uint16 bytesPerPixel, const uint16 col, const uint16 row);
+
+/*********************************************************************//*!
+ * @brief Run the auto exposure on a picture that has been read.
+ * 
+ * @param pPic The picture.
+ * @param width Width of the picture.
+ * @param height Height of the picture.
+ * @param bytesPerPixel 1 for raw pictures, 3 for BGR pictures.
+ *//*********************************************************************/
+void OscCamAecProcess(const uint8 *pPic, const uint16 width,
+		const uint16 height, const uint16 bytesPerPixel);
+
+/*********************************************************************//*!
+ * @brief Apply the built-in correction in place to a captured window.
+ * 
+ * @param pImg The picture.
+ * @param pWin The window of the sensor the picture was captured from.
+ * @param bytesPerPixel 1 for raw pictures, 3 for BGR pictures.
+ *//*********************************************************************/
+void OscCamCorrectWindow(uint8 *pImg, const struct capture_window *pWin,
+		const uint16 bytesPerPixel);
+
 #endif /* CAM_PRIV_H_ */
@@ -0,0 +1,258 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+	
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+	
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+	
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+/*! @file
+ * @brief Auto exposure implementation
+	
+ * Computes a subsampled luminance histogram of the pictures read and
+ * adjusts the shutter proportionally to the deviation of the mean
+ * luminance from the target, see OscCamSetAutoExposure(). Only picture
+ * counts are used, no time, so the loop behaves the same on every run
+ * against the same pictures.
+ */
+
+#include "cam.h"
+
+extern struct OSC_CAM cam;
+
+/*! @brief Largest factor the exposure time is changed by per update. */
+#define AEC_MAX_FACTOR 8
+
+/*==================== Private method prototypes =======================*/
+/*********************************************************************//*!
+ * @brief Compute the luminance histogram of a picture.
+ * 
+ * @param pPic The picture.
+ * @param width Width of the picture.
+ * @param height Height of the picture.
+ * @param bytesPerPixel 1 for raw pictures, 3 for BGR pictures.
+ * @return The mean luminance.
+ *//*********************************************************************/
+static uint8 OscCamAecHistogram(const uint8 *pPic, const uint16 width,
+		const uint16 height, const uint16 bytesPerPixel);
+
+/*********************************************************************//*!
+ * @brief Change the exposure time towards the target.
+ *//*********************************************************************/
+static void OscCamAecUpdate();
+
+/*=========================== Code =====================================*/
+
+static uint8 OscCamAecHistogram(const uint8 *pPic, const uint16 width,
+		const uint16 height, const uint16 bytesPerPixel)
+{
+	struct OSC_CAM_AEC_STATS *pStats = &cam.aec.stats;
+	const uint8 *pRow, *pNext;
+	uint32      step = 2*cam.aec.config.subsample;
+	uint32      stride = width*bytesPerPixel;
+	uint32      x, y, lum, sum = 0, n = 0;
+	
+	memset(pStats->histogram, 0, sizeof(pStats->histogram));
+	
+	for(y = 0; y + 1 < height; y += step)
+	{
+		pRow = pPic + y*stride;
+		pNext = pRow + stride;
+		if(bytesPerPixel == 1)
+		{
+			/* Every 2x2 cell has one red, one blue and two green
+			 * pixels, whatever the Bayer order. */
+			for(x = 0; x + 1 < width; x += step)
+			{
+				lum = (pRow[x] + pRow[x + 1] + pNext[x] + pNext[x + 1]) >> 2;
+				pStats->histogram[lum*OSC_CAM_AEC_HIST_BINS/256]++;
+				sum += lum;
+				n++;
+			}
+		} else {
+			/* BGR pictures of the host */
+			for(x = 0; x < width; x += step)
+			{
+				lum = (pRow[3*x] + 2*pRow[3*x + 1] + pRow[3*x + 2]) >> 2;
+				pStats->histogram[lum*OSC_CAM_AEC_HIST_BINS/256]++;
+				sum += lum;
+				n++;
+			}
+		}
+	}
+	
+	pStats->nSamples = n;
+	pStats->nSaturated = pStats->histogram[OSC_CAM_AEC_HIST_BINS - 1];
+	return (n == 0) ? 0 : (uint8)(sum/n);
+}
+
+static void OscCamAecUpdate()
+{
+	struct OSC_CAM_AEC_CONFIG *pConfig = &cam.aec.config;
+	uint64_t    exposure = cam.curExpTime, target;
+	uint32      mean = cam.aec.stats.mean;
+	
+	/* The exposure time that would give the target brightness if the
+	 * luminance was proportional to it */
+	target = exposure*pConfig->targetBrightness/(mean == 0 ? 1 : mean);
+	if(target > exposure*AEC_MAX_FACTOR)
+	{
+		target = exposure*AEC_MAX_FACTOR;
+	} else if(target < exposure/AEC_MAX_FACTOR) {
+		target = exposure/AEC_MAX_FACTOR;
+	}
+	
+	/* Go part of the way */
+	if(target > exposure)
+	{
+		exposure += (target - exposure)*pConfig->damping/100;
+	} else {
+		exposure -= (exposure - target)*pConfig->damping/100;
+	}
+	
+	if(exposure < pConfig->minExposure)
+	{
+		exposure = pConfig->minExposure;
+	} else if(exposure > pConfig->maxExposure) {
+		exposure = pConfig->maxExposure;
+	}
+	
+	if(exposure != cam.curExpTime &&
+			OscCamSetShutterWidth((uint32)exposure) == SUCCESS)
+	{
+		cam.aec.stats.nUpdates++;
+	}
+	cam.aec.stats.exposure = cam.curExpTime;
+}
+
+void OscCamAecProcess(const uint8 *pPic, const uint16 width,
+		const uint16 height, const uint16 bytesPerPixel)
+{
+	struct CAM_AEC *pAec = &cam.aec;
+	struct OSC_CAM_AEC_STATS *pStats = &pAec->stats;
+	
+	pStats->nFrames++;
+	pAec->framesUnconverged++;
+	if(--pAec->framesToUpdate != 0)
+	{
+		return;
+	}
+	pAec->framesToUpdate = pAec->config.cadence;
+	
+	pStats->nAnalysed++;
+	pStats->mean = OscCamAecHistogram(pPic, width, height, bytesPerPixel);
+	pStats->error = (int16)pStats->mean - pAec->config.targetBrightness;
+	
+	if(pStats->error <= pAec->config.tolerance &&
+			-pStats->error <= pAec->config.tolerance)
+	{
+		if(!pStats->bConverged)
+		{
+			pStats->bConverged = TRUE;
+			pStats->framesToConverge = pAec->framesUnconverged;
+		}
+		return;
+	}
+	
+	if(pStats->bConverged)
+	{
+		/* Lost convergence, e.g. because the scene changed */
+		pStats->bConverged = FALSE;
+		pStats->framesToConverge = 0;
+		pAec->framesUnconverged = 0;
+	}
+	OscCamAecUpdate();
+}
+
+OSC_ERR OscCamSetAutoExposure(const struct OSC_CAM_AEC_CONFIG *pConfig)
+{
+	OSC_ERR     err;
+	uint16      sensorAecAgc;
+	
+	if(pConfig == NULL)
+	{
+		if(cam.aec.bEnabled)
+		{
+			/* Hand the exposure back to the sensor as it was set up. */
+			err = OscCamSetRegisterValue(CAM_REG_AEC_AGC_ENA,
+					cam.aec.sensorAecAgc);
+			if(err != SUCCESS)
+			{
+				OscLog(ERROR, "%s: Unable to restore the sensor auto "
+						"exposure (%d)!\n", __func__, err);
+				return err;
+			}
+		}
+		cam.aec.bEnabled = FALSE;
+		return SUCCESS;
+	}
+	
+	/* Input validation */
+	if(pConfig->targetBrightness == 0 || pConfig->targetBrightness == 255 ||
+			pConfig->damping == 0 || pConfig->damping > 100 ||
+			pConfig->cadence == 0 || pConfig->subsample == 0 ||
+			pConfig->minExposure == 0 ||
+			pConfig->minExposure > pConfig->maxExposure)
+	{
+		OscLog(ERROR, "%s: Invalid configuration!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+	
+	if(cam.aec.bEnabled)
+	{
+		/* Reconfigured, the sensor is already switched off. */
+		sensorAecAgc = cam.aec.sensorAecAgc;
+	} else {
+		err = OscCamGetRegisterValue(CAM_REG_AEC_AGC_ENA, &sensorAecAgc);
+		if(err != SUCCESS)
+		{
+			OscLog(ERROR, "%s: Unable to read the sensor auto exposure "
+					"(%d)!\n", __func__, err);
+			return err;
+		}
+		/* The sensor must not fight the loop. */
+		err = OscCamSetRegisterValue(CAM_REG_AEC_AGC_ENA, 0x0);
+		if(err != SUCCESS)
+		{
+			OscLog(ERROR, "%s: Unable to disable the sensor auto exposure "
+					"(%d)!\n", __func__, err);
+			return err;
+		}
+	}
+	
+	memset(&cam.aec, 0, sizeof(struct CAM_AEC));
+	cam.aec.config = *pConfig;
+	cam.aec.sensorAecAgc = sensorAecAgc;
+	cam.aec.framesToUpdate = 1;
+	cam.aec.stats.exposure = cam.curExpTime;
+	cam.aec.bEnabled = TRUE;
+	return SUCCESS;
+}
+
+OSC_ERR OscCamGetAutoExposureStats(struct OSC_CAM_AEC_STATS *pStats)
+{
+	/* Input validation */
+	if(pStats == NULL)
+	{
+		OscLog(ERROR, "%s(0x%x): Invalid parameter!\n", __func__, pStats);
+		return -EINVALID_PARAMETER;
+	}
+	if(!cam.aec.bEnabled)
+	{
+		return -ENOT_INITIALIZED;
+	}
+	
+	*pStats = cam.aec.stats;
+	return SUCCESS;
+}
@@ -0,0 +1,269 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+	
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+	
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+	
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+/*! @file
+ * @brief Built-in correction of the sensor defects
+	
+ * Removes the fixed pattern noise, the photo response non-uniformity
+ * and the hot pixels with one pass over every row, see
+ * OscCamSetCorrection(). Raw rows are corrected 16 pixels at a time
+ * with SSE2 where available.
+ */
+
+#include "cam.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+extern struct OSC_CAM cam;
+
+/*! @brief Saturate an integer to the range of a pixel. */
+#define CLAMP_PIXEL(x) ((x) < 0 ? 0 : ((x) > 255 ? 255 : (x)))
+
+/*==================== Private method prototypes =======================*/
+/*********************************************************************//*!
+ * @brief Apply the offset and gain tables to a row of a raw picture.
+ * 
+ * @param pDst Where to write the corrected pixels.
+ * @param pSrc The raw pixels.
+ * @param pOffset The offsets of the pixels or NULL.
+ * @param pGain The gains of the pixels or NULL.
+ * @param width Number of pixels in the row.
+ *//*********************************************************************/
+static void OscCamCorrectRawRow(uint8 *pDst, const uint8 *pSrc,
+		const uint8 * restrict pOffset, const uint8 * restrict pGain,
+		const uint16 width);
+
+/*********************************************************************//*!
+ * @brief Replace the hot pixels in a corrected row.
+ * 
+ * @param pRow The corrected row.
+ * @param width Number of pixels in the row.
+ * @param bytesPerPixel 1 for raw pictures, 3 for BGR pictures.
+ * @param pos Sensor position of the first pixel of the row.
+ *//*********************************************************************/
+static void OscCamReplaceHotPixels(uint8 *pRow, const uint16 width,
+		const uint16 bytesPerPixel, const uint32 pos);
+
+/*=========================== Code =====================================*/
+
+static void OscCamCorrectRawRow(uint8 *pDst, const uint8 *pSrc,
+		const uint8 * restrict pOffset, const uint8 * restrict pGain,
+		const uint16 width)
+{
+	int32 i = 0, value;
+	
+#if defined(__SSE2__)
+	const __m128i zero = _mm_setzero_si128();
+	__m128i pix, gain, lo, hi;
+	
+	for(; i + 16 <= width; i += 16)
+	{
+		pix = _mm_loadu_si128((const __m128i*)(pSrc + i));
+		if(pOffset != NULL)
+		{
+			/* Saturates at 0 */
+			pix = _mm_subs_epu8(pix,
+					_mm_loadu_si128((const __m128i*)(pOffset + i)));
+		}
+		if(pGain != NULL)
+		{
+			/* The products fit into 16 bits, the packing saturates at
+			 * 255. */
+			gain = _mm_loadu_si128((const __m128i*)(pGain + i));
+			lo = _mm_mullo_epi16(_mm_unpacklo_epi8(pix, zero),
+					_mm_unpacklo_epi8(gain, zero));
+			hi = _mm_mullo_epi16(_mm_unpackhi_epi8(pix, zero),
+					_mm_unpackhi_epi8(gain, zero));
+			pix = _mm_packus_epi16(_mm_srli_epi16(lo, 7),
+					_mm_srli_epi16(hi, 7));
+		}
+		_mm_storeu_si128((__m128i*)(pDst + i), pix);
+	}
+#endif /* __SSE2__ */
+	
+	/* The remaining pixels */
+	if(pGain == NULL)
+	{
+		for(; i < width; i++)
+		{
+			value = (int32)pSrc[i] - pOffset[i];
+			pDst[i] = CLAMP_PIXEL(value);
+		}
+	} else if(pOffset == NULL) {
+		for(; i < width; i++)
+		{
+			value = ((int32)pSrc[i]*pGain[i]) >> 7;
+			pDst[i] = CLAMP_PIXEL(value);
+		}
+	} else {
+		for(; i < width; i++)
+		{
+			value = (int32)pSrc[i] - pOffset[i];
+			value = (CLAMP_PIXEL(value)*pGain[i]) >> 7;
+			pDst[i] = CLAMP_PIXEL(value);
+		}
+	}
+}
+
+static void OscCamReplaceHotPixels(uint8 *pRow, const uint16 width,
+		const uint16 bytesPerPixel, const uint32 pos)
+{
+	const uint32 *pHot = cam.correction.pHotPixels;
+	uint32      lo = 0, hi = cam.correction.nHotPixels, mid;
+	/* Distance to the nearest pixel of the same color */
+	uint16      dist = (bytesPerPixel == 1) ? 2 : 1;
+	uint16      x, c;
+	uint8       *pPix;
+	
+	/* Find the first hot pixel in the row. */
+	while(lo < hi)
+	{
+		mid = (lo + hi)/2;
+		if(pHot[mid] < pos)
+		{
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	
+	for(; lo < cam.correction.nHotPixels && pHot[lo] < pos + width; lo++)
+	{
+		x = pHot[lo] - pos;
+		pPix = pRow + x*bytesPerPixel;
+		for(c = 0; c < bytesPerPixel; c++)
+		{
+			if(x >= dist && x + dist < width)
+			{
+				pPix[c] = (pPix[c - dist*bytesPerPixel] +
+						pPix[c + dist*bytesPerPixel] + 1)/2;
+			} else if(x >= dist) {
+				pPix[c] = pPix[c - dist*bytesPerPixel];
+			} else if(x + dist < width) {
+				pPix[c] = pPix[c + dist*bytesPerPixel];
+			}
+		}
+	}
+}
+
+void OscCamCorrectRow(uint8 *pDst, const uint8 *pSrc, const uint16 width,
+		const uint16 bytesPerPixel, const uint16 col, const uint16 row)
+{
+	const uint8 *pOffset = cam.correction.pOffset;
+	const uint8 *pGain = cam.correction.pGain;
+	uint32      pos = (uint32)row*MAX_IMAGE_WIDTH + col;
+	uint32      i, value;
+	uint16      c;
+	
+	if(col + width > MAX_IMAGE_WIDTH || row >= MAX_IMAGE_HEIGHT)
+	{
+		/* Outside of the calibrated area */
+		if(pDst != pSrc)
+		{
+			memcpy(pDst, pSrc, width*bytesPerPixel);
+		}
+		return;
+	}
+	
+	if(pOffset == NULL && pGain == NULL)
+	{
+		if(pDst != pSrc)
+		{
+			memcpy(pDst, pSrc, width*bytesPerPixel);
+		}
+	} else if(bytesPerPixel == 1) {
+		OscCamCorrectRawRow(pDst, pSrc,
+				pOffset == NULL ? NULL : pOffset + pos,
+				pGain == NULL ? NULL : pGain + pos,
+				width);
+	} else {
+		/* The color channels of a pixel share its calibration. */
+		for(i = 0; i < width*bytesPerPixel; i += bytesPerPixel, pos++)
+		{
+			for(c = 0; c < bytesPerPixel; c++)
+			{
+				value = pSrc[i + c];
+				if(pOffset != NULL)
+				{
+					value = (value > pOffset[pos]) ? value - pOffset[pos] : 0;
+				}
+				if(pGain != NULL)
+				{
+					value = (value*pGain[pos]) >> 7;
+				}
+				pDst[i + c] = (value > 255) ? 255 : value;
+			}
+		}
+		pos -= width;
+	}
+	
+	if(cam.correction.nHotPixels != 0)
+	{
+		OscCamReplaceHotPixels(pDst, width, bytesPerPixel, pos);
+	}
+}
+
+void OscCamCorrectWindow(uint8 *pImg, const struct capture_window *pWin,
+		const uint16 bytesPerPixel)
+{
+	uint16 y;
+	
+	for(y = 0; y < pWin->height; y++)
+	{
+		OscCamCorrectRow(pImg, pImg, pWin->width, bytesPerPixel,
+				pWin->col_off, pWin->row_off + y);
+		pImg += pWin->width*bytesPerPixel;
+	}
+}
+
+OSC_ERR OscCamSetCorrection(const struct OSC_CAM_CORRECTION *pCorrection)
+{
+	uint32 i;
+	
+	if(pCorrection == NULL)
+	{
+		cam.bCorrection = FALSE;
+		memset(&cam.correction, 0, sizeof(struct OSC_CAM_CORRECTION));
+		return SUCCESS;
+	}
+	
+	/* Input validation */
+	if(pCorrection->nHotPixels != 0 && pCorrection->pHotPixels == NULL)
+	{
+		OscLog(ERROR, "%s: No hot pixels given!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+	for(i = 0; i < pCorrection->nHotPixels; i++)
+	{
+		if(pCorrection->pHotPixels[i] >= MAX_IMAGE_WIDTH*MAX_IMAGE_HEIGHT ||
+				(i > 0 && pCorrection->pHotPixels[i] <=
+				pCorrection->pHotPixels[i - 1]))
+		{
+			OscLog(ERROR, "%s: Hot pixel %u out of range or order!\n",
+					__func__, i);
+			return -EINVALID_PARAMETER;
+		}
+	}
+	
+	cam.correction = *pCorrection;
+	cam.bCorrection = TRUE;
+	return SUCCESS;
+}
@@ -29,11 +29,13 @@
 #include "cam.h"
 
 OSC_ERR OscCamCreate();
+OSC_ERR OscCamDestroy();
 
 /*! @brief The module definition. */
 struct OscModule OscModule_cam = {
 	.name = "cam",
 	.create = OscCamCreate,
+	.destroy = OscCamDestroy,
 	.dependencies = {
 		&OscModule_log,
 		&OscModule_frd,
@@ -216,12 +218,15 @@ static struct reg_info * OscCamFindReg(const uint32 addr)
  * @param dstBufferSize Size of above destination buffer.
  * @param pPic Picture to be cropped.
  * @param pCropWin Window to crop the picture to.
+ * @param pSensorWin Window of the sensor the cropped picture shows, to
+ * apply the built-in correction while copying.
  * @return SUCCESS or an appropriate error code otherwise
  *//*********************************************************************/
 static OSC_ERR OscCamCropPicture(uint8* pDstBuffer,
 		const uint32 dstBufferSize,
 		const struct OSC_PICTURE *pPic,
-		const struct capture_window *pCropWin)
+		const struct capture_window *pCropWin,
+		const struct capture_window *pSensorWin)
 {
 	uint8       *pTSrc, *pTDst;
 	uint32      croppedSize;
@@ -274,9 +279,19 @@ static OSC_ERR OscCamCropPicture(uint8* pDstBuffer,
 	pTSrc += pCropWin->row_off * pPic->width * bytesPerPixel;
 	for(y = lowY; y < highY; y++)
 	{
-		memcpy(pTDst,
-				pTSrc,
-				bytesPerPixel * pCropWin->width);
+		if(cam.bCorrection)
+		{
+			OscCamCorrectRow(pTDst,
+					pTSrc,
+					pCropWin->width,
+					bytesPerPixel,
+					pSensorWin->col_off,
+					pSensorWin->row_off + (y - lowY));
+		} else {
+			memcpy(pTDst,
+					pTSrc,
+					bytesPerPixel * pCropWin->width);
+		}
 		
 		pTDst += pCropWin->width * bytesPerPixel;
 		pTSrc += pPic->width * bytesPerPixel;
@@ -285,6 +300,454 @@ static OSC_ERR OscCamCropPicture(uint8* pDstBuffer,
 	return SUCCESS;
 }
 
+/*********************************************************************//*!
+ * @brief Host only: Crop a recorded frame to the specified window.
+ * 
+ * The frame only covers the area of interest it was recorded with,
+ * which has to contain the window.
+ * 
+ * @param pDstBuffer The destination buffer where the cropped image
+ * is written to.
+ * @param dstBufferSize Size of above destination buffer.
+ * @param pFrame The raw pixels of the recorded frame.
+ * @param pInfo The information recorded with the frame.
+ * @param pCropWin Window on the sensor to crop the frame to.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscCamCropRecordedFrame(uint8* pDstBuffer,
+		const uint32 dstBufferSize,
+		const uint8 *pFrame,
+		const struct OSC_FRD_FRAME_INFO *pInfo,
+		const struct capture_window *pCropWin)
+{
+	struct OSC_PICTURE      pic;
+	struct capture_window   win;
+	
+	if((pCropWin->col_off < pInfo->col_off) ||
+			(pCropWin->row_off < pInfo->row_off))
+	{
+		OscLog(ERROR,
+				"%s: Unable to crop frame (%dx%d @ %d/%d) to (%dx%d @ %d/%d).\n",
+				__func__, pInfo->width, pInfo->height,
+				pInfo->col_off, pInfo->row_off,
+				pCropWin->width, pCropWin->height,
+				pCropWin->col_off, pCropWin->row_off);
+		return -EPICTURE_TOO_SMALL;
+	}
+	
+	/* The window relative to the recorded frame */
+	win = *pCropWin;
+	win.col_off -= pInfo->col_off;
+	win.row_off -= pInfo->row_off;
+	
+	pic.data = (void*)pFrame;
+	pic.width = pInfo->width;
+	pic.height = pInfo->height;
+	pic.type = OSC_PICTURE_GREYSCALE;
+	
+	return OscCamCropPicture(pDstBuffer, dstBufferSize, &pic, &win,
+			pCropWin);
+}
+
+/*********************************************************************//*!
+ * @brief Host only: The length of a sensor row of a recorded frame.
+ * 
+ * @param pInfo The information recorded with the frame.
+ * @return The row length in pixel clocks as recorded, or derived from
+ * the recorded window and the current horizontal blanking.
+ *//*********************************************************************/
+static uint32 OscCamRecordedRowClks(const struct OSC_FRD_FRAME_INFO *pInfo)
+{
+	uint32 rowClks;
+	
+	if(pInfo->rowClks != 0)
+	{
+		return pInfo->rowClks;
+	}
+	rowClks = pInfo->width + cam.curHorizBlank;
+	if(rowClks < CAM_MIN_ROW_CLKS)
+	{
+		rowClks = CAM_MIN_ROW_CLKS;
+	}
+	return rowClks;
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Scale a recorded frame to the current exposure time.
+ * 
+ * @param pImg The raw pixels of the frame.
+ * @param nPixels The number of pixels.
+ * @param recExposure The exposure time the frame was recorded with in
+ * microseconds.
+ *//*********************************************************************/
+static void OscCamScaleExposure(uint8 *pImg, const uint32 nPixels,
+		const uint32 recExposure)
+{
+	uint8       lut[256];
+	uint64_t    value;
+	uint32      i;
+	
+	if(recExposure == 0 || recExposure == cam.curExpTime)
+	{
+		return;
+	}
+	
+	for(i = 0; i < 256; i++)
+	{
+		value = (uint64_t)i*cam.curExpTime/recExposure;
+		lut[i] = (value > 255) ? 255 : value;
+	}
+	for(i = 0; i < nPixels; i++)
+	{
+		pImg[i] = lut[pImg[i]];
+	}
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Find a test image in the frame cache.
+ * 
+ * Must be called with the cache locked.
+ * 
+ * @param strFileName The file name of the test image.
+ * @return The cache entry or NULL if not cached.
+ *//*********************************************************************/
+static struct CAM_CACHED_FRAME * OscCamCacheFind(const char *strFileName)
+{
+	uint16 i;
+	
+	for(i = 0; i < cam.cache.nrOfFrames; i++)
+	{
+		if(cam.cache.frames[i].status != CACHE_ENTRY_EMPTY &&
+				strcmp(cam.cache.frames[i].strFileName, strFileName) == 0)
+		{
+			return &cam.cache.frames[i];
+		}
+	}
+	return NULL;
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Make room for a test image in the frame cache.
+ * 
+ * Takes an empty entry if there is one, or else replaces the least
+ * recently used entry which is neither being loaded nor in use.
+ * Must be called with the cache locked.
+ * 
+ * @param strFileName The file name of the test image.
+ * @return The entry, which is empty, or NULL if all are busy.
+ *//*********************************************************************/
+static struct CAM_CACHED_FRAME * OscCamCacheAllocate(const char *strFileName)
+{
+	struct CAM_CACHED_FRAME *pFrame, *pVictim = NULL;
+	uint16 i;
+	
+	for(i = 0; i < cam.cache.nrOfFrames; i++)
+	{
+		pFrame = &cam.cache.frames[i];
+		if(pFrame->status == CACHE_ENTRY_EMPTY)
+		{
+			pVictim = pFrame;
+			break;
+		}
+		if(pFrame->status == CACHE_ENTRY_LOADING || pFrame->users != 0)
+		{
+			continue;
+		}
+		/* Compare the age so it survives the counter wrapping around. */
+		if(pVictim == NULL || (int32)(pFrame->lastUse - pVictim->lastUse) < 0)
+		{
+			pVictim = pFrame;
+		}
+	}
+	
+	if(pVictim != NULL)
+	{
+		/* The picture memory is kept to be reused by the next load. */
+		pVictim->status = CACHE_ENTRY_EMPTY;
+		strcpy(pVictim->strFileName, strFileName);
+	}
+	return pVictim;
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Read the test image of a cache entry from its file.
+ * 
+ * Must be called with the cache locked and the entry marked as
+ * loading. The lock is released while reading the file. Afterwards the
+ * entry is either valid or empty and all waiting readers are woken.
+ * 
+ * @param pFrame The cache entry to load.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscCamCacheLoad(struct CAM_CACHED_FRAME *pFrame)
+{
+	struct OSC_PICTURE  pic;
+	struct stat         fileStat;
+	OSC_ERR             err;
+	
+	/* The entry is not touched by anyone else while it is loading. */
+	pthread_mutex_unlock(&cam.cache.lock);
+	
+	/* Read into the memory of the previous picture if it has the same
+	 * size, which is usually the case. Only a color picture leaves
+	 * enough room for any type of file. */
+	pic = pFrame->pic;
+	if(pic.data != NULL && pic.type != OSC_PICTURE_BGR_24)
+	{
+		free(pic.data);
+		memset(&pic, 0, sizeof(struct OSC_PICTURE));
+	}
+	if(stat(pFrame->strFileName, &fileStat) != 0)
+	{
+		err = -EUNABLE_TO_OPEN_FILE;
+	} else {
+		err = OscBmpRead(&pic, pFrame->strFileName);
+		if(err == -EWRONG_IMAGE_FORMAT)
+		{
+			free(pic.data);
+			memset(&pic, 0, sizeof(struct OSC_PICTURE));
+			err = OscBmpRead(&pic, pFrame->strFileName);
+		}
+	}
+	
+	pthread_mutex_lock(&cam.cache.lock);
+	
+	pFrame->pic = pic;
+	if(err == SUCCESS)
+	{
+		pFrame->dev = fileStat.st_dev;
+		pFrame->ino = fileStat.st_ino;
+		pFrame->size = fileStat.st_size;
+		pFrame->mtime = fileStat.st_mtim;
+		pFrame->status = CACHE_ENTRY_VALID;
+	} else {
+		pFrame->status = CACHE_ENTRY_EMPTY;
+	}
+	pthread_cond_broadcast(&cam.cache.loaded);
+	
+	return err;
+}
+
+/*********************************************************************//*!
+ * @brief Host only: The prefetch thread.
+ * 
+ * Loads the queued entries of the frame cache, the one needed the
+ * soonest first.
+ *//*********************************************************************/
+static void * OscCamPrefetchThread(void *pArg)
+{
+	struct CAM_CACHED_FRAME *pFrame, *pNext;
+	uint16 i;
+	
+	pthread_mutex_lock(&cam.cache.lock);
+	while(!cam.cache.bStopThread)
+	{
+		pNext = NULL;
+		for(i = 0; i < cam.cache.nrOfFrames; i++)
+		{
+			pFrame = &cam.cache.frames[i];
+			if(pFrame->status == CACHE_ENTRY_QUEUED && (pNext == NULL ||
+					(int32)(pFrame->lastUse - pNext->lastUse) < 0))
+			{
+				pNext = pFrame;
+			}
+		}
+		
+		if(pNext == NULL)
+		{
+			pthread_cond_wait(&cam.cache.queued, &cam.cache.lock);
+			continue;
+		}
+		
+		pNext->status = CACHE_ENTRY_LOADING;
+		if(OscCamCacheLoad(pNext) != SUCCESS)
+		{
+			/* Reported when the simulation gets to this picture. */
+			OscLog(DEBUG, "%s: Unable to prefetch test image (%s).\n",
+					__func__, pNext->strFileName);
+		}
+	}
+	pthread_mutex_unlock(&cam.cache.lock);
+	
+	return NULL;
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Stop the prefetch thread and empty the frame cache.
+ *//*********************************************************************/
+static void OscCamCacheFlush()
+{
+	uint16 i;
+	
+	if(cam.cache.bThreadRunning)
+	{
+		pthread_mutex_lock(&cam.cache.lock);
+		cam.cache.bStopThread = TRUE;
+		pthread_cond_signal(&cam.cache.queued);
+		pthread_mutex_unlock(&cam.cache.lock);
+		
+		pthread_join(cam.cache.thread, NULL);
+		cam.cache.bThreadRunning = FALSE;
+		cam.cache.bStopThread = FALSE;
+	}
+	
+	for(i = 0; i < CAM_MAX_CACHED_FRAMES; i++)
+	{
+		free(cam.cache.frames[i].pic.data);
+		memset(&cam.cache.frames[i], 0, sizeof(struct CAM_CACHED_FRAME));
+	}
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Get a test image from the frame cache.
+ * 
+ * Reads the file if it is not cached yet or has been modified since it
+ * was read. Waits for the prefetch thread if it is just loading it. The
+ * returned entry is kept from being replaced until it is released with
+ * OscCamCacheRelease().
+ * 
+ * @param strFileName The file name of the test image.
+ * @param ppFrame Where to store the cache entry.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscCamCacheGet(const char *strFileName,
+		struct CAM_CACHED_FRAME **ppFrame)
+{
+	struct CAM_CACHED_FRAME *pFrame;
+	struct stat             fileStat;
+	bool                    bStatOk;
+	OSC_ERR                 err = SUCCESS;
+	
+	/* Even a cached picture has to be checked against its file, which
+	 * may be replaced by another program while the simulation is
+	 * running. */
+	bStatOk = (stat(strFileName, &fileStat) == 0);
+	
+	pthread_mutex_lock(&cam.cache.lock);
+	for(;;)
+	{
+		pFrame = OscCamCacheFind(strFileName);
+		if(pFrame == NULL)
+		{
+			pFrame = OscCamCacheAllocate(strFileName);
+			if(pFrame == NULL)
+			{
+				/* Every entry is being loaded, wait for one. */
+				pthread_cond_wait(&cam.cache.loaded, &cam.cache.lock);
+				continue;
+			}
+		}
+		
+		if(pFrame->status == CACHE_ENTRY_LOADING)
+		{
+			pthread_cond_wait(&cam.cache.loaded, &cam.cache.lock);
+			continue;
+		}
+		
+		if(pFrame->status == CACHE_ENTRY_VALID && bStatOk &&
+				pFrame->dev == fileStat.st_dev &&
+				pFrame->ino == fileStat.st_ino &&
+				pFrame->size == fileStat.st_size &&
+				pFrame->mtime.tv_sec == fileStat.st_mtim.tv_sec &&
+				pFrame->mtime.tv_nsec == fileStat.st_mtim.tv_nsec)
+		{
+			break;
+		}
+		
+		/* Not loaded yet, not loaded by the prefetcher yet or out of
+		 * date: load it ourselves. */
+		pFrame->status = CACHE_ENTRY_LOADING;
+		err = OscCamCacheLoad(pFrame);
+		if(err != SUCCESS)
+		{
+			break;
+		}
+		bStatOk = (stat(strFileName, &fileStat) == 0);
+	}
+	
+	if(err == SUCCESS)
+	{
+		pFrame->users++;
+		pFrame->lastUse = ++cam.cache.useCounter;
+		*ppFrame = pFrame;
+	}
+	pthread_mutex_unlock(&cam.cache.lock);
+	
+	return err;
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Release a test image got from the frame cache.
+ * 
+ * @param pFrame The cache entry.
+ *//*********************************************************************/
+static void OscCamCacheRelease(struct CAM_CACHED_FRAME *pFrame)
+{
+	pthread_mutex_lock(&cam.cache.lock);
+	pFrame->users--;
+	pthread_mutex_unlock(&cam.cache.lock);
+}
+
+/*********************************************************************//*!
+ * @brief Host only: Queue the test images of the next time steps to be
+ * loaded by the prefetch thread.
+ * 
+ * The file names are looked up here rather than by the prefetch
+ * thread, so they belong to the time step of the capture. This may run
+ * on the capture thread of a stream, see the threading notes in frd.h.
+ *//*********************************************************************/
+static void OscCamCachePrefetch()
+{
+	struct CAM_CACHED_FRAME *pFrame;
+	char                    strFileName[CAM_MAX_FILE_NAME_LEN];
+	uint16                  step;
+	
+	if(cam.cache.prefetchDepth == 0)
+	{
+		return;
+	}
+	
+	if(!cam.cache.bThreadRunning)
+	{
+		if(pthread_create(&cam.cache.thread, NULL, OscCamPrefetchThread,
+				NULL) != 0)
+		{
+			OscLog(WARN, "%s: Unable to start the prefetch thread, "
+					"reading test images on demand.\n", __func__);
+			cam.cache.prefetchDepth = 0;
+			return;
+		}
+		cam.cache.bThreadRunning = TRUE;
+	}
+	
+	for(step = 1; step <= cam.cache.prefetchDepth; step++)
+	{
+		if(OscFrdGetFileNameAhead(cam.hFNReader, step, strFileName) !=
+				SUCCESS || strFileName[0] == '\0')
+		{
+			break;
+		}
+		
+		pthread_mutex_lock(&cam.cache.lock);
+		pFrame = OscCamCacheFind(strFileName);
+		if(pFrame == NULL)
+		{
+			pFrame = OscCamCacheAllocate(strFileName);
+			if(pFrame != NULL)
+			{
+				pFrame->status = CACHE_ENTRY_QUEUED;
+				pthread_cond_signal(&cam.cache.queued);
+			}
+		}
+		if(pFrame != NULL)
+		{
+			/* Keep it from being replaced before it is needed. */
+			pFrame->lastUse = ++cam.cache.useCounter;
+		}
+		pthread_mutex_unlock(&cam.cache.lock);
+	}
+}
+
 OSC_ERR OscCamCreate()
 {
 	OSC_ERR                 err;
@@ -305,6 +768,13 @@ OSC_ERR OscCamCreate()
 	
 	cam.lastValidID = OSC_CAM_INVALID_BUFFER_ID;
 	
+	/* The frame cache is enabled by default. */
+	pthread_mutex_init(&cam.cache.lock, NULL);
+	pthread_cond_init(&cam.cache.queued, NULL);
+	pthread_cond_init(&cam.cache.loaded, NULL);
+	cam.cache.nrOfFrames = CAM_DEFAULT_CACHED_FRAMES;
+	cam.cache.prefetchDepth = CAM_DEFAULT_PREFETCH_DEPTH;
+	
 	err = SUCCESS;
 #ifdef TARGET_TYPE_LEANXCAM
 	/* Disable LED_OUT on leanXcam so the GPIOs can function correctly.
@@ -331,6 +801,41 @@ OSC_ERR OscCamCreate()
 	return SUCCESS;
 }
 
+OSC_ERR OscCamDestroy()
+{
+	if(cam.stream.bRunning)
+	{
+		OscCamStopStreaming();
+	}
+	OscCamCacheFlush();
+	
+	pthread_cond_destroy(&cam.cache.loaded);
+	pthread_cond_destroy(&cam.cache.queued);
+	pthread_mutex_destroy(&cam.cache.lock);
+	
+	return SUCCESS;
+}
+
+OSC_ERR OscCamSetFrameCache(const uint16 nrOfFrames,
+		const uint16 prefetchDepth)
+{
+	/* Input validation */
+	if(nrOfFrames > CAM_MAX_CACHED_FRAMES ||
+			(nrOfFrames == 0 && prefetchDepth != 0) ||
+			(nrOfFrames != 0 && prefetchDepth >= nrOfFrames))
+	{
+		OscLog(ERROR, "%s(%u, %u): Invalid parameter!\n",
+				__func__, nrOfFrames, prefetchDepth);
+		return -EINVALID_PARAMETER;
+	}
+	
+	OscCamCacheFlush();
+	cam.cache.nrOfFrames = nrOfFrames;
+	cam.cache.prefetchDepth = prefetchDepth;
+	
+	return SUCCESS;
+}
+
 OSC_ERR OscCamSetFileNameReader(void* hReaderHandle)
 {
 	/* Input validation. */
@@ -473,6 +978,18 @@ OSC_ERR OscCamSetFrameBuffer(const uint8 fbID,
 				return -ECANNOT_DELETE;
 			}
 		}
+		/* The frame ring may still hand the frame buffer out. */
+		for(i = 0; i < cam.frameRing.depth; i++)
+		{
+			if(cam.frameRing.fbIDs[i] == fbID)
+			{
+				OscLog(ERROR,
+						"%s: Deleting frame buffer %d being part of "
+						"the frame ring!\n",
+						__func__, fbID);
+				return -ECANNOT_DELETE;
+			}
+		}
 		if(cam.fbStat[fbID] == STATUS_UNITIALIZED)
 		{
 			OscLog(WARN,
@@ -571,6 +1088,7 @@ OSC_ERR OscCamSetupCapture(uint8 fbID)
 	/* Save the capture window currently configured since that will
 	 * be the one used later when really reading the image */
 	memcpy(&cam.lastCapWin, &cam.capWin, sizeof(struct capture_window));
+	OscCamFrameInfoSetup(fb);
 
 	
 	return SUCCESS;
@@ -603,7 +1121,14 @@ OSC_ERR OscCamReadPicture(const uint8 fbID,
 	OSC_ERR             err = SUCCESS;
 	uint8               fb;
 	struct OSC_PICTURE  pic;
-	char                strPicFileName[256];
+	struct CAM_CACHED_FRAME *pFrame;
+	char                strPicFileName[CAM_MAX_FILE_NAME_LEN];
+	const uint8         *pRecFrame;
+	const struct OSC_FRD_FRAME_INFO *pRecInfo = NULL;
+	struct OSC_CAM_FRAME_INFO *pInfo;
+	uint16              bytesPerPixel = 1;
+	bool                bExposureScaled = FALSE;
+	uint32              rowClks = cam.curCamRowClks;
 	
 
 	if(unlikely(cam.hFNReader == NULL))
@@ -648,44 +1173,144 @@ OSC_ERR OscCamReadPicture(const uint8 fbID,
 			"%s(%u, 0x%x, %u, %u): Syncing capture on frame buffer %d.\n",
 			__func__, fbID, ppPic, maxAge, timeout, fb);
 	
+	/* A recording reader supplies the frame itself */
+	err = OscFrdGetRecordedFrame(cam.hFNReader, OscSimGetCurTimeStep(),
+			&pRecFrame, &pRecInfo);
+	if(err != -EUNSUPPORTED)
+	{
+		if(err != SUCCESS)
+		{
+			OscLog(ERROR, "%s: Unable to read recorded frame %u. Err: %d.\n",
+					__func__, OscSimGetCurTimeStep(), err);
+			return -EDEVICE;
+		}
+		err = OscCamCropRecordedFrame(cam.fbufs[fb].data,
+				cam.fbufs[fb].size,
+				pRecFrame,
+				pRecInfo,
+				&cam.lastCapWin);
+		if(err != SUCCESS)
+		{
+			OscLog(ERROR, "%s: Unable to crop recorded frame %u. Err: %d.\n",
+					__func__, OscSimGetCurTimeStep(), err);
+			return -EDEVICE;
+		}
+		/* The shutter width is counted in rows of the recorded window. */
+		rowClks = OscCamRecordedRowClks(pRecInfo);
+		if(cam.aec.bEnabled && pRecInfo->shutterWidth != 0)
+		{
+			/* Let the auto exposure see the effect of its changes. */
+			OscCamScaleExposure(cam.fbufs[fb].data,
+					(uint32)cam.lastCapWin.width*cam.lastCapWin.height,
+					(uint32)pRecInfo->shutterWidth*rowClks/
+					(CAM_PIX_CLK/1000000));
+			bExposureScaled = TRUE;
+		}
+		goto read_done;
+	}
+	
 	/* Get the current test image file name from the file name reader
 	 * module */
 	OscFrdGetCurrentFileName(cam.hFNReader,
 			strPicFileName);
 	
-	/* We have no assumptions about the picture format but let
-	 * everything be filled and allocated by the loader routine */
-	memset(&pic, 0, sizeof(struct OSC_PICTURE));
+	if(cam.cache.nrOfFrames == 0)
+	{
+		/* Read only the window set by the application, straight into
+		 * the frame buffer. We use the window at the time of the call
+		 * to OscCamSetupCapture() to emulate the behavior of the target
+		 * implementation. */
+		pic.data = cam.fbufs[fb].data;
+		pic.width = cam.lastCapWin.width;
+		pic.height = cam.lastCapWin.height;
+		err = OscBmpReadRegion(&pic, strPicFileName,
+				cam.lastCapWin.col_off,
+				cam.lastCapWin.row_off,
+				cam.fbufs[fb].size);
+		if(err != 0)
+		{
+			OscLog(ERROR, "%s: Unable to read test image (%s). Err: %d.\n",
+					__func__, strPicFileName, err);
+			return -EDEVICE;
+		}
+		bytesPerPixel = OSC_PICTURE_TYPE_COLOR_DEPTH(pic.type)/8;
+		if(cam.bCorrection)
+		{
+			OscCamCorrectWindow(cam.fbufs[fb].data, &cam.lastCapWin,
+					bytesPerPixel);
+		}
+	} else {
+		/* Take the decoded picture from the frame cache */
+		err = OscCamCacheGet(strPicFileName, &pFrame);
+		if(err != 0)
+		{
+			OscLog(ERROR, "%s: Unable to read test image (%s). Err: %d.\n",
+					__func__, strPicFileName, err);
+			return -EDEVICE;
+		}
+		
+		/* Crop the picture to the window set by the application. */
+		err = OscCamCropPicture(cam.fbufs[fb].data,
+				cam.fbufs[fb].size,
+				&pFrame->pic,
+				&cam.lastCapWin,
+				&cam.lastCapWin);
+		bytesPerPixel = OSC_PICTURE_TYPE_COLOR_DEPTH(pFrame->pic.type)/8;
+		OscCamCacheRelease(pFrame);
+		if(err != 0)
+		{
+			OscLog(ERROR, "%s: Unable to crop test image (%s). Err: %d.\n",
+					__func__, strPicFileName, err);
+			return -EDEVICE;
+		}
+		
+		/* Have the pictures of the next time steps loaded while the
+		 * application processes this one. */
+		OscCamCachePrefetch();
+	}
+	
+read_done:
+	*ppPic = cam.fbufs[fb].data;
+	cam.fbStat[fb] = STATUS_VALID;
 	
-	/* Read the file */
-	err = OscBmpRead(&pic, strPicFileName);
-	if(err != 0)
+	/* Describe the picture as if it had been taken at the current time
+	 * step, or as it was recorded. */
+	pInfo = &cam.frameInfo[fb];
+	if(pRecInfo != NULL)
 	{
-		OscLog(ERROR, "%s: Unable to read test image (%s). Err: %d.\n",
-				__func__, strPicFileName, err);
-		return -EDEVICE;
+		pInfo->exposureEnd = pRecInfo->timestamp;
+		if(!bExposureScaled)
+		{
+			pInfo->exposureTime = (uint32)pRecInfo->shutterWidth*
+					rowClks/(CAM_PIX_CLK/1000000);
+		}
+		pInfo->blackLevel = pRecInfo->blackLevel;
+	} else {
+		pInfo->exposureEnd = (uint64_t)OscSimGetCurTimeStep()*1000000/
+				CAM_HOST_FRAME_RATE;
 	}
+	pInfo->exposureStart = (pInfo->exposureEnd > pInfo->exposureTime) ?
+			pInfo->exposureEnd - pInfo->exposureTime : 0;
+	pInfo->readTime = pInfo->exposureEnd +
+			(uint64_t)pInfo->height*rowClks/(CAM_PIX_CLK/1000000);
+	cam.bFrameInfoValid[fb] = TRUE;
 	
-	/* Crop the picture to the window set by the application.
-	 * We use the window at the time of the call to OscCamSetupCapture()
-	 * to emulate the behavior of the target implementation. */
-	err = OscCamCropPicture(cam.fbufs[fb].data,
-			cam.fbufs[fb].size,
-			&pic,
-			&cam.lastCapWin);
-	if(err != 0)
+	if(cam.aec.bEnabled)
 	{
-		OscLog(ERROR, "%s: Unable to crop test image (%s). Err: %d.\n",
-				__func__, strPicFileName, err);
-		return -EDEVICE;
+		OscCamAecProcess(*ppPic, cam.lastCapWin.width, cam.lastCapWin.height,
+				bytesPerPixel);
 	}
 	
-	/* Free the picture structure data again; it was allocated in the
-	 * OscBmpRead routine. */
-	free(pic.data);
-
-	*ppPic = cam.fbufs[fb].data;
-	cam.fbStat[fb] = STATUS_VALID;
+	/* Apply image correction */
+	if(cam.pCallback)
+	{
+		err = (*cam.pCallback)(
+				*ppPic,
+				cam.lastCapWin.col_off,
+				cam.lastCapWin.row_off,
+				cam.lastCapWin.width,
+				cam.lastCapWin.height);
+	}
 	
 	/* The operation was successful */
 	
@@ -747,6 +1372,7 @@ OSC_ERR OscCamRegisterCorrectionCallback(
 				const uint16 width,
 				const uint16 height))
 {
+	cam.pCallback = pCallback;
 	return SUCCESS;
 }
 
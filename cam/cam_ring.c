@@ -0,0 +1,205 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+	
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+	
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+	
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*! @file
+ * @brief Frame ring implementation
+	
+ * Hands frames from a capturing thread to processing threads with
+ * reference counting. The state of a frame is a single word changed by
+ * compare and swap, so neither side ever waits for the other.
+ */
+
+#include <string.h>
+#include "cam_ring.h"
+
+/*! @brief Atomically replace the state of a frame if it has the
+ * expected value. */
+#define RING_CAS(pRing, index, old, new) \
+	__sync_bool_compare_and_swap(&(pRing)->state[index], (old), (new))
+
+/*==================== Private method prototypes =======================*/
+/*********************************************************************//*!
+ * @brief Find the ready frame with the oldest sequence number.
+ * 
+ * @param pRing Pointer to the ring.
+ * @param pSeqNr The sequence number the frame was found with is
+ * returned over this pointer.
+ * @return Index of the frame in the ring or -1 if no frame is ready.
+ *//*********************************************************************/
+static int OscCamFrameRingFindOldest(const struct OSC_CAM_FRAME_RING *pRing,
+		uint32 *pSeqNr);
+
+/*=========================== Code =====================================*/
+
+OSC_ERR OscCamFrameRingInit(struct OSC_CAM_FRAME_RING *pRing,
+		const uint8 depth,
+		const uint8 bufferIDs[])
+{
+	if(pRing->depth != 0)
+	{
+		OscLog(NOTICE, "%s: Replacing existing frame ring.\n",
+				__func__);
+	}
+	
+	memset(pRing, 0, sizeof(struct OSC_CAM_FRAME_RING));
+	pRing->depth = depth;
+	memcpy(pRing->fbIDs, bufferIDs, depth*sizeof(uint8));
+	
+	return SUCCESS;
+}
+
+static int OscCamFrameRingFindOldest(const struct OSC_CAM_FRAME_RING *pRing,
+		uint32 *pSeqNr)
+{
+	int i, oldest = -1;
+	uint32 seqNr;
+	
+	for(i = 0; i < pRing->depth; i++)
+	{
+		if(pRing->state[i] != RING_FRAME_READY)
+		{
+			continue;
+		}
+		/* Compare the sequence numbers so it survives wrapping around. */
+		seqNr = pRing->seqNr[i];
+		if(oldest == -1 || (int32)(seqNr - *pSeqNr) < 0)
+		{
+			oldest = i;
+			*pSeqNr = seqNr;
+		}
+	}
+	return oldest;
+}
+
+int OscCamFrameRingBeginCapture(struct OSC_CAM_FRAME_RING *pRing)
+{
+	int i;
+	uint32 seqNr;
+	
+	for(;;)
+	{
+		for(i = 0; i < pRing->depth; i++)
+		{
+			if(RING_CAS(pRing, i, RING_FRAME_FREE, RING_FRAME_CAPTURING))
+			{
+				return i;
+			}
+		}
+		
+		/* No free frame, overwrite the oldest one nobody has acquired
+		 * yet rather than wait for the consumers. */
+		i = OscCamFrameRingFindOldest(pRing, &seqNr);
+		if(i == -1)
+		{
+			/* Every frame is held. Retry if one has just been
+			 * released. */
+			for(i = 0; i < pRing->depth; i++)
+			{
+				if(pRing->state[i] == RING_FRAME_FREE)
+				{
+					break;
+				}
+			}
+			if(i == pRing->depth)
+			{
+				return -1;
+			}
+			continue;
+		}
+		if(RING_CAS(pRing, i, RING_FRAME_READY, RING_FRAME_CAPTURING))
+		{
+			__sync_fetch_and_add(&pRing->nDropped, 1);
+			return i;
+		}
+		/* A consumer acquired it in the meantime, try again. */
+	}
+}
+
+void OscCamFrameRingEndCapture(struct OSC_CAM_FRAME_RING *pRing,
+		const int index, const bool bValid)
+{
+	if(bValid)
+	{
+		pRing->seqNr[index] = pRing->nCaptured;
+		__sync_fetch_and_add(&pRing->nCaptured, 1);
+		/* The compare and swap is a full barrier, so the frame and its
+		 * sequence number are visible before it is marked ready. */
+		RING_CAS(pRing, index, RING_FRAME_CAPTURING, RING_FRAME_READY);
+	} else {
+		RING_CAS(pRing, index, RING_FRAME_CAPTURING, RING_FRAME_FREE);
+	}
+}
+
+int OscCamFrameRingAcquire(struct OSC_CAM_FRAME_RING *pRing)
+{
+	int i, older;
+	uint32 seqNr;
+	
+	for(;;)
+	{
+		i = OscCamFrameRingFindOldest(pRing, &seqNr);
+		if(i == -1)
+		{
+			return -1;
+		}
+		if(!RING_CAS(pRing, i, RING_FRAME_READY, RING_FRAME_HELD(1)))
+		{
+			/* Dropped by the capture or acquired by another consumer. */
+			continue;
+		}
+		
+		/* The search is no snapshot of the ring: a frame may have been
+		 * passed over while its capture completed, or this one dropped
+		 * and filled again before it was acquired. Every frame captured
+		 * before the held one is ready, held or dropped by now, so
+		 * search once more. */
+		older = OscCamFrameRingFindOldest(pRing, &seqNr);
+		if(older == -1 || (int32)(seqNr - pRing->seqNr[i]) > 0)
+		{
+			return i;
+		}
+		/* Put it back and take the older one, unless it has been
+		 * retained in the meantime. */
+		if(!RING_CAS(pRing, i, RING_FRAME_HELD(1), RING_FRAME_READY))
+		{
+			return i;
+		}
+	}
+}
+
+OSC_ERR OscCamFrameRingReference(struct OSC_CAM_FRAME_RING *pRing,
+		const int index, const int delta)
+{
+	uint32 state, newState;
+	
+	do {
+		state = pRing->state[index];
+		if(state <= RING_FRAME_READY)
+		{
+			return -EINVALID_PARAMETER;
+		}
+		newState = state + delta;
+		if(newState == RING_FRAME_HELD(0))
+		{
+			/* The last reference has gone. */
+			newState = RING_FRAME_FREE;
+		}
+	} while(!RING_CAS(pRing, index, state, newState));
+	
+	return SUCCESS;
+}
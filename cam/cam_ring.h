@@ -0,0 +1,120 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+	
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+	
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+	
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*! @file
+ * @brief Private frame ring definitions
+ */
+
+#ifndef CAM_RING_H_
+#define CAM_RING_H_
+
+#include "oscar.h"
+#include "mt9v032.h"
+
+/*! @brief States of a frame in the ring. */
+#define RING_FRAME_FREE      0
+#define RING_FRAME_CAPTURING 1
+#define RING_FRAME_READY     2
+/*! @brief State of a frame held by consumers with the given number of
+ * references. */
+#define RING_FRAME_HELD(refs) (RING_FRAME_READY + (refs))
+
+/*! @brief The structure representing a frame ring.
+ * 
+ * Hands the frames captured by one thread to any number of processing
+ * threads. All state changes of a frame are done by atomic compare and
+ * swap, no locks are taken. */
+struct OSC_CAM_FRAME_RING
+{
+	/*! The number of frames in the ring. */
+	uint8 depth;
+	/*! The frame buffer IDs of the frames. */
+	uint8 fbIDs[MAX_NR_FRAME_BUFFERS];
+	/*! The state of every frame, see RING_FRAME_FREE. */
+	volatile uint32 state[MAX_NR_FRAME_BUFFERS];
+	/*! The capture sequence number of every ready or held frame. */
+	volatile uint32 seqNr[MAX_NR_FRAME_BUFFERS];
+	/*! The time in microseconds the capture of every ready or held frame
+	 * completed. */
+	uint64_t timestamp[MAX_NR_FRAME_BUFFERS];
+	/*! Number of frames captured so far. */
+	volatile uint32 nCaptured;
+	/*! Number of ready frames overwritten before being acquired. */
+	volatile uint32 nDropped;
+};
+
+/*=================== Public Method prototypes =========================*/
+
+/*********************************************************************//*!
+ * @brief Configure frame buffers to form a frame ring.
+ * 
+ * No input validation is done (must be done beforehand).
+ * 
+ * @param pRing Memory location where the ring is to be initialized.
+ * @param depth The number of frame buffers.
+ * @param bufferIDs Array of the buffer IDs forming the ring.
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamFrameRingInit(struct OSC_CAM_FRAME_RING *pRing,
+		const uint8 depth,
+		const uint8 bufferIDs[]);
+
+/*********************************************************************//*!
+ * @brief Reserve a frame to capture to.
+ * 
+ * Takes a free frame or, if there is none, drops the oldest ready
+ * frame. Must only be called by the capturing thread.
+ * 
+ * @param pRing Pointer to the ring.
+ * @return Index of the frame in the ring or -1 if all frames are held.
+ *//*********************************************************************/
+int OscCamFrameRingBeginCapture(struct OSC_CAM_FRAME_RING *pRing);
+
+/*********************************************************************//*!
+ * @brief Finish a capture started with OscCamFrameRingBeginCapture().
+ * 
+ * @param pRing Pointer to the ring.
+ * @param index Index of the frame in the ring.
+ * @param bValid Whether the frame is to be handed to the consumers or
+ * was not captured.
+ *//*********************************************************************/
+void OscCamFrameRingEndCapture(struct OSC_CAM_FRAME_RING *pRing,
+		const int index, const bool bValid);
+
+/*********************************************************************//*!
+ * @brief Acquire the oldest ready frame.
+ * 
+ * @param pRing Pointer to the ring.
+ * @return Index of the frame in the ring or -1 if no frame is ready.
+ *//*********************************************************************/
+int OscCamFrameRingAcquire(struct OSC_CAM_FRAME_RING *pRing);
+
+/*********************************************************************//*!
+ * @brief Add or remove a reference to a held frame.
+ * 
+ * The frame becomes free when the last reference is removed.
+ * 
+ * @param pRing Pointer to the ring.
+ * @param index Index of the frame in the ring.
+ * @param delta +1 to add a reference, -1 to remove one.
+ * @return SUCCESS or -EINVALID_PARAMETER if the frame is not held.
+ *//*********************************************************************/
+OSC_ERR OscCamFrameRingReference(struct OSC_CAM_FRAME_RING *pRing,
+		const int index, const int delta);
+
+#endif /*CAM_RING_H_*/
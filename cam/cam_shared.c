@@ -27,6 +27,7 @@
 #include "cam.h"
 
 #include <unistd.h>
+#include <time.h>
 
 extern struct OSC_CAM cam;
 
@@ -136,7 +137,10 @@ OSC_ERR OscCamSetBlackLevelOffset(const uint16 offset)
 	{
 		reg = offset << 2;
 	}
-	OscCamSetRegisterValue( CAM_REG_ROW_NOISE_CONST , reg);
+	if(OscCamSetRegisterValue( CAM_REG_ROW_NOISE_CONST , reg) == SUCCESS)
+	{
+		cam.curBlackLevel = reg >> 2;
+	}
 	
 	return SUCCESS;
 }
@@ -151,6 +155,55 @@ OSC_ERR OscCamGetBlackLevelOffset(uint16 *pOffset)
 	return SUCCESS;
 }
 
+uint64_t OscCamGetTime()
+{
+	struct timespec now;
+	
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec*1000000 + now.tv_nsec/1000;
+}
+
+void OscCamFrameInfoSetup(const uint8 fb)
+{
+	struct OSC_CAM_FRAME_INFO *pInfo = &cam.frameInfo[fb];
+	
+	memset(pInfo, 0, sizeof(struct OSC_CAM_FRAME_INFO));
+	pInfo->seqNr = cam.nCaptures++;
+	pInfo->col_off = cam.capWin.col_off;
+	pInfo->row_off = cam.capWin.row_off;
+	pInfo->width = cam.capWin.width;
+	pInfo->height = cam.capWin.height;
+	pInfo->exposureTime = cam.curExpTime;
+	pInfo->blackLevel = cam.curBlackLevel;
+	/* The earliest the exposure can start, refined when read */
+	pInfo->exposureStart = OscCamGetTime();
+	cam.bFrameInfoValid[fb] = FALSE;
+}
+
+OSC_ERR OscCamGetFrameInfo(const uint8 *pPic,
+		struct OSC_CAM_FRAME_INFO *pInfo)
+{
+	int i;
+	
+	/* Input validation */
+	if(pPic == NULL || pInfo == NULL)
+	{
+		OscLog(ERROR, "%s(0x%x, 0x%x): Invalid parameter!\n",
+				__func__, pPic, pInfo);
+		return -EINVALID_PARAMETER;
+	}
+	
+	for(i = 0; i < MAX_NR_FRAME_BUFFERS; i++)
+	{
+		if(cam.fbufs[i].data == pPic && cam.bFrameInfoValid[i])
+		{
+			*pInfo = cam.frameInfo[i];
+			return SUCCESS;
+		}
+	}
+	return -ENO_MATCHING_PICTURE;
+}
+
 OSC_ERR OscCamCreateMultiBuffer(const uint8 multiBufferDepth,
 		const uint8 bufferIDs[])
 {
@@ -194,6 +247,213 @@ OSC_ERR OscCamDeleteMultiBuffer()
 	return OscCamMultiBufferDestroy(&cam.multiBuffer);
 }
 
+/*********************************************************************//*!
+ * @brief Find a frame buffer in the frame ring.
+ * 
+ * @param fbID ID of the frame buffer.
+ * @return Index of the frame in the ring or -1 if not part of it.
+ *//*********************************************************************/
+static int OscCamFrameRingFind(const uint8 fbID)
+{
+	int i;
+	
+	for(i = 0; i < cam.frameRing.depth; i++)
+	{
+		if(cam.frameRing.fbIDs[i] == fbID)
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+OSC_ERR OscCamCreateFrameRing(const uint8 depth, const uint8 bufferIDs[])
+{
+	int i, j;
+	
+	if(cam.stream.bRunning)
+	{
+		OscLog(ERROR, "%s: The frame ring is being captured to.\n",
+				__func__);
+		return -EDEVICE_BUSY;
+	}
+	
+	/* Input validation */
+	if((depth < 2) || (depth > MAX_NR_FRAME_BUFFERS) || (bufferIDs == NULL))
+	{
+		OscLog(ERROR, "%s(%u, 0x%x): Invalid Parameter!\n",
+				__func__, depth, bufferIDs);
+		return -EINVALID_PARAMETER;
+	}
+	for(i = 0; i < depth; i++)
+	{
+		if(bufferIDs[i] >= MAX_NR_FRAME_BUFFERS ||
+				cam.fbufs[bufferIDs[i]].data == NULL)
+		{
+			OscLog(ERROR, "%s: Invalid frame buffer in frame ring.\n",
+					__func__);
+			return -EINVALID_PARAMETER;
+		}
+		for(j = 0; j < i; j++)
+		{
+			if(bufferIDs[j] == bufferIDs[i])
+			{
+				OscLog(ERROR, "%s: Frame buffer %u is in the frame ring "
+						"twice.\n", __func__, bufferIDs[i]);
+				return -EINVALID_PARAMETER;
+			}
+		}
+	}
+	
+	return OscCamFrameRingInit(&cam.frameRing, depth, bufferIDs);
+}
+
+OSC_ERR OscCamDeleteFrameRing()
+{
+	int i;
+	
+	if(cam.stream.bRunning)
+	{
+		OscLog(ERROR, "%s: The frame ring is being captured to.\n",
+				__func__);
+		return -ECANNOT_DELETE;
+	}
+	for(i = 0; i < cam.frameRing.depth; i++)
+	{
+		if(cam.frameRing.state[i] > RING_FRAME_READY)
+		{
+			OscLog(ERROR, "%s: Frame buffer %u is still held.\n",
+					__func__, cam.frameRing.fbIDs[i]);
+			return -ECANNOT_DELETE;
+		}
+	}
+	
+	cam.frameRing.depth = 0;
+	return SUCCESS;
+}
+
+OSC_ERR OscCamCaptureToFrameRing(const uint16 maxAge, const uint16 timeout)
+{
+	int         index;
+	uint8       fb, *pPic;
+	OSC_ERR     err;
+	
+	if(cam.frameRing.depth == 0)
+	{
+		OscLog(ERROR, "%s: No frame ring configured!\n", __func__);
+		return -ENOT_INITIALIZED;
+	}
+	
+	index = OscCamFrameRingBeginCapture(&cam.frameRing);
+	if(index == -1)
+	{
+		OscLog(DEBUG, "%s: All frame buffers are held.\n", __func__);
+		return -EFRAME_BUFFER_BUSY;
+	}
+	fb = cam.frameRing.fbIDs[index];
+	
+	err = OscCamSetupCapture(fb);
+	if(err == SUCCESS)
+	{
+		err = OscCamReadPicture(fb, &pPic, maxAge, timeout);
+	}
+	if(err == SUCCESS)
+	{
+		cam.frameRing.timestamp[index] = OscCamGetTime();
+	}
+	
+	OscCamFrameRingEndCapture(&cam.frameRing, index, err == SUCCESS);
+	return err;
+}
+
+OSC_ERR OscCamAcquireFrame(uint8 *pFbID, uint8 **ppPic)
+{
+	int index;
+	
+	/* Input validation */
+	if(pFbID == NULL || ppPic == NULL)
+	{
+		OscLog(ERROR, "%s(0x%x, 0x%x): Invalid parameter!\n",
+				__func__, pFbID, ppPic);
+		return -EINVALID_PARAMETER;
+	}
+	
+	index = OscCamFrameRingAcquire(&cam.frameRing);
+	if(index == -1)
+	{
+		return -ENO_MATCHING_PICTURE;
+	}
+	
+	*pFbID = cam.frameRing.fbIDs[index];
+	*ppPic = cam.fbufs[*pFbID].data;
+	return SUCCESS;
+}
+
+OSC_ERR OscCamRetainFrame(const uint8 fbID)
+{
+	int index = OscCamFrameRingFind(fbID);
+	
+	if(index == -1 ||
+			OscCamFrameRingReference(&cam.frameRing, index, 1) != SUCCESS)
+	{
+		OscLog(ERROR, "%s(%u): Frame buffer not held!\n", __func__, fbID);
+		return -EINVALID_PARAMETER;
+	}
+	return SUCCESS;
+}
+
+OSC_ERR OscCamReleaseFrame(const uint8 fbID)
+{
+	int index = OscCamFrameRingFind(fbID);
+	
+	if(index == -1 ||
+			OscCamFrameRingReference(&cam.frameRing, index, -1) != SUCCESS)
+	{
+		OscLog(ERROR, "%s(%u): Frame buffer not held!\n", __func__, fbID);
+		return -EINVALID_PARAMETER;
+	}
+	return SUCCESS;
+}
+
+OSC_ERR OscCamGetFrame(const uint8 fbID, struct OSC_CAM_FRAME *pFrame)
+{
+	int index = OscCamFrameRingFind(fbID);
+	
+	/* Input validation */
+	if(pFrame == NULL)
+	{
+		OscLog(ERROR, "%s(%u, 0x%x): Invalid parameter!\n",
+				__func__, fbID, pFrame);
+		return -EINVALID_PARAMETER;
+	}
+	if(index == -1 || cam.frameRing.state[index] <= RING_FRAME_READY)
+	{
+		OscLog(ERROR, "%s(%u): Frame buffer not held!\n", __func__, fbID);
+		return -EINVALID_PARAMETER;
+	}
+	
+	pFrame->fbID = fbID;
+	pFrame->pData = cam.fbufs[fbID].data;
+	pFrame->seqNr = cam.frameRing.seqNr[index];
+	pFrame->timestamp = cam.frameRing.timestamp[index];
+	return SUCCESS;
+}
+
+OSC_ERR OscCamGetFrameRingStats(uint32 *pCaptured, uint32 *pDropped)
+{
+	/* Input validation */
+	if(pCaptured == NULL || pDropped == NULL)
+	{
+		OscLog(ERROR, "%s(0x%x, 0x%x): Invalid parameter!\n",
+				__func__, pCaptured, pDropped);
+		return -EINVALID_PARAMETER;
+	}
+	
+	*pCaptured = cam.frameRing.nCaptured;
+	*pDropped = cam.frameRing.nDropped;
+	return SUCCESS;
+}
+
 OSC_ERR OscCamSetupPerspective(const enum EnOscCamPerspective perspective)
 {
 	uint16  reg;
@@ -0,0 +1,244 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+	
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+	
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+	
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+
+/*! @file
+ * @brief Capture stream implementation
+	
+ * Keeps capturing into the frame ring on a thread of its own and
+ * signals every captured frame over a pipe, which either the
+ * application polls or a second thread waits on to call the registered
+ * callback.
+ */
+
+#include "cam.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+extern struct OSC_CAM cam;
+
+/*==================== Private method prototypes =======================*/
+/*********************************************************************//*!
+ * @brief The capturing thread of the stream.
+ * 
+ * @param pArg Unused.
+ * @return NULL
+ *//*********************************************************************/
+static void * OscCamStreamCaptureThread(void *pArg);
+
+/*********************************************************************//*!
+ * @brief The thread calling the callback of the stream with every
+ * captured frame.
+ * 
+ * @param pArg Unused.
+ * @return NULL
+ *//*********************************************************************/
+static void * OscCamStreamCallbackThread(void *pArg);
+
+/*********************************************************************//*!
+ * @brief Close the pipe of the stream.
+ *//*********************************************************************/
+static void OscCamStreamClosePipe();
+
+/*=========================== Code =====================================*/
+
+static void * OscCamStreamCaptureThread(void *pArg)
+{
+	struct CAM_STREAM *pStream = &cam.stream;
+	OSC_ERR err;
+#if defined(OSC_HOST) || defined(OSC_SIM)
+	uint32 timeStep;
+#endif /* OSC_HOST or OSC_SIM*/
+	
+	while(!pStream->bStop)
+	{
+#if defined(OSC_HOST) || defined(OSC_SIM)
+		/* The test image only changes with the simulation time step. */
+		timeStep = OscSimGetCurTimeStep();
+		if(timeStep == pStream->lastTimeStep)
+		{
+			usleep(CAM_STREAM_RETRY_DELAY);
+			continue;
+		}
+#endif /* OSC_HOST or OSC_SIM*/
+		
+		err = OscCamCaptureToFrameRing(0, pStream->timeout);
+		if(err == SUCCESS)
+		{
+			/* If the pipe is full the frames are signalled already. */
+			if(write(pStream->fds[1], "", 1) < 0 && errno != EAGAIN)
+			{
+				OscLog(ERROR, "%s: Unable to signal frame!\n", __func__);
+			}
+		} else if(err != -EFRAME_BUFFER_BUSY && err != pStream->lastError) {
+			OscLog(ERROR, "%s: Capture failed (%d)!\n", __func__, err);
+		}
+		
+		if(err == -EFRAME_BUFFER_BUSY)
+		{
+			/* Wait for the consumers to release a frame. */
+			usleep(CAM_STREAM_RETRY_DELAY);
+			continue;
+		}
+		pStream->lastError = err;
+#if defined(OSC_HOST) || defined(OSC_SIM)
+		pStream->lastTimeStep = timeStep;
+#else
+		if(err != SUCCESS)
+		{
+			usleep(CAM_STREAM_RETRY_DELAY);
+		}
+#endif /* OSC_HOST or OSC_SIM*/
+	}
+	return NULL;
+}
+
+static void * OscCamStreamCallbackThread(void *pArg)
+{
+	struct CAM_STREAM *pStream = &cam.stream;
+	struct OSC_CAM_FRAME frame;
+	uint8 signals[64], *pPic;
+	ssize_t n;
+	
+	for(;;)
+	{
+		n = read(pStream->fds[0], signals, sizeof(signals));
+		if(n < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if(n <= 0 || pStream->bStop)
+		{
+			break;
+		}
+		
+		/* Deliver every ready frame, oldest first. */
+		while(OscCamAcquireFrame(&frame.fbID, &pPic) == SUCCESS)
+		{
+			OscCamGetFrame(frame.fbID, &frame);
+			pStream->pCallback(&frame, pStream->pUserData);
+			OscCamReleaseFrame(frame.fbID);
+		}
+	}
+	return NULL;
+}
+
+static void OscCamStreamClosePipe()
+{
+	close(cam.stream.fds[0]);
+	close(cam.stream.fds[1]);
+	cam.stream.fds[0] = -1;
+	cam.stream.fds[1] = -1;
+}
+
+OSC_ERR OscCamStartStreaming(const OscCamFrameCallback pCallback,
+		void *pUserData, const uint16 timeout)
+{
+	struct CAM_STREAM *pStream = &cam.stream;
+	
+	if(pStream->bRunning)
+	{
+		OscLog(ERROR, "%s: Stream already running!\n", __func__);
+		return -EDEVICE_BUSY;
+	}
+	if(cam.frameRing.depth == 0)
+	{
+		OscLog(ERROR, "%s: No frame ring configured!\n", __func__);
+		return -ENOT_INITIALIZED;
+	}
+	
+	if(pipe(pStream->fds) != 0)
+	{
+		OscLog(ERROR, "%s: Unable to create pipe!\n", __func__);
+		return -EDEVICE;
+	}
+	/* The capture must never wait for the consumers. */
+	fcntl(pStream->fds[1], F_SETFL, O_NONBLOCK);
+	if(pCallback == NULL)
+	{
+		fcntl(pStream->fds[0], F_SETFL, O_NONBLOCK);
+	}
+	
+	pStream->bStop = FALSE;
+	pStream->pCallback = pCallback;
+	pStream->pUserData = pUserData;
+	pStream->timeout = timeout;
+	pStream->lastError = SUCCESS;
+#if defined(OSC_HOST) || defined(OSC_SIM)
+	pStream->lastTimeStep = OscSimGetCurTimeStep() - 1;
+#endif /* OSC_HOST or OSC_SIM*/
+	
+	if(pCallback != NULL && pthread_create(&pStream->callbackThread, NULL,
+			OscCamStreamCallbackThread, NULL) != 0)
+	{
+		OscLog(ERROR, "%s: Unable to start callback thread!\n", __func__);
+		OscCamStreamClosePipe();
+		return -EDEVICE;
+	}
+	if(pthread_create(&pStream->captureThread, NULL,
+			OscCamStreamCaptureThread, NULL) != 0)
+	{
+		OscLog(ERROR, "%s: Unable to start capture thread!\n", __func__);
+		if(pCallback != NULL)
+		{
+			pStream->bStop = TRUE;
+			write(pStream->fds[1], "", 1);
+			pthread_join(pStream->callbackThread, NULL);
+		}
+		OscCamStreamClosePipe();
+		return -EDEVICE;
+	}
+	
+	pStream->bRunning = TRUE;
+	return SUCCESS;
+}
+
+OSC_ERR OscCamStopStreaming()
+{
+	struct CAM_STREAM *pStream = &cam.stream;
+	
+	if(!pStream->bRunning)
+	{
+		OscLog(WARN, "%s: No stream running.\n", __func__);
+		return -ENOT_INITIALIZED;
+	}
+	
+	pStream->bStop = TRUE;
+	pthread_join(pStream->captureThread, NULL);
+	if(pStream->pCallback != NULL)
+	{
+		/* Wake up the callback thread in case it waits for a frame. */
+		write(pStream->fds[1], "", 1);
+		pthread_join(pStream->callbackThread, NULL);
+	}
+	OscCamStreamClosePipe();
+	
+	pStream->bRunning = FALSE;
+	return SUCCESS;
+}
+
+int OscCamGetStreamingFd()
+{
+	if(!cam.stream.bRunning || cam.stream.pCallback != NULL)
+	{
+		return -ENOT_INITIALIZED;
+	}
+	return cam.stream.fds[0];
+}
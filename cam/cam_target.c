@@ -105,6 +105,13 @@ OSC_ERR OscCamSetFileNameReader(void* hReaderHandle)
 	return SUCCESS;
 }
 
+OSC_ERR OscCamSetFrameCache(const uint16 nrOfFrames,
+		const uint16 prefetchDepth)
+{
+	/* Stump implementation on target platform. */
+	return SUCCESS;
+}
+
 OSC_ERR OscCamSetAreaOfInterest(const uint16 lowX,
 								const uint16 lowY,
 								const uint16 width,
@@ -314,6 +321,18 @@ OSC_ERR OscCamSetFrameBuffer(const uint8 fbID,
 				return -ECANNOT_DELETE;
 			}
 		}
+		/* The frame ring may still hand the frame buffer out. */
+		for(i = 0; i < cam.frameRing.depth; i++)
+		{
+			if(cam.frameRing.fbIDs[i] == fbID)
+			{
+				OscLog(ERROR,
+						"%s: Deleting frame buffer %d being part of "
+						"the frame ring!\n",
+						__func__, fbID);
+				return -ECANNOT_DELETE;
+			}
+		}
 	}
 	
 	ret = ioctl(cam.vidDev, CAM_SFRAMEBUF, &fb);
@@ -416,6 +435,7 @@ OSC_ERR OscCamSetupCapture(uint8 fbID)
 	}
 	
 	/* The operation was successful */
+	OscCamFrameInfoSetup(fb);
 	
 	if(fbID == OSC_CAM_MULTI_BUFFER)
 	{
@@ -460,6 +480,9 @@ OSC_ERR OscCamReadPicture(const uint8 fbID,
 	int                 ret;
 	OSC_ERR             err = SUCCESS;
 	uint8               fb;
+	struct OSC_CAM_FRAME_INFO *pInfo;
+	struct capture_window win;
+	uint64_t            exposureEnd;
 	
 	/* If the caller is using automatic multibuffer management,
 	 * get the correct frame buffer. */
@@ -523,17 +546,47 @@ OSC_ERR OscCamReadPicture(const uint8 fbID,
 		}
 	}
 	
+	/* Describe the picture. The exposure ended a readout time before
+	 * the transfer completed, which is now unless the picture had been
+	 * waiting already. It cannot have ended before it was set up. */
+	pInfo = &cam.frameInfo[fb];
+	pInfo->readTime = OscCamGetTime();
+	exposureEnd = pInfo->readTime -
+			(uint64_t)pInfo->height*cam.curCamRowClks/(CAM_PIX_CLK/1000000);
+	if(exposureEnd < pInfo->exposureStart + pInfo->exposureTime)
+	{
+		exposureEnd = pInfo->exposureStart + pInfo->exposureTime;
+	}
+	pInfo->exposureEnd = exposureEnd;
+	pInfo->exposureStart = exposureEnd - pInfo->exposureTime;
+	cam.bFrameInfoValid[fb] = TRUE;
+	
 	*ppPic = cam.fbufs[fb].data;
 	
+	/* The picture has the window it was captured with, the area of
+	 * interest may have been changed since. */
+	win.col_off = pInfo->col_off;
+	win.row_off = pInfo->row_off;
+	win.width   = pInfo->width;
+	win.height  = pInfo->height;
+	
 	/* Apply image correction */
+	if(cam.bCorrection)
+	{
+		OscCamCorrectWindow(*ppPic, &win, 1);
+	}
+	if(cam.aec.bEnabled)
+	{
+		OscCamAecProcess(*ppPic, win.width, win.height, 1);
+	}
 	if( cam.pCallback)
 	{
 		err = (*cam.pCallback)(
 				*ppPic,
-				cam.capWin.col_off,
-				cam.capWin.row_off,
-				cam.capWin.width,
-				cam.capWin.height);
+				win.col_off,
+				win.row_off,
+				win.width,
+				win.height);
 	}
 
 	
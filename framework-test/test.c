@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 #include <sys/time.h>
 #include <sched.h>
 #include <errno.h>
@@ -300,6 +301,363 @@ int testBMP()
 	return 0;
 }
 
+/* Compares the vectorized fast debayering of every instruction set supported by the CPU to the scalar reference code. */
+int testFastDebayer()
+{
+	OSC_ERR (*functions[])(const struct OSC_PICTURE *, struct OSC_PICTURE *) = {
+		OscVisFastDebayerBGR, OscVisFastDebayerRGB, OscVisFastDebayerGrey, OscVisFastDebayerLumY,
+		OscVisFastDebayerChromU, OscVisFastDebayerChromV, OscVisFastDebayerYUV422
+	};
+	/* widths with and without a scalar rest */
+	const uint16 widths[] = { 4, 36, 124, 752 };
+	const uint16 height = 16;
+	enum EnOscVisSimd simd, best = OscVisGetSimd();
+	struct OSC_PICTURE raw, ref, out;
+	uint8 *pRaw, *pRef, *pOut;
+	uint32 f, w, i, outSize;
+
+	pRaw = malloc(752 * height);
+	pRef = malloc(752 * height * 3 / 4);
+	pOut = malloc(752 * height * 3 / 4);
+	/* random pixels and saturated ones for the overflows of the chrominance */
+	for (i = 0; i < 752 * height; i++)
+		pRaw[i] = i % 3 ? rand() : (rand() % 2) * 255;
+
+	for (f = 0; f < sizeof(functions) / sizeof(functions[0]); f++)
+	{
+		for (w = 0; w < sizeof(widths) / sizeof(widths[0]); w++)
+		{
+			raw.data = pRaw;
+			raw.width = widths[w];
+			raw.height = height;
+			raw.type = OSC_PICTURE_GREYSCALE;
+			ref.data = pRef;
+			out.data = pOut;
+			/* large enough for all output types, the rest stays 0 */
+			outSize = widths[w] * height * 3 / 4;
+
+			memset(pRef, 0, outSize);
+			OscVisSetSimd(OSC_VIS_SIMD_NONE);
+			functions[f](&raw, &ref);
+			for (simd = OSC_VIS_SIMD_SSE2; simd <= OSC_VIS_SIMD_NEON; simd++)
+			{
+				if (OscVisSetSimd(simd) != SUCCESS)
+					continue;
+				memset(pOut, 0, outSize);
+				functions[f](&raw, &out);
+				if (memcmp(pRef, pOut, outSize) != 0)
+				{
+					printf("%s: Function %d differs for instruction set %d and width %d.\n",
+							__FUNCTION__, f, simd, widths[w]);
+					OscVisSetSimd(best);
+					return -1;
+				}
+			}
+		}
+	}
+	OscVisSetSimd(best);
+	free(pRaw);
+	free(pRef);
+	free(pOut);
+	return 0;
+}
+
+/* Labels 0/255 masks, which must be labeled like 0/1 images, and images with more objects than fit into the regions struct. */
+int testLabelBinary()
+{
+	static struct OSC_VIS_REGIONS regions;
+	struct OSC_PICTURE pic;
+	uint8 *pImg;
+	uint32 i, noOfRuns, x, y;
+	OSC_ERR err;
+
+	pImg = calloc(640 * 480, 1);
+	pic.data = pImg;
+	pic.width = 640;
+	pic.height = 480;
+	pic.type = OSC_PICTURE_BINARY;
+
+	/* a rectangle and a ring, whose root run comes after some of its runs */
+	for (y = 10; y < 30; y++)
+		for (x = 13; x < 57; x++)
+			pImg[y * 640 + x] = 255;
+	for (y = 100; y < 140; y++)
+		for (x = 100; x < 200; x++)
+			if ((y - 100) * (y - 100) + (x - 150) * (x - 150) / 4 > 100 || y > 130)
+				pImg[y * 640 + x] = 255;
+	err = OscVisLabelBinary(&pic, &regions);
+	if (err != SUCCESS || regions.noOfObjects != 2)
+	{
+		printf("%s: Labeling a 0/255 image failed.\n", __FUNCTION__);
+		return -1;
+	}
+	noOfRuns = regions.noOfRuns;
+	for (i = 0; i < 640 * 480; i++)
+		pImg[i] = pImg[i] ? 1 : 0;
+	err = OscVisLabelBinary(&pic, &regions);
+	if (err != SUCCESS || regions.noOfObjects != 2 || regions.noOfRuns != noOfRuns)
+	{
+		printf("%s: A 0/1 image is labeled differently from the 0/255 image.\n", __FUNCTION__);
+		return -1;
+	}
+
+	/* more V shapes than MAX_NO_OF_OBJECTS, the runs of the stored ones must be labeled */
+	memset(pImg, 0, 640 * 480);
+	for (y = 0; y < 360; y += 20)
+		for (x = 0; x < 600; x += 10)
+		{
+			pImg[y * 640 + x] = 1;
+			pImg[y * 640 + x + 2] = 1;
+			pImg[(y + 1) * 640 + x + 1] = 1;
+		}
+	err = OscVisLabelBinary(&pic, &regions);
+	if (err != -EBUFFER_TOO_SMALL || regions.noOfObjects != MAX_NO_OF_OBJECTS)
+	{
+		printf("%s: Object overflow not reported.\n", __FUNCTION__);
+		return -1;
+	}
+	noOfRuns = 0;
+	for (i = 0; i < regions.noOfRuns; i++)
+	{
+		struct OSC_VIS_REGIONS_RUN *pRoot = &regions.runs[i];
+
+		while (pRoot->parent != NULL)
+			pRoot = pRoot->parent;
+		if (regions.runs[i].label != pRoot->label)
+		{
+			printf("%s: Run %u is labeled %u after an object overflow.\n", __FUNCTION__, i, regions.runs[i].label);
+			return -1;
+		}
+		if (regions.runs[i].label != 0)
+			noOfRuns++;
+	}
+	if (noOfRuns != 3 * MAX_NO_OF_OBJECTS)
+	{
+		printf("%s: %u runs labeled after an object overflow.\n", __FUNCTION__, noOfRuns);
+		return -1;
+	}
+	free(pImg);
+	return 0;
+}
+
+/* Natural index of the coefficient at every position of the zig-zag sequence. */
+static const uint8 dezigzag[64] = {
+	 0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+	12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+	35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+	58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/* Huffman table of the baseline JPEG decoder of the tests. */
+struct TEST_HUFFMAN {
+	int32 maxCode[17];
+	int32 valOffset[17];
+	uint8 values[256];
+};
+
+/* Bit reader of the entropy coded data of a JPEG image. */
+struct TEST_BITS {
+	const uint8 *p;
+	uint32 buffer;
+	int32 count;
+};
+
+static uint32 testReadBit(struct TEST_BITS *pBits)
+{
+	if (pBits->count == 0)
+	{
+		pBits->buffer = *pBits->p++;
+		/* skip the stuffed zero byte */
+		if (pBits->buffer == 0xff)
+			pBits->p++;
+		pBits->count = 8;
+	}
+	pBits->count--;
+	return (pBits->buffer >> pBits->count) & 1;
+}
+
+static int32 testReceive(struct TEST_BITS *pBits, uint8 size)
+{
+	int32 v = 0;
+	uint8 i;
+
+	for (i = 0; i < size; i++)
+		v = (v << 1) | testReadBit(pBits);
+	/* negative values are coded as the complement */
+	if (size > 0 && v < (1 << (size - 1)))
+		v -= (1 << size) - 1;
+	return v;
+}
+
+static uint8 testDecodeHuffman(struct TEST_BITS *pBits, const struct TEST_HUFFMAN *pTable)
+{
+	int32 code = 0;
+	uint8 l;
+
+	for (l = 1; l <= 16; l++)
+	{
+		code = (code << 1) | testReadBit(pBits);
+		if (code <= pTable->maxCode[l])
+			return pTable->values[code + pTable->valOffset[l]];
+	}
+	return 0;
+}
+
+/* Decodes a greyscale baseline JPEG image without restart intervals, whose size is a multiple of 8. */
+static int testDecodeGreyJpeg(const uint8 *pJpg, uint8 *pOut, uint16 width, uint16 height)
+{
+	struct TEST_HUFFMAN tables[2][2];
+	struct TEST_BITS bits = { NULL, 0, 0 };
+	uint8 quant[64] = { 0 };
+	double cosines[8][8], coeffs[64], tmp[64], v;
+	int32 dc = 0, code, k, x, y, u, i, bx, by, length, count;
+	uint8 rs, l;
+
+	for (x = 0; x < 8; x++)
+		for (u = 0; u < 8; u++)
+			cosines[x][u] = (u == 0 ? sqrt(0.125) : 0.5) * cos((2 * x + 1) * u * M_PI / 16);
+
+	/* markers up to the start of the scan */
+	pJpg += 2;
+	while (bits.p == NULL)
+	{
+		length = (pJpg[2] << 8) | pJpg[3];
+		switch (pJpg[1])
+		{
+		case 0xdb:
+			/* the luminance table comes first */
+			memcpy(quant, &pJpg[5], 64);
+			break;
+		case 0xc4:
+			for (i = 4; i < length + 2; i += 17 + count)
+			{
+				struct TEST_HUFFMAN *pTable = &tables[pJpg[i] >> 4][pJpg[i] & 1];
+				code = 0;
+				count = 0;
+				for (l = 1; l <= 16; l++)
+				{
+					pTable->valOffset[l] = count - code;
+					code += pJpg[i + l];
+					count += pJpg[i + l];
+					pTable->maxCode[l] = code - 1;
+					code <<= 1;
+				}
+				memcpy(pTable->values, &pJpg[i + 17], count);
+			}
+			break;
+		case 0xda:
+			bits.p = &pJpg[length + 2];
+			break;
+		case 0xc0:
+			if (pJpg[9] != 1 || ((pJpg[5] << 8) | pJpg[6]) != height || ((pJpg[7] << 8) | pJpg[8]) != width)
+				return -1;
+			break;
+		case 0xdd:
+			return -1;
+		}
+		pJpg += length + 2;
+	}
+
+	for (by = 0; by < height; by += 8)
+	{
+		for (bx = 0; bx < width; bx += 8)
+		{
+			memset(coeffs, 0, sizeof(coeffs));
+			dc += testReceive(&bits, testDecodeHuffman(&bits, &tables[0][0]));
+			coeffs[0] = dc * quant[0];
+			for (k = 1; k < 64; k++)
+			{
+				rs = testDecodeHuffman(&bits, &tables[1][0]);
+				if ((rs & 0xf) == 0)
+				{
+					if (rs != 0xf0)
+						break;
+					k += 15;
+					continue;
+				}
+				k += rs >> 4;
+				coeffs[dezigzag[k]] = testReceive(&bits, rs & 0xf) * quant[k];
+			}
+			/* separable inverse DCT */
+			for (y = 0; y < 8; y++)
+				for (x = 0; x < 8; x++)
+					for (u = 0, tmp[y * 8 + x] = 0; u < 8; u++)
+						tmp[y * 8 + x] += cosines[x][u] * coeffs[y * 8 + u];
+			for (y = 0; y < 8; y++)
+				for (x = 0; x < 8; x++)
+				{
+					for (u = 0, v = 128.5; u < 8; u++)
+						v += cosines[y][u] * tmp[u * 8 + x];
+					pOut[(by + y) * width + bx + x] = v < 0 ? 0 : v > 255 ? 255 : (uint8)v;
+				}
+		}
+	}
+	return 0;
+}
+
+/* Returns the PSNR in dB of a greyscale image compared to the original. */
+static double testPsnr(const uint8 *pOrig, const uint8 *pImg, uint32 nPixels)
+{
+	double sum = 0;
+	uint32 i;
+
+	for (i = 0; i < nPixels; i++)
+		sum += (double)(pOrig[i] - pImg[i]) * (pOrig[i] - pImg[i]);
+	return sum == 0 ? 99 : 10 * log10(255.0 * 255.0 * nPixels / sum);
+}
+
+/* Compares the PSNR of the fast DCT to the one of the reference DCT at the finest quantizations. */
+int testJpgFastDct()
+{
+	const uint16 width = 640, height = 480;
+	const uint32 qualities[] = { 1, 32 };
+	struct OSC_PICTURE pic;
+	uint8 *pImg, *pJpg, *pDecoded, *pEnd;
+	double psnr[2];
+	void *hEncoder;
+	uint32 q, m, x, y;
+
+	pImg = malloc(width * height);
+	pDecoded = malloc(width * height);
+	pJpg = malloc(4 * width * height);
+	for (y = 0; y < height; y++)
+		for (x = 0; x < width; x++)
+			pImg[y * width + x] = 128 + 60 * sin(x * 0.05 + y * 0.03) + 40 * sin(x * x * 0.0004 + y * 0.2) + rand() % 7 - 3;
+	pic.data = pImg;
+	pic.width = width;
+	pic.height = height;
+	pic.type = OSC_PICTURE_YUV_400;
+
+	if (OscJpgCreateEncoder(&hEncoder) != SUCCESS)
+		return -1;
+	for (q = 0; q < sizeof(qualities) / sizeof(qualities[0]); q++)
+	{
+		for (m = 0; m < 2; m++)
+		{
+			OscJpgSetDctMode(hEncoder, m ? OSC_JPG_DCT_FAST : OSC_JPG_DCT_REFERENCE);
+			if (OscJpgEncodePicture(hEncoder, &pic, pJpg, qualities[q], &pEnd) != SUCCESS ||
+					testDecodeGreyJpeg(pJpg, pDecoded, width, height) != 0)
+			{
+				printf("%s: Encoding or decoding failed.\n", __FUNCTION__);
+				return -1;
+			}
+			psnr[m] = testPsnr(pImg, pDecoded, width * height);
+		}
+		printf("%s: Quality factor %u: PSNR %.2f dB (reference), %.2f dB (fast).\n",
+				__FUNCTION__, qualities[q], psnr[0], psnr[1]);
+		if (psnr[1] < psnr[0] - 0.5)
+		{
+			printf("%s: The fast DCT is less accurate than the reference DCT.\n", __FUNCTION__);
+			return -1;
+		}
+	}
+	OscJpgDestroyEncoder(hEncoder);
+	free(pImg);
+	free(pDecoded);
+	free(pJpg);
+	return 0;
+}
+
 #define FB_SIZE 752*480*1
 uint8 fbs[8][FB_SIZE];
 
@@ -836,6 +1194,15 @@ int main()
 	if(testSwr())
 		return -1;
 
+	if(testFastDebayer())
+		return -1;
+
+	if(testLabelBinary())
+		return -1;
+
+	if(testJpgFastDct())
+		return -1;
+
 /*
 	if(testCam())
 			return -1;
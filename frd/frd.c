@@ -23,6 +23,12 @@
 #include <errno.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
 
 #include "oscar.h"
 
@@ -60,6 +66,9 @@ struct OSC_FRD_FILELIST_READER
 	FILE * pFList;
 	/* @brief The current file name. */
 	char curFileName[1024];
+	/* @brief Protects the file list and the current file name, which
+	 * may be used by other threads than the simulation thread. */
+	pthread_mutex_t lock;
 };
 
 /*! @brief Reader object struct for a constant reader*/
@@ -69,12 +78,30 @@ struct OSC_FRD_CONSTANT_READER
 	char strFN[1024];
 };
 
+/*! @brief Reader object struct for a recording reader*/
+struct OSC_FRD_RECORDING_READER
+{
+	/* @brief The file name of the recording. */
+	char strRecording[MAX_PATH_LEN];
+	/* @brief The recording mapped into memory. */
+	const uint8 *pFile;
+	/* @brief The size of the recording. */
+	size_t fileSize;
+	/* @brief The index of the recording. */
+	const struct OSC_FRD_RECORDING_ENTRY *pIndex;
+	/* @brief The number of frames in the recording. */
+	uint32 nrOfFrames;
+	/* @brief The size of an entry of the index. */
+	uint32 entrySize;
+};
+
 /* @brief Enumeration of the different supported reader types. */
 enum EnFilenameReaderType
 {
 	FRD_READER_TYPE_SEQUENCE,
 	FRD_READER_TYPE_LIST,
-	FRD_READER_TYPE_CONSTANT
+	FRD_READER_TYPE_CONSTANT,
+	FRD_READER_TYPE_RECORDING
 };
 
 /* @brief A reader can only be of one type, thus placing all reader
@@ -92,6 +119,8 @@ struct OSC_FRD_READER
 		struct OSC_FRD_FILELIST_READER list;
 		/*! @brief Constant file name reader. */
 		struct OSC_FRD_CONSTANT_READER constant;
+		/*! @brief Recording reader. */
+		struct OSC_FRD_RECORDING_READER rec;
 	} reader;
 };
 
@@ -105,6 +134,21 @@ struct OSC_FRD
 
 struct OSC_FRD frd; /*!< Module singelton instance */
 
+/*! @brief A recording being written, see OscFrdCreateRecording(). */
+struct OSC_FRD_RECORDING
+{
+	/*! @brief The open recording file. */
+	FILE *pFile;
+	/*! @brief The header, completed when closing the recording. */
+	struct OSC_FRD_RECORDING_HEADER header;
+	/*! @brief The index of the frames written so far. */
+	struct OSC_FRD_RECORDING_ENTRY *pIndex;
+	/*! @brief The number of entries allocated for the index. */
+	uint32 indexSize;
+	/*! @brief The position of the next frame in the file. */
+	uint64_t offset;
+};
+
 struct OscModule OscModule_frd = {
 	.name = "frd",
 	.create = OscFrdCreate,
@@ -150,6 +194,11 @@ OSC_ERR OscFrdDestroy()
 		{
 		case FRD_READER_TYPE_LIST:
 			fclose(pReader->reader.list.pFList);
+			pthread_mutex_destroy(&pReader->reader.list.lock);
+			break;
+		case FRD_READER_TYPE_RECORDING:
+			munmap((void*)pReader->reader.rec.pFile,
+					pReader->reader.rec.fileSize);
 			break;
 		case FRD_READER_TYPE_SEQUENCE:
 		case FRD_READER_TYPE_CONSTANT:
@@ -180,6 +229,7 @@ static void OscFrdListFetchNextFileName(
 	}
 	
 	/* Get the next file name from the list. */
+	pthread_mutex_lock(&pReader->lock);
 	assigned = fscanf(pReader->pFList, "%[^\t\n]\n",
 			pReader->curFileName);
 	if(unlikely(assigned != 1))
@@ -202,6 +252,7 @@ static void OscFrdListFetchNextFileName(
 					"Probably not intended.\n", __func__);
 		}
 	}
+	pthread_mutex_unlock(&pReader->lock);
 }
 
 /*********************************************************************//*!
@@ -227,6 +278,7 @@ static void OscFrdSimCycleCallback()
 			break;
 		case FRD_READER_TYPE_SEQUENCE:
 		case FRD_READER_TYPE_CONSTANT:
+		case FRD_READER_TYPE_RECORDING:
 			/* No operation necessary. */
 			break;
 		default:
@@ -330,32 +382,44 @@ OSC_ERR OscFrdCreateSequenceReader(void **phReaderHandle,
 }
 
 /*********************************************************************//*!
- * @brief Get the current file name of a sequence reader.
+ * @brief Get the file name of a sequence reader for a time step.
  * 
  * @param pReader Handle to the file sequence reader.
- * @param strCurName Current file name is written to this string.
+ * @param seqNr The time step.
+ * @param strName File name is written to this string.
  *//*********************************************************************/
-static void OscFrdSeqGetCurrentFileName(
+static void OscFrdSeqGetFileName(
 		const struct OSC_FRD_SEQUENCE_READER *pReader,
-		char strCurName[])
+		const uint32 seqNr,
+		char strName[])
 {
 	char        strFormat[16];
 	char        strSeq[16];
-	uint32      curSeqNr;
-	
-	/* Get the current time step from the simulation module. */
-	curSeqNr = OscSimGetCurTimeStep();
 	
 	/* Customize the format string then use it to stringify the
 	 * sequence number afterwards. ("%<x>u", where <x> is the number
 	 * of digits of the sequence number) */
 	sprintf(strFormat, "%%0%uu", pReader->seqNrDigits);
-	sprintf(strSeq, strFormat, curSeqNr);
+	sprintf(strSeq, strFormat, seqNr);
 
 	/* File name is prefix +  number + suffix */
-	strcpy(strCurName, pReader->strPrefix);
-	strcat(strCurName, strSeq);
-	strcat(strCurName, pReader->strSuffix);
+	strcpy(strName, pReader->strPrefix);
+	strcat(strName, strSeq);
+	strcat(strName, pReader->strSuffix);
+}
+
+/*********************************************************************//*!
+ * @brief Get the current file name of a sequence reader.
+ * 
+ * @param pReader Handle to the file sequence reader.
+ * @param strCurName Current file name is written to this string.
+ *//*********************************************************************/
+static void OscFrdSeqGetCurrentFileName(
+		const struct OSC_FRD_SEQUENCE_READER *pReader,
+		char strCurName[])
+{
+	/* Get the current time step from the simulation module. */
+	OscFrdSeqGetFileName(pReader, OscSimGetCurTimeStep(), strCurName);
 }
 
 /* ---------------------------- List reader -------------------------------*/
@@ -391,6 +455,7 @@ static OSC_ERR OscFrdParseListReader(FILE *pConfigF,
 	}
 	
 	strcpy(pReader->strFileList, strTemp);
+	pthread_mutex_init(&pReader->lock, NULL);
 	
 	return SUCCESS;
 }
@@ -432,6 +497,7 @@ OSC_ERR OscFrdCreateFileListReader(void **phReaderHandle,
 	
 	pReader->enType = FRD_READER_TYPE_LIST;
 	strcpy(pFLReader->strFileList, strFileList);
+	pthread_mutex_init(&pFLReader->lock, NULL);
 	*phReaderHandle = (void*)pReader;
 	
 	return SUCCESS;
@@ -444,10 +510,74 @@ OSC_ERR OscFrdCreateFileListReader(void **phReaderHandle,
  * @param strCurName Current file name is written to this string.
  *//*********************************************************************/
 static inline void OscFrdListGetCurrentFileName(
-		const struct OSC_FRD_FILELIST_READER *pReader,
+		struct OSC_FRD_FILELIST_READER *pReader,
 		char strCurName[])
 {
+	pthread_mutex_lock(&pReader->lock);
 	strcpy(strCurName, pReader->curFileName);
+	pthread_mutex_unlock(&pReader->lock);
+}
+
+/*********************************************************************//*!
+ * @brief Get a file name further down the list of a list reader.
+ * 
+ * Reads ahead in the file list and seeks back to where it was.
+ * 
+ * @param pReader Handle to the file list reader.
+ * @param stepsAhead How many file names to look ahead.
+ * @param strName File name is written to this string.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscFrdListGetFileNameAhead(
+		struct OSC_FRD_FILELIST_READER *pReader,
+		const uint16 stepsAhead,
+		char strName[])
+{
+	long        pos;
+	uint16      step;
+	OSC_ERR     err = SUCCESS;
+	
+	pthread_mutex_lock(&pReader->lock);
+	if(pReader->curFileName[0] == '\0')
+	{
+		/* The end of the list has already been reached. */
+		err = -EFRD_NO_MORE_FILE_NAMES;
+		goto exit_unlock;
+	}
+	if(stepsAhead == 0)
+	{
+		strcpy(strName, pReader->curFileName);
+		goto exit_unlock;
+	}
+	
+	pos = ftell(pReader->pFList);
+	if(unlikely(pos < 0))
+	{
+		err = -EFILE_ERROR;
+		goto exit_unlock;
+	}
+	
+	for(step = 0; step < stepsAhead; step++)
+	{
+		if(fscanf(pReader->pFList, "%[^\t\n]\n", strName) != 1)
+		{
+			err = -EFRD_NO_MORE_FILE_NAMES;
+			break;
+		}
+	}
+	
+	/* Leave the list where the next simulation cycle expects it. */
+	clearerr(pReader->pFList);
+	if(unlikely(fseek(pReader->pFList, pos, SEEK_SET) != 0))
+	{
+		OscLog(ERROR, "%s: Unable to seek back in file list! (%s)\n",
+				__func__, pReader->strFileList);
+		err = -EFILE_ERROR;
+	}
+	
+exit_unlock:
+	pthread_mutex_unlock(&pReader->lock);
+	return err;
 }
 
 /* -------------------------- Constant reader ------------------------------*/
@@ -525,6 +655,339 @@ static void OscFrdConstGetCurrentFileName(
 	strcpy(strCurName, pReader->strFN);
 }
 
+/* -------------------------- Recording reader -----------------------------*/
+/*********************************************************************//*!
+ * @brief Map a recording into memory and check its header and index.
+ * 
+ * @param pReader Reader object structure to complete.
+ * @param strRecording The file name of the recording.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscFrdMapRecording(struct OSC_FRD_RECORDING_READER *pReader,
+		const char strRecording[])
+{
+	const struct OSC_FRD_RECORDING_HEADER   *pHeader;
+	struct stat                             fileStat;
+	void                                    *pFile;
+	int                                     fd;
+	
+	if(unlikely(strlen(strRecording) >= MAX_PATH_LEN))
+	{
+		return -EINVALID_PARAMETER;
+	}
+	
+	fd = open(strRecording, O_RDONLY);
+	if(fd < 0)
+	{
+		OscLog(ERROR, "%s: Unable to open recording (%s)! Errno: %s\n",
+				__func__, strRecording, strerror(errno));
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+	if(fstat(fd, &fileStat) != 0 ||
+			(size_t)fileStat.st_size < sizeof(struct OSC_FRD_RECORDING_HEADER))
+	{
+		OscLog(ERROR, "%s: Invalid recording (%s)!\n",
+				__func__, strRecording);
+		close(fd);
+		return -EFRD_INVALID_RECORDING;
+	}
+	
+	pFile = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(pFile == MAP_FAILED)
+	{
+		OscLog(ERROR, "%s: Unable to map recording (%s)! Errno: %s\n",
+				__func__, strRecording, strerror(errno));
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+	
+	/* The frames are checked when they are accessed, the header and the
+	 * index here. */
+	pHeader = (const struct OSC_FRD_RECORDING_HEADER*)pFile;
+	if(unlikely(memcmp(pHeader->magic, OSC_FRD_RECORDING_MAGIC,
+			sizeof(pHeader->magic)) != 0 ||
+			pHeader->version != OSC_FRD_RECORDING_VERSION ||
+			pHeader->entrySize < sizeof(struct OSC_FRD_RECORDING_ENTRY) ||
+			pHeader->entrySize % sizeof(uint64_t) != 0 ||
+			pHeader->indexOffset < pHeader->headerSize ||
+			pHeader->indexOffset % sizeof(uint64_t) != 0 ||
+			pHeader->indexOffset > (uint64_t)fileStat.st_size ||
+			((uint64_t)fileStat.st_size - pHeader->indexOffset) /
+				pHeader->entrySize < pHeader->nrOfFrames))
+	{
+		OscLog(ERROR, "%s: Invalid or unfinished recording (%s)!\n",
+				__func__, strRecording);
+		munmap(pFile, fileStat.st_size);
+		return -EFRD_INVALID_RECORDING;
+	}
+	
+	strcpy(pReader->strRecording, strRecording);
+	pReader->pFile = (const uint8*)pFile;
+	pReader->fileSize = fileStat.st_size;
+	pReader->pIndex = (const struct OSC_FRD_RECORDING_ENTRY*)
+			(pReader->pFile + pHeader->indexOffset);
+	pReader->nrOfFrames = pHeader->nrOfFrames;
+	pReader->entrySize = pHeader->entrySize;
+	
+	return SUCCESS;
+}
+
+/*********************************************************************//*!
+ * @brief Parses in the parameters of a recording reader.
+ * 
+ * @param pConfigF Open handle to the frd config file advanced to the
+ * position where the options of the recording reader are located.
+ * @param pReader Reader object structure to complete with the information
+ * in the file.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+static OSC_ERR OscFrdParseRecordingReader(FILE *pConfigF,
+		struct OSC_FRD_RECORDING_READER * pReader)
+{
+	char                        strTemp[1024];
+	int                         assigned;
+	
+	assigned = fscanf(pConfigF, "RECORDING = %s\n",
+			strTemp);
+	if(unlikely(assigned != 1))
+	{
+		return -EFRD_PARSING_FAILURE;
+	}
+	
+	return OscFrdMapRecording(pReader, strTemp);
+}
+
+OSC_ERR OscFrdCreateRecordingReader(void **phReaderHandle,
+		const char strRecording[])
+{
+	struct OSC_FRD_READER           *pReader;
+	OSC_ERR                         err;
+	
+	/* Input validation. */
+	if(unlikely(phReaderHandle == NULL || strRecording == NULL ||
+			strRecording[0] == '\0'))
+	{
+		OscLog(ERROR, "%s(0x%x, %s): Invalid parameter!\n",
+				__func__, (uintptr_t)phReaderHandle, strRecording);
+		return -EINVALID_PARAMETER;
+	}
+	
+	if(unlikely(frd.nrOfReaders >= MAX_NR_READERS))
+	{
+		OscLog(ERROR, "%s: Maximum number of readers reached!\n",
+				__func__);
+		return -EFRD_MAX_NR_READERS_REACHED;
+	}
+	
+	/* Create the recording reader. */
+	pReader = &frd.rd[frd.nrOfReaders];
+	err = OscFrdMapRecording(&pReader->reader.rec, strRecording);
+	if(err != SUCCESS)
+	{
+		return err;
+	}
+	frd.nrOfReaders++;
+	
+	pReader->enType = FRD_READER_TYPE_RECORDING;
+	*phReaderHandle = (void*)pReader;
+	
+	return SUCCESS;
+}
+
+OSC_ERR OscFrdGetRecordedFrame(const void *hReaderHandle,
+		const uint32 frameNr,
+		const uint8 **ppFrame,
+		const struct OSC_FRD_FRAME_INFO **ppInfo)
+{
+	const struct OSC_FRD_READER             *pReader;
+	const struct OSC_FRD_RECORDING_READER   *pRecReader;
+	const struct OSC_FRD_RECORDING_ENTRY    *pEntry;
+	
+	/* Input validation. */
+	if(unlikely((hReaderHandle == NULL) || (ppFrame == NULL) ||
+			(ppInfo == NULL)))
+	{
+		OscLog(ERROR, "%s(0x%x, %u, 0x%x, 0x%x): Invalid parameter!\n",
+				__func__, hReaderHandle, frameNr, ppFrame, ppInfo);
+		return -EINVALID_PARAMETER;
+	}
+	pReader = (const struct OSC_FRD_READER*)hReaderHandle;
+	if(pReader->enType != FRD_READER_TYPE_RECORDING)
+	{
+		return -EUNSUPPORTED;
+	}
+	pRecReader = &pReader->reader.rec;
+	
+	if(frameNr >= pRecReader->nrOfFrames)
+	{
+		OscLog(WARN, "%s: End of recording! (%s)\n",
+				__func__, pRecReader->strRecording);
+		return -EFRD_NO_MORE_FILE_NAMES;
+	}
+	
+	pEntry = (const struct OSC_FRD_RECORDING_ENTRY*)
+			((const uint8*)pRecReader->pIndex +
+			(size_t)frameNr*pRecReader->entrySize);
+	if(unlikely(pEntry->offset > pRecReader->fileSize ||
+			pRecReader->fileSize - pEntry->offset <
+			(uint64_t)pEntry->info.width*pEntry->info.height))
+	{
+		OscLog(ERROR, "%s: Frame %u outside of the recording! (%s)\n",
+				__func__, frameNr, pRecReader->strRecording);
+		return -EFRD_INVALID_RECORDING;
+	}
+	
+	*ppFrame = pRecReader->pFile + pEntry->offset;
+	*ppInfo = &pEntry->info;
+	return SUCCESS;
+}
+
+/* ------------------------------ Recording --------------------------------*/
+OSC_ERR OscFrdCreateRecording(void **phRecording,
+		const char strRecording[])
+{
+	struct OSC_FRD_RECORDING    *pRec;
+	
+	/* Input validation. */
+	if(unlikely(phRecording == NULL || strRecording == NULL ||
+			strRecording[0] == '\0'))
+	{
+		OscLog(ERROR, "%s(0x%x, %s): Invalid parameter!\n",
+				__func__, (uintptr_t)phRecording, strRecording);
+		return -EINVALID_PARAMETER;
+	}
+	
+	pRec = (struct OSC_FRD_RECORDING*)malloc(sizeof(struct OSC_FRD_RECORDING));
+	if(pRec == NULL)
+	{
+		OscLog(ERROR, "%s: Memory allocation error!\n", __func__);
+		return -EOUT_OF_MEMORY;
+	}
+	memset(pRec, 0, sizeof(struct OSC_FRD_RECORDING));
+	
+	pRec->pFile = fopen(strRecording, "wb");
+	if(pRec->pFile == NULL)
+	{
+		OscLog(ERROR, "%s: Unable to create recording (%s)! Errno: %s\n",
+				__func__, strRecording, strerror(errno));
+		free(pRec);
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+	
+	/* Without an index the recording is recognized as unfinished until
+	 * it is closed. */
+	memcpy(pRec->header.magic, OSC_FRD_RECORDING_MAGIC,
+			sizeof(pRec->header.magic));
+	pRec->header.version = OSC_FRD_RECORDING_VERSION;
+	pRec->header.headerSize = sizeof(struct OSC_FRD_RECORDING_HEADER);
+	pRec->header.entrySize = sizeof(struct OSC_FRD_RECORDING_ENTRY);
+	if(fwrite(&pRec->header, sizeof(pRec->header), 1, pRec->pFile) != 1)
+	{
+		OscLog(ERROR, "%s: Unable to write to recording (%s)!\n",
+				__func__, strRecording);
+		fclose(pRec->pFile);
+		free(pRec);
+		return -EFILE_ERROR;
+	}
+	pRec->offset = sizeof(pRec->header);
+	
+	*phRecording = pRec;
+	return SUCCESS;
+}
+
+OSC_ERR OscFrdRecordFrame(void *hRecording,
+		const uint8 *pFrame,
+		const struct OSC_FRD_FRAME_INFO *pInfo)
+{
+	struct OSC_FRD_RECORDING    *pRec = (struct OSC_FRD_RECORDING*)hRecording;
+	struct OSC_FRD_RECORDING_ENTRY *pIndex;
+	size_t                      frameSize;
+	uint32                      indexSize;
+	
+	/* Input validation. */
+	if(unlikely(pRec == NULL || pFrame == NULL || pInfo == NULL))
+	{
+		OscLog(ERROR, "%s(0x%x, 0x%x, 0x%x): Invalid parameter!\n",
+				__func__, hRecording, pFrame, pInfo);
+		return -EINVALID_PARAMETER;
+	}
+	
+	if(pRec->header.nrOfFrames == pRec->indexSize)
+	{
+		/* Grow the index. */
+		indexSize = pRec->indexSize == 0 ? 256 : 2*pRec->indexSize;
+		pIndex = (struct OSC_FRD_RECORDING_ENTRY*)realloc(pRec->pIndex,
+				indexSize*sizeof(struct OSC_FRD_RECORDING_ENTRY));
+		if(pIndex == NULL)
+		{
+			OscLog(ERROR, "%s: Memory allocation error!\n", __func__);
+			return -EOUT_OF_MEMORY;
+		}
+		pRec->pIndex = pIndex;
+		pRec->indexSize = indexSize;
+	}
+	
+	frameSize = (size_t)pInfo->width*pInfo->height;
+	if(fwrite(pFrame, 1, frameSize, pRec->pFile) != frameSize)
+	{
+		OscLog(ERROR, "%s: Unable to write to recording!\n", __func__);
+		/* Overwrite the incomplete frame with the next one. */
+		fseeko(pRec->pFile, pRec->offset, SEEK_SET);
+		return -EFILE_ERROR;
+	}
+	
+	pIndex = &pRec->pIndex[pRec->header.nrOfFrames];
+	memset(pIndex, 0, sizeof(struct OSC_FRD_RECORDING_ENTRY));
+	pIndex->offset = pRec->offset;
+	pIndex->info = *pInfo;
+	pRec->header.nrOfFrames++;
+	pRec->offset += frameSize;
+	
+	return SUCCESS;
+}
+
+OSC_ERR OscFrdCloseRecording(void *hRecording)
+{
+	struct OSC_FRD_RECORDING    *pRec = (struct OSC_FRD_RECORDING*)hRecording;
+	static const uint8          padding[sizeof(uint64_t)];
+	uint32                      padLen;
+	OSC_ERR                     err = SUCCESS;
+	
+	/* Input validation. */
+	if(unlikely(pRec == NULL))
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+	
+	/* Append the index, aligned so it can be accessed in place, and
+	 * complete the header. */
+	padLen = (sizeof(uint64_t) - pRec->offset % sizeof(uint64_t)) %
+			sizeof(uint64_t);
+	pRec->header.indexOffset = pRec->offset + padLen;
+	if(fwrite(padding, 1, padLen, pRec->pFile) != padLen ||
+			fwrite(pRec->pIndex, sizeof(struct OSC_FRD_RECORDING_ENTRY),
+				pRec->header.nrOfFrames, pRec->pFile) !=
+				pRec->header.nrOfFrames ||
+			fseeko(pRec->pFile, 0, SEEK_SET) != 0 ||
+			fwrite(&pRec->header, sizeof(pRec->header), 1, pRec->pFile) != 1)
+	{
+		OscLog(ERROR, "%s: Unable to write the index of the recording!\n",
+				__func__);
+		err = -EFILE_ERROR;
+	}
+	
+	if(fclose(pRec->pFile) != 0 && err == SUCCESS)
+	{
+		OscLog(ERROR, "%s: Unable to write the recording!\n", __func__);
+		err = -EFILE_ERROR;
+	}
+	free(pRec->pIndex);
+	free(pRec);
+	
+	return err;
+}
+
 OSC_ERR OscFrdCreateReader(void ** phReaderHandle,
 		const char strReaderConfigFile[])
 {
@@ -608,6 +1071,18 @@ OSC_ERR OscFrdCreateReader(void ** phReaderHandle,
 			goto exit_fail;
 		}
 		pReader->enType = FRD_READER_TYPE_CONSTANT;
+	} else if(strcmp(strTemp, "FRD_RECORDING_READER") == 0)
+	{
+		/* Recording Reader. */
+		err = OscFrdParseRecordingReader(pConfigF,
+				&pReader->reader.rec);
+		if(err != SUCCESS)
+		{
+			OscLog(ERROR, "%s: Error parsing recording reader config"
+					"(%d)!\n", __func__, err);
+			goto exit_fail;
+		}
+		pReader->enType = FRD_READER_TYPE_RECORDING;
 	}
 				
 	/* Success. Return the handle*/
@@ -644,6 +1119,47 @@ OSC_ERR OscFrdGetCurrentFileName(const void *hReaderHandle,
 	case FRD_READER_TYPE_CONSTANT:
 		OscFrdConstGetCurrentFileName(&pReader->reader.constant, strCurName);
 		break;
+	case FRD_READER_TYPE_RECORDING:
+		strcpy(strCurName, pReader->reader.rec.strRecording);
+		break;
+	default:
+		OscLog(ERROR, "%s: Unsupported reader type configured (%d)!\n",
+				__func__, pReader->enType);
+		return -EFRD_INVALID_VALUES_CONFIGURED;
+	}
+	
+	return SUCCESS;
+}
+
+OSC_ERR OscFrdGetFileNameAhead(const void *hReaderHandle,
+		const uint16 stepsAhead, char strName[])
+{
+	struct OSC_FRD_READER *pReader;
+	
+	/* Input validation. */
+	if(unlikely((hReaderHandle == NULL) || (strName == NULL)))
+	{
+		OscLog(ERROR, "%s(0x%x, %u, 0x%x): Invalid parameter!\n",
+				__func__, hReaderHandle, stepsAhead, strName);
+		return -EINVALID_PARAMETER;
+	}
+	pReader = (struct OSC_FRD_READER*)hReaderHandle;
+	
+	switch(pReader->enType)
+	{
+	case FRD_READER_TYPE_LIST:
+		return OscFrdListGetFileNameAhead(&pReader->reader.list,
+				stepsAhead, strName);
+	case FRD_READER_TYPE_SEQUENCE:
+		OscFrdSeqGetFileName(&pReader->reader.seq,
+				OscSimGetCurTimeStep() + stepsAhead, strName);
+		break;
+	case FRD_READER_TYPE_CONSTANT:
+		OscFrdConstGetCurrentFileName(&pReader->reader.constant, strName);
+		break;
+	case FRD_READER_TYPE_RECORDING:
+		strcpy(strName, pReader->reader.rec.strRecording);
+		break;
 	default:
 		OscLog(ERROR, "%s: Unsupported reader type configured (%d)!\n",
 				__func__, pReader->enType);
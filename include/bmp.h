@@ -48,7 +48,9 @@ enum EnOscPictureType {
 	OSC_PICTURE_HUE,
 	OSC_PICTURE_BGR_24,
 	OSC_PICTURE_RGB_24,
-	OSC_PICTURE_BINARY
+	OSC_PICTURE_BINARY,
+	OSC_PICTURE_BINARY_PACKED,
+	OSC_PICTURE_HSL_24
 };
 
 /*! @brief Structure representing an 8-bit picture */
@@ -74,12 +76,13 @@ struct OSC_PICTURE {
  * allocated. When specifying the destination address, the expected
  * image format must also be specified to avoid overflow.
  * If the picture in the file has the row order reversed, this is
- * corrected. The returned row order is top to bottom.
+ * corrected while the pixels are copied from the file, which is mapped
+ * into memory. The returned row order is top to bottom.
  * 
  * The data in a RGB color BMP is stored with the pixel order BGR, so
  * that is the format in which the data is returned.
  * 
- * @see OscBmpReverseRowOrder
+ * @see OscBmpMap
  * 
  * @param pPic Pointer to an uninitialized or fully initialized OSC
  * picture (Pixel order BGR).
@@ -88,6 +91,55 @@ struct OSC_PICTURE {
  *//*********************************************************************/
 OSC_ERR OscBmpRead(struct OSC_PICTURE *pPic, const char *strFileName);
 
+/*********************************************************************//*!
+ * @brief Read a region of a BMP image
+ * 
+ * Same as OscBmpRead() but only the pixels of the specified rectangle
+ * are read, into memory supplied by the caller. Only the part of the
+ * file containing the region is read from disk.
+ * 
+ * @param pPic Pointer to an OSC picture with the data and the size of
+ * the region. The type is filled in from the file.
+ * @param strFileName The file name of the picture to read.
+ * @param colOff The column (x) offset of the region.
+ * @param rowOff The row (y) offset of the region.
+ * @param bufferSize The size of the memory at the data of the picture.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscBmpReadRegion(struct OSC_PICTURE *pPic, const char *strFileName,
+		const uint16 colOff, const uint16 rowOff, const uint32 bufferSize);
+
+/*********************************************************************//*!
+ * @brief Map a BMP image into memory
+ * 
+ * Same as OscBmpRead() but without copying the pixels where possible.
+ * If the rows are stored top to bottom without padding, the data of the
+ * picture points directly into the mapped file. Otherwise the pixels are
+ * copied once into memory allocated here, reversing the row order. The
+ * pixels may be modified, this does not change the file. The data of the
+ * picture stays valid until OscBmpUnmap() is called.
+ * 
+ * The caller may specify the expected image format but not the memory
+ * location of the picture.
+ * 
+ * @param pPic Pointer to an uninitialized OSC picture or one with the
+ * expected size but no data.
+ * @param strFileName The file name of the picture to read.
+ * @param phBmp The handle to release the picture is returned over this
+ * pointer.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscBmpMap(struct OSC_PICTURE *pPic, const char *strFileName,
+		void **phBmp);
+
+/*********************************************************************//*!
+ * @brief Release a picture returned by OscBmpMap()
+ * 
+ * @param hBmp Handle returned by OscBmpMap().
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscBmpUnmap(void *hBmp);
+
 /*********************************************************************//*!
  * @brief Write a picture as a RGB BMP file
  * 
@@ -94,6 +94,133 @@ enum EnBayerOrder {
 	ROW_GRGR = 3
 };
 
+/*! @brief A picture of the frame ring and when it was captured.
+ * @see OscCamGetFrame */
+struct OSC_CAM_FRAME
+{
+	/*! @brief The ID of the frame buffer holding the picture. */
+	uint8 fbID;
+	/*! @brief The address of the picture. */
+	uint8 *pData;
+	/*! @brief Sequence number of the capture. Gaps are pictures dropped
+	 * before they could be acquired. */
+	uint32 seqNr;
+	/*! @brief Time the capture completed in microseconds of the
+	 * monotonic clock. */
+	uint64_t timestamp;
+};
+
+/*! @brief Description of a captured picture, see OscCamGetFrameInfo().
+ * 
+ * Times are in microseconds of the monotonic clock. Host only: The
+ * times are derived from the simulation time step at 60 frames per
+ * second or taken from the recording. */
+struct OSC_CAM_FRAME_INFO
+{
+	/*! @brief Number of the capture, counting every capture set up. */
+	uint32 seqNr;
+	/*! @brief Time the exposure started. */
+	uint64_t exposureStart;
+	/*! @brief Time the exposure ended. Target: Estimated from the time
+	 * the transfer completed and the readout time of the window. */
+	uint64_t exposureEnd;
+	/*! @brief Time the picture was handed to the application. */
+	uint64_t readTime;
+	/*! @brief The area of interest the picture was captured with. */
+	uint16 col_off, row_off, width, height;
+	/*! @brief The exposure time in microseconds. */
+	uint32 exposureTime;
+	/*! @brief The black level offset, see OscCamSetBlackLevelOffset(). */
+	uint16 blackLevel;
+};
+
+/*! @brief Number of bins of the luminance histogram of the auto
+ * exposure. */
+#define OSC_CAM_AEC_HIST_BINS 64
+
+/*! @brief Configuration of the auto exposure, see
+ * OscCamSetAutoExposure(). */
+struct OSC_CAM_AEC_CONFIG
+{
+	/*! @brief The mean luminance to reach, 1 to 254. */
+	uint8 targetBrightness;
+	/*! @brief Deviation of the mean luminance from the target that is
+	 * accepted as converged. */
+	uint8 tolerance;
+	/*! @brief Percentage of the exposure correction applied per update,
+	 * 1 to 100. Lower values give a slower but steadier loop. */
+	uint8 damping;
+	/*! @brief The shutter is updated every that many pictures. At least
+	 * 2 leaves the sensor the time to apply the previous update. */
+	uint16 cadence;
+	/*! @brief Only every that many 2x2 cells of the picture are
+	 * sampled in both directions. */
+	uint16 subsample;
+	/*! @brief Limits of the exposure time in microseconds. */
+	uint32 minExposure, maxExposure;
+};
+
+/*! @brief State of the auto exposure, see OscCamGetAutoExposureStats(). */
+struct OSC_CAM_AEC_STATS
+{
+	/*! @brief Number of pictures read since the auto exposure was
+	 * enabled. */
+	uint32 nFrames;
+	/*! @brief Number of pictures analysed. */
+	uint32 nAnalysed;
+	/*! @brief Number of times the shutter was changed. */
+	uint32 nUpdates;
+	/*! @brief The current exposure time in microseconds. */
+	uint32 exposure;
+	/*! @brief Mean luminance of the last analysed picture. */
+	uint8 mean;
+	/*! @brief Mean luminance minus the target of the last analysed
+	 * picture. */
+	int16 error;
+	/*! @brief Whether the last analysed picture was within the
+	 * tolerance. */
+	bool bConverged;
+	/*! @brief Number of pictures it took to converge after the auto
+	 * exposure was enabled or the last time it lost convergence. 0 if
+	 * it has not converged yet. */
+	uint32 framesToConverge;
+	/*! @brief Number of samples of the last analysed picture. */
+	uint32 nSamples;
+	/*! @brief Number of those in the brightest bin. */
+	uint32 nSaturated;
+	/*! @brief Luminance histogram of the last analysed picture. */
+	uint32 histogram[OSC_CAM_AEC_HIST_BINS];
+};
+
+/*! @brief Calibration tables of the built-in correction of the sensor
+ * defects, see OscCamSetCorrection().
+ * 
+ * The per-pixel tables cover the whole sensor row by row, with
+ * OSC_CAM_MAX_IMAGE_WIDTH * OSC_CAM_MAX_IMAGE_HEIGHT entries. A
+ * corrected pixel is (raw - offset) * gain / 128, saturated to 0..255.
+ * Either table may be NULL to skip that part of the correction. */
+struct OSC_CAM_CORRECTION
+{
+	/*! @brief Fixed pattern noise: Dark offset subtracted from every
+	 * pixel. */
+	const uint8 *pOffset;
+	/*! @brief Photo response non-uniformity: Gain of every pixel in
+	 * units of 1/128. */
+	const uint8 *pGain;
+	/*! @brief Positions of the hot pixels as row *
+	 * OSC_CAM_MAX_IMAGE_WIDTH + column, in ascending order. They are
+	 * replaced by the mean of the nearest pixels of the same color in
+	 * the row. */
+	const uint32 *pHotPixels;
+	/*! @brief The number of hot pixels. */
+	uint32 nHotPixels;
+};
+
+/*! @brief Function called with every picture captured by the capture
+ * stream, see OscCamStartStreaming(). */
+typedef void (*OscCamFrameCallback)(const struct OSC_CAM_FRAME *pFrame,
+		void *pUserData);
+
 /*========================== API functions =============================*/
 
 /*********************************************************************//*!
@@ -113,6 +240,28 @@ enum EnBayerOrder {
  *//*********************************************************************/
 OSC_ERR OscCamSetFileNameReader(void* hReaderHandle);
 
+/*********************************************************************//*!
+ * @brief Host only: Configure the cache of decoded test images.
+ * 
+ * Host only:
+ * The host implementation keeps the last test images read in a cache,
+ * so a picture used repeatedly, e.g. by a constant file name reader, is
+ * only read from disk again if the file has been modified. A background
+ * thread reads the test images of the next time steps ahead of the
+ * simulation. The cache is enabled by default with 8 frames, 4 of which
+ * are loaded ahead. Configuring the cache empties it.
+ * 
+ * Target: No effect
+ * 
+ * @param nrOfFrames The number of full size pictures to keep, at most
+ * 64. 0 disables the cache.
+ * @param prefetchDepth The number of time steps to load ahead, 0 for
+ * none. Must be smaller than nrOfFrames.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscCamSetFrameCache(const uint16 nrOfFrames,
+		const uint16 prefetchDepth);
+
 /*********************************************************************//*!
  * @brief Set the rectangle read out from the CMOS sensor
  * 
@@ -260,6 +409,171 @@ OSC_ERR OscCamCreateMultiBuffer(const uint8 multiBufferDepth,
  *//*********************************************************************/
 OSC_ERR OscCamDeleteMultiBuffer();
 
+/*********************************************************************//*!
+ * @brief Configure multiple frame buffers to form a frame ring
+ * 
+ * A frame ring hands the pictures captured by one thread to any number
+ * of processing threads. The capturing thread calls
+ * OscCamCaptureToFrameRing() in a loop, the processing threads take the
+ * captured pictures with OscCamAcquireFrame() and give them back
+ * with OscCamReleaseFrame(). A picture stays untouched while it is
+ * held. If the processing threads do not keep up, the oldest picture
+ * not acquired yet is overwritten and counted as dropped instead of
+ * stalling the capture. No locks are taken on either side.
+ * 
+ * The specified frame buffers must first be configured by calls
+ * to OscCamSetFrameBuffer, each may only be given once. They cannot be
+ * deleted while they are part of the ring.
+ * @see OscCamSetFrameBuffer
+ * @see OscCamDeleteFrameRing
+ * 
+ * @param depth The number of frame buffers in the ring.
+ * @param bufferIDs Array of the buffer IDs forming the ring.
+ * @return SUCCESS, -EDEVICE_BUSY if a stream is running or another
+ * appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamCreateFrameRing(const uint8 depth, const uint8 bufferIDs[]);
+
+/*********************************************************************//*!
+ * @brief Delete a previously configured frame ring
+ * @see OscCamCreateFrameRing
+ * 
+ * @return SUCCESS or -ECANNOT_DELETE if a picture is still held or a
+ * stream is running.
+ *//*********************************************************************/
+OSC_ERR OscCamDeleteFrameRing();
+
+/*********************************************************************//*!
+ * @brief Capture a picture into the frame ring
+ * 
+ * Sets up the capture to a frame buffer of the ring which is not held
+ * and reads the picture, see OscCamSetupCapture() and
+ * OscCamReadPicture(). Must only be called by one thread.
+ * @see OscCamCreateFrameRing
+ * 
+ * @param maxAge See OscCamReadPicture().
+ * @param timeout See OscCamReadPicture().
+ * @return SUCCESS, -EFRAME_BUFFER_BUSY if all pictures are held or an
+ * appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscCamCaptureToFrameRing(const uint16 maxAge, const uint16 timeout);
+
+/*********************************************************************//*!
+ * @brief Acquire the oldest picture captured into the frame ring
+ * 
+ * Does not block. The picture is held with one reference until it is
+ * released.
+ * @see OscCamReleaseFrame
+ * 
+ * @param pFbID The ID of the frame buffer of the picture is returned
+ * over this pointer.
+ * @param ppPic The address of the picture is returned over this
+ * pointer.
+ * @return SUCCESS, -ENO_MATCHING_PICTURE if no new picture has been
+ * captured or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscCamAcquireFrame(uint8 *pFbID, uint8 **ppPic);
+
+/*********************************************************************//*!
+ * @brief Add a reference to a held picture of the frame ring
+ * 
+ * Used to hand a picture to another thread, which releases it
+ * independently.
+ * 
+ * @param fbID The ID of the frame buffer of the picture.
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamRetainFrame(const uint8 fbID);
+
+/*********************************************************************//*!
+ * @brief Release a reference to a held picture of the frame ring
+ * 
+ * The frame buffer is reused for capturing after the last reference is
+ * released.
+ * 
+ * @param fbID The ID of the frame buffer of the picture.
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamReleaseFrame(const uint8 fbID);
+
+/*********************************************************************//*!
+ * @brief Get the sequence number and timestamp of a held picture of
+ * the frame ring
+ * 
+ * @param fbID The ID of the frame buffer of the picture.
+ * @param pFrame The description of the picture is returned over this
+ * pointer.
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamGetFrame(const uint8 fbID, struct OSC_CAM_FRAME *pFrame);
+
+/*********************************************************************//*!
+ * @brief Get the statistics of the frame ring
+ * 
+ * @param pCaptured The number of pictures captured is returned over
+ * this pointer.
+ * @param pDropped The number of pictures overwritten before being
+ * acquired is returned over this pointer.
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamGetFrameRingStats(uint32 *pCaptured, uint32 *pDropped);
+
+/*********************************************************************//*!
+ * @brief Capture continuously into the frame ring
+ * 
+ * Starts a thread calling OscCamCaptureToFrameRing() in a loop, so the
+ * next picture is exposed while the previous ones are processed. The
+ * application must not capture by itself while the stream runs.
+ * 
+ * If a callback is given it is called on a second thread with every
+ * captured picture in order. The picture is released when the callback
+ * returns unless it was retained with OscCamRetainFrame().
+ * Otherwise the application waits for the file descriptor of
+ * OscCamGetStreamingFd() to become readable and takes the pictures
+ * with OscCamAcquireFrame().
+ * 
+ * Host only: One picture is captured per simulation time step.
+ * 
+ * Applications using this on the target have to be linked with
+ * -lpthread. The stream must be stopped before the framework is
+ * destroyed.
+ * @see OscCamCreateFrameRing
+ * @see OscCamStopStreaming
+ * 
+ * @param pCallback The function to call with every picture or NULL.
+ * @param pUserData Passed to the callback.
+ * @param timeout See OscCamReadPicture().
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamStartStreaming(const OscCamFrameCallback pCallback,
+		void *pUserData, const uint16 timeout);
+
+/*********************************************************************//*!
+ * @brief Stop the capture stream
+ * 
+ * Waits for the running capture and callback to finish. Pictures still
+ * held stay held.
+ * @see OscCamStartStreaming
+ * 
+ * @return SUCCESS or an appropriate error code
+ *//*********************************************************************/
+OSC_ERR OscCamStopStreaming();
+
+/*********************************************************************//*!
+ * @brief Get a file descriptor signalling captured pictures
+ * 
+ * The descriptor becomes readable when a picture has been captured to
+ * the frame ring by a stream started without a callback. It can be used
+ * with poll() or select(). Reading from it (non-blocking) clears the
+ * signal; all ready pictures should then be taken with
+ * OscCamAcquireFrame() until it returns -ENO_MATCHING_PICTURE.
+ * @see OscCamStartStreaming
+ * 
+ * @return The file descriptor or -ENOT_INITIALIZED if no stream without
+ * a callback is running.
+ *//*********************************************************************/
+int OscCamGetStreamingFd();
+
 /*********************************************************************//*!
  * @brief Set one of the frame buffers used by the camera driver
  * 
@@ -356,14 +670,60 @@ OSC_ERR OscCamReadPicture(const uint8 fbID, uint8 ** ppPic, const uint16 maxAge,
  *//*********************************************************************/
 OSC_ERR OscCamReadLatestPicture(uint8 ** ppPic);
 
+/*********************************************************************//*!
+ * @brief Get the description of a picture returned by OscCamReadPicture
+ * 
+ * Works for pictures read from single frame buffers, the multi buffer
+ * and the frame ring. The description stays valid until the next
+ * capture to the same frame buffer is set up.
+ * 
+ * @param pPic The address of the picture as returned by
+ * OscCamReadPicture().
+ * @param pInfo The description of the picture is returned over this
+ * pointer.
+ * @return SUCCESS, -ENO_MATCHING_PICTURE if no picture has been read
+ * to that address or an appropriate error code otherwise.
+ *//*********************************************************************/
+OSC_ERR OscCamGetFrameInfo(const uint8 *pPic,
+		struct OSC_CAM_FRAME_INFO *pInfo);
+
+/*********************************************************************//*!
+ * @brief Enable the auto exposure
+ * 
+ * ReadPicture computes a subsampled luminance histogram of the raw
+ * picture, taking the mean of every sampled 2x2 Bayer cell, and updates
+ * the shutter with OscCamSetShutterWidth() to bring the mean luminance
+ * to the target. The automatic exposure and gain control of the sensor
+ * are disabled while the loop runs and set back to what they were when
+ * it is disabled with a NULL configuration.
+ * 
+ * Host only: Recorded frames are scaled by the ratio of the current
+ * exposure time to the recorded one while the auto exposure is enabled,
+ * so the loop can be run deterministically against a recording.
+ * @see OscCamGetAutoExposureStats
+ * 
+ * @param pConfig The configuration or NULL to disable the auto
+ * exposure.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscCamSetAutoExposure(const struct OSC_CAM_AEC_CONFIG *pConfig);
+
+/*********************************************************************//*!
+ * @brief Get the state of the auto exposure
+ * 
+ * @param pStats The state is returned over this pointer.
+ * @return SUCCESS or -ENOT_INITIALIZED if the auto exposure is not
+ * enabled.
+ *//*********************************************************************/
+OSC_ERR OscCamGetAutoExposureStats(struct OSC_CAM_AEC_STATS *pStats);
+
 /*********************************************************************//*!
  * @brief Register a callback function for image correction
  * 
  * ReadPicture calls this registered function at the very end. Depending
  * on the configured noise removal methods (OscClbSetupCalibrate) the
- * image is corrected in place.
- * 
- * Host: No effect
+ * image is corrected in place. It is called after the built-in
+ * correction set with OscCamSetCorrection().
  * 
  * @param pCallback Pointer to the function to be called.
  * @return SUCCESS or an appropriate error code.
@@ -376,6 +736,22 @@ OSC_ERR OscCamRegisterCorrectionCallback(
 				const uint16 width,
 				const uint16 height));
 
+/*********************************************************************//*!
+ * @brief Set the calibration tables of the built-in correction
+ * 
+ * ReadPicture removes the fixed pattern noise, the photo response
+ * non-uniformity and the hot pixels from the pictures with a single
+ * pass over the captured window. On the host this is done while the
+ * window is copied out of the test image. The tables are not copied and
+ * must stay valid until the correction is changed or disabled.
+ * @see OscCamRegisterCorrectionCallback
+ * 
+ * @param pCorrection The calibration tables or NULL to disable the
+ * correction.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscCamSetCorrection(const struct OSC_CAM_CORRECTION *pCorrection);
+
 /*********************************************************************//*!
  * @brief Setup the camera to scene perspective relation
  * 
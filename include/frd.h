@@ -31,6 +31,14 @@
  * FileNameSeqNrDigits = 3
  * 
  * FileNameSuffix = .bmp
+ * 
+ * Readers are created and destroyed by the application thread, and a
+ * file list reader advances in the simulation cycle callback.
+ * OscFrdGetCurrentFileName() and OscFrdGetFileNameAhead() may also be
+ * called from other threads, e.g. the capture stream of the cam module;
+ * a file list reader serializes them with the simulation cycle by a
+ * mutex. The file name returned is that of the time step at the time of
+ * the call, which may be over as soon as the call returns.
  * 
 	************************************************************************/
 #ifndef FRD_PUB_H_
@@ -46,7 +54,64 @@ enum EnOscFrdErrors
 {
 	EFRD_PARSING_FAILURE = OSC_FRD_ERROR_OFFSET,
 	EFRD_MAX_NR_READERS_REACHED,
-	EFRD_INVALID_VALUES_CONFIGURED
+	EFRD_INVALID_VALUES_CONFIGURED,
+	EFRD_NO_MORE_FILE_NAMES,
+	EFRD_INVALID_RECORDING
+};
+
+/*! @brief The magic number at the start of a recording file. */
+#define OSC_FRD_RECORDING_MAGIC "OSCARREC"
+/*! @brief The version of the recording file format. */
+#define OSC_FRD_RECORDING_VERSION 1
+
+/*! @brief Information recorded with every frame of a recording. */
+struct OSC_FRD_FRAME_INFO
+{
+	/*! @brief Capture time in microseconds. */
+	uint64_t timestamp;
+	/*! @brief The area of interest of the frame on the sensor. */
+	uint16 col_off;
+	uint16 row_off;
+	uint16 width;
+	uint16 height;
+	/*! @brief Sensor registers at the time of the capture: the total
+	 * shutter width (0x0B) and the black level calibration value
+	 * (0x48). */
+	uint16 shutterWidth;
+	uint16 blackLevel;
+	/*! @brief The length of a sensor row in pixel clocks, which the
+	 * shutter width is counted in: the width of the window plus the
+	 * horizontal blanking (0x05), at least 660. 0 if not known, the
+	 * replay then assumes the current horizontal blanking. */
+	uint32 rowClks;
+};
+
+/*! @brief Header at the start of a recording file.
+ * 
+ * A recording consists of this header, the raw frames of one byte per
+ * pixel and the index, an array of OSC_FRD_RECORDING_ENTRY. The index
+ * is written when the recording is closed. All values are little
+ * endian. */
+struct OSC_FRD_RECORDING_HEADER
+{
+	char magic[8];
+	uint32 version;
+	/*! @brief Size of this header. */
+	uint32 headerSize;
+	/*! @brief Size of an entry of the index. */
+	uint32 entrySize;
+	uint32 nrOfFrames;
+	/*! @brief Position of the index in the file. */
+	uint64_t indexOffset;
+	uint8 reserved[32];
+};
+
+/*! @brief An entry of the index of a recording. */
+struct OSC_FRD_RECORDING_ENTRY
+{
+	/*! @brief Position of the frame in the file. */
+	uint64_t offset;
+	struct OSC_FRD_FRAME_INFO info;
 };
 
 /*====================== API functions =================================*/
@@ -72,8 +137,13 @@ enum EnOscFrdErrors
  * READER_TYPE = FRD_CONSTANT_READER
  * FILENAME = <FILE-NAME>
  * 
+ * The config file for a recording reader looks like this:
+ * READER_TYPE = FRD_RECORDING_READER
+ * RECORDING = <Path to recording>
+ * 
  * @see OscFrdCreateFileListReader
  * @see OscFrdCreateSequenceReader
+ * @see OscFrdCreateRecordingReader
  * 
  * @param phReaderHandle The handle to the reader is returned over
  * this pointer.
@@ -151,5 +221,101 @@ OSC_ERR OscFrdCreateConstantReader(void **phReaderHandle, const char strFN[]);
 OSC_ERR OscFrdGetCurrentFileName(const void *hReaderHandle,
 		char strCurName[]);
 
+/*********************************************************************//*!
+ * @brief Returns the file name of a time step after the current one.
+ * 
+ * This does not advance the reader; it lets a consumer load files before
+ * the simulation gets to them.
+ * 
+ * @param hReaderHandle Handle to the reader.
+ * @param stepsAhead By how many time steps to look ahead, 0 for the
+ * current file name.
+ * @param strName The file name is written into this string.
+ * @return SUCCESS, -EFRD_NO_MORE_FILE_NAMES if a file list ends before
+ * or an appropriate error code otherwise
+ * 
+ * A recording reader returns the file name of the recording.
+ *//*********************************************************************/
+OSC_ERR OscFrdGetFileNameAhead(const void *hReaderHandle,
+		const uint16 stepsAhead, char strName[]);
+
+
+/*********************************************************************//*!
+ * @brief Create a reader of a recording directly.
+ * 
+ * Instead of a file name per time step, this reader supplies the frame
+ * of a recording with the number of the time step. The recording is
+ * mapped into memory, so any frame can be accessed without reading the
+ * file.
+ * @see OscFrdCreateReader
+ * @see OscFrdGetRecordedFrame
+ * @see OscFrdCreateRecording
+ * 
+ * @param phReaderHandle The handle to the reader is returned over
+ * this pointer.
+ * @param strRecording The file name of the recording.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscFrdCreateRecordingReader(void **phReaderHandle,
+		const char strRecording[]);
+
+/*********************************************************************//*!
+ * @brief Get a frame of a recording.
+ * 
+ * The frame and its information stay valid until the framework is
+ * destroyed.
+ * 
+ * @param hReaderHandle Handle to the reader.
+ * @param frameNr The number of the frame, usually the current time step.
+ * @param ppFrame The address of the raw pixels, one byte per pixel, is
+ * returned over this pointer.
+ * @param ppInfo The information recorded with the frame is returned
+ * over this pointer.
+ * @return SUCCESS, -EUNSUPPORTED if the reader is not a recording
+ * reader, -EFRD_NO_MORE_FILE_NAMES if the recording is shorter or an
+ * appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscFrdGetRecordedFrame(const void *hReaderHandle,
+		const uint32 frameNr,
+		const uint8 **ppFrame,
+		const struct OSC_FRD_FRAME_INFO **ppInfo);
+
+/*********************************************************************//*!
+ * @brief Create a recording file.
+ * 
+ * Frames are appended to the recording with OscFrdRecordFrame(). The
+ * recording can be replayed on the host with a recording reader once
+ * it has been closed with OscFrdCloseRecording().
+ * 
+ * @param phRecording The handle to the recording is returned over this
+ * pointer.
+ * @param strRecording The file name of the recording.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscFrdCreateRecording(void **phRecording,
+		const char strRecording[]);
+
+/*********************************************************************//*!
+ * @brief Append a frame to a recording.
+ * 
+ * The information of the frame is to be filled in by the caller, e.g.
+ * with OscCamGetAreaOfInterest() and OscCamGetRegisterValue().
+ * 
+ * @param hRecording Handle to the recording.
+ * @param pFrame The raw frame of pInfo->width * pInfo->height bytes.
+ * @param pInfo The information recorded with the frame.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscFrdRecordFrame(void *hRecording,
+		const uint8 *pFrame,
+		const struct OSC_FRD_FRAME_INFO *pInfo);
+
+/*********************************************************************//*!
+ * @brief Write the index of a recording and close it.
+ * 
+ * @param hRecording Handle to the recording.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscFrdCloseRecording(void *hRecording);
 
 #endif /*FRD_PUB_H_*/
@@ -27,6 +27,34 @@
 
 extern struct OscModule OscModule_jpg;
 
+/*! @brief Implementations of the DCT and quantization of the JPEG encoder */
+enum EnOscJpgDctMode {
+	OSC_JPG_DCT_REFERENCE,	/*!< @brief The integer DCT used on the target, the default there */
+	OSC_JPG_DCT_FAST		/*!< @brief The AAN DCT with folded level shift and quantization scaling, vectorized where possible. Only on the host, where it is the default. */
+};
+
+/*! @brief Container formats of a JPEG stream, see OscJpgStreamOpen() */
+enum EnOscJpgStreamFormat {
+	OSC_JPG_STREAM_MULTIPART,	/*!< @brief Body of a multipart/x-mixed-replace response, parts separated by OSC_JPG_STREAM_BOUNDARY */
+	OSC_JPG_STREAM_AVI			/*!< @brief AVI file with one MJPG video stream, needs a seekable file */
+};
+
+/*! @brief Boundary between the frames of an OSC_JPG_STREAM_MULTIPART stream. */
+#define OSC_JPG_STREAM_BOUNDARY "OscarFrame"
+
+/*! @brief Statistics of a JPEG stream, see OscJpgStreamGetStats() */
+struct OSC_JPG_STREAM_STATS {
+	uint32 frames;				/*!< @brief Frames encoded and queued */
+	uint32 framesWritten;		/*!< @brief Frames written to the file */
+	uint32 droppedFrames;		/*!< @brief Frames dropped because the writer was behind */
+	uint32 lastEncodeTime;		/*!< @brief Encoding time of the last frame in microseconds */
+	uint32 maxEncodeTime;		/*!< @brief Longest encoding time of a frame in microseconds */
+	uint32 lastFrameSize;		/*!< @brief Size of the last JPEG image in bytes */
+	uint32 queuedBytes;			/*!< @brief Bytes of the output buffer waiting to be written */
+	uint64_t bytesWritten;		/*!< @brief Bytes written to the file, including container headers */
+	OSC_ERR writeError;			/*!< @brief SUCCESS or the error that stopped writing to the file */
+};
+
 /*====================== API functions =================================*/
 
 /*********************************************************************//*!
@@ -39,4 +67,202 @@ extern struct OscModule OscModule_jpg;
  *//*********************************************************************/
 uint8* OscJpgEncode(struct OSC_PICTURE *pic, uint8 *output_ptr, uint32 quality_factor);
 
+/*********************************************************************//*!
+ * @brief Create a JPEG encoder instance.
+ * 
+ * An encoder holds all the state needed to encode one picture at a time,
+ * so pictures can be encoded by several encoders concurrently, e.g. from
+ * different threads. The quantization tables of the last few quality
+ * factors used are kept by the encoder.
+ * 
+ * @see OscJpgEncodePicture
+ * @see OscJpgDestroyEncoder
+ * 
+ * @param phEncoder The handle to the encoder is returned over this pointer.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgCreateEncoder(void **phEncoder);
+
+/*********************************************************************//*!
+ * @brief Destroy a JPEG encoder instance created by OscJpgCreateEncoder().
+ * 
+ * @param hEncoder Handle of the encoder.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgDestroyEncoder(void *hEncoder);
+
+/*********************************************************************//*!
+ * @brief Let an encoder divide the picture into restart intervals.
+ * 
+ * With a restart interval, the MCUs of the picture are coded in groups
+ * that do not depend on each other, separated by RSTn markers. The
+ * groups can then be encoded by several threads, each into a private
+ * buffer, and the buffers are concatenated. The output is the same for
+ * any number of threads. Only one thread is used on the target.
+ * 
+ * @param hEncoder Handle of the encoder.
+ * @param restartInterval Number of MCUs per restart interval, 0 to
+ * encode without restart markers (the default).
+ * @param noOfThreads Number of threads, 0 for one per CPU. Must be 1
+ * without restart interval.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgSetRestartInterval(void *hEncoder, uint16 restartInterval, uint16 noOfThreads);
+
+/*********************************************************************//*!
+ * @brief Choose the chroma subsampling of the JPEG images encoded from BGR pictures.
+ * 
+ * The conversion to YCbCr and the subsampling are done while reading
+ * the MCUs, the picture is not modified. With 4:2:2 and 4:2:0, Cb and Cr
+ * are the means of 2 resp. 2x2 pixels. Pictures of the YUV types are
+ * encoded in their own format.
+ * 
+ * @param hEncoder Handle of the encoder.
+ * @param format OSC_PICTURE_YUV_444 (the default), OSC_PICTURE_YUV_422
+ * or OSC_PICTURE_YUV_420.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgSetChromaSubsampling(void *hEncoder, enum EnOscPictureType format);
+
+/*********************************************************************//*!
+ * @brief Choose the DCT implementation of an encoder.
+ * 
+ * The fast DCT keeps more fractional bits than the reference DCT, so
+ * its output differs, with a slightly higher PSNR at fine quantization.
+ * Choose OSC_JPG_DCT_REFERENCE on the host to get the same output as on
+ * the target.
+ * 
+ * @param hEncoder Handle of the encoder.
+ * @param mode The DCT implementation.
+ * @return SUCCESS or an appropriate error code otherwise, -EUNSUPPORTED
+ * for the fast DCT on the target.
+ *//*********************************************************************/
+OSC_ERR OscJpgSetDctMode(void *hEncoder, enum EnOscJpgDctMode mode);
+
+/*********************************************************************//*!
+ * @brief Encode a bitmap image to a JPEG file using an encoder instance
+ * 
+ * Same as OscJpgEncode() but the state is kept in the given encoder and
+ * errors are returned instead of terminating the program.
+ * 
+ * Supported are OSC_PICTURE_BGR_24 (see OscJpgSetChromaSubsampling())
+ * and the packed formats OSC_PICTURE_YUV_444 (Y Cb Cr per pixel),
+ * OSC_PICTURE_YUV_422 (Y0 Cb Y1 Cr per 2 pixels), OSC_PICTURE_YUV_420
+ * (Y00 Y01 Y10 Y11 Cb Cr per 2x2 pixels, see OscVisDebayerYUV420()) and
+ * OSC_PICTURE_YUV_400 (Y only).
+ * 
+ * @param hEncoder Handle of the encoder.
+ * @param pic Pointer to the image
+ * @param output_ptr Pointer to the memory where the JPEG output will be stored
+ * @param quality_factor 1024 means heavy compression
+ * @param pOutputEnd Returns the pointer to the end of the data in the JPEG output buffer
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgEncodePicture(void *hEncoder, const struct OSC_PICTURE *pic, uint8 *output_ptr, uint32 quality_factor, uint8 **pOutputEnd);
+
+/*********************************************************************//*!
+ * @brief Encode a bitmap image to a JPEG file into a buffer of limited size
+ * 
+ * Same as OscJpgEncodePicture() but nothing is written beyond the end
+ * of the buffer. If the JPEG file does not fit, -EBUFFER_TOO_SMALL is
+ * returned and the content of the buffer is undefined.
+ * 
+ * @param hEncoder Handle of the encoder.
+ * @param pic Pointer to the image
+ * @param pBuffer Pointer to the memory where the JPEG output will be stored
+ * @param bufferSize Size of the buffer in bytes.
+ * @param quality_factor 1024 means heavy compression
+ * @param pSize Returns the size of the JPEG file in bytes.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgEncodePictureToBuffer(void *hEncoder, const struct OSC_PICTURE *pic, uint8 *pBuffer, uint32 bufferSize, uint32 quality_factor, uint32 *pSize);
+
+/*********************************************************************//*!
+ * @brief Open a Motion-JPEG stream writing to a file.
+ * 
+ * Frames given to OscJpgStreamWriteFrame() are encoded into one output
+ * buffer allocated here, which is used as a ring. On the host a writer
+ * thread writes the encoded frames to the file, so encoding never waits
+ * for the disk. If the buffer is full, the frame is dropped. On the
+ * target the frames are written by the calling thread.
+ * 
+ * For OSC_JPG_STREAM_AVI the index is kept in memory, 16 bytes per
+ * frame, and written by OscJpgStreamClose(), which also completes the
+ * headers.
+ * 
+ * @see OscJpgStreamOpenFd
+ * @see OscJpgStreamClose
+ * 
+ * @param phStream The handle to the stream is returned over this pointer.
+ * @param strFileName Name of the file to create or truncate.
+ * @param format Container format of the stream.
+ * @param bufferSize Size of the output buffer in bytes, at least the size
+ * of an encoded frame.
+ * @param framesPerSecond Frame rate written to the AVI headers, not
+ * used otherwise.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgStreamOpen(void **phStream, const char *strFileName, enum EnOscJpgStreamFormat format, uint32 bufferSize, uint32 framesPerSecond);
+
+/*********************************************************************//*!
+ * @brief Open a Motion-JPEG stream writing to a file descriptor.
+ * 
+ * Same as OscJpgStreamOpen() but the stream is written to an open file,
+ * pipe or socket, starting at its current position. The file descriptor
+ * is not closed by OscJpgStreamClose(). OSC_JPG_STREAM_AVI needs a
+ * seekable file.
+ * 
+ * @param phStream The handle to the stream is returned over this pointer.
+ * @param fd File descriptor to write to.
+ * @param format Container format of the stream.
+ * @param bufferSize Size of the output buffer in bytes.
+ * @param framesPerSecond Frame rate written to the AVI headers.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgStreamOpenFd(void **phStream, int fd, enum EnOscJpgStreamFormat format, uint32 bufferSize, uint32 framesPerSecond);
+
+/*********************************************************************//*!
+ * @brief Get the encoder of a stream to change its settings.
+ * 
+ * The encoder must not be used to encode pictures itself.
+ * 
+ * @param hStream Handle of the stream.
+ * @param phEncoder The handle to the encoder is returned over this pointer.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgStreamGetEncoder(void *hStream, void **phEncoder);
+
+/*********************************************************************//*!
+ * @brief Encode a picture and append it to a stream.
+ * 
+ * The picture can be reused as soon as this function returns. All
+ * frames of an AVI stream must have the size of the first one.
+ * 
+ * @param hStream Handle of the stream.
+ * @param pic The picture, of a type supported by OscJpgEncodePicture().
+ * @param quality_factor 1024 means heavy compression
+ * @return SUCCESS, -EDEVICE_BUSY if the frame was dropped because the
+ * output buffer is full, -EBUFFER_TOO_SMALL if the frame does not fit
+ * into the empty output buffer, the error of writing the file if that
+ * failed or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgStreamWriteFrame(void *hStream, const struct OSC_PICTURE *pic, uint32 quality_factor);
+
+/*********************************************************************//*!
+ * @brief Get the statistics of a stream.
+ * 
+ * @param hStream Handle of the stream.
+ * @param pStats The statistics are copied to this structure.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscJpgStreamGetStats(void *hStream, struct OSC_JPG_STREAM_STATS *pStats);
+
+/*********************************************************************//*!
+ * @brief Write the queued frames and close a stream.
+ * 
+ * @param hStream Handle of the stream.
+ * @return SUCCESS or the error of writing the file.
+ *//*********************************************************************/
+OSC_ERR OscJpgStreamClose(void *hStream);
+
 #endif /*JPG_PUB_H_*/
@@ -43,12 +43,38 @@ struct OSC_VIS_STREL {
 };
 
 
+/*! @brief Shape of a flat structuring element used in grey-level mathematical morphology. */
+enum EnOscVisGreyStrelShape {
+	OSC_VIS_GREY_STREL_RECT,		/*!< @brief Rectangle of width x height pixels */
+	OSC_VIS_GREY_STREL_LINE_0,		/*!< @brief Horizontal line of width pixels */
+	OSC_VIS_GREY_STREL_LINE_45,		/*!< @brief Diagonal line of width pixels from bottom-left to top-right */
+	OSC_VIS_GREY_STREL_LINE_90,		/*!< @brief Vertical line of width pixels */
+	OSC_VIS_GREY_STREL_LINE_135		/*!< @brief Diagonal line of width pixels from top-left to bottom-right */
+};
+
+/*! @brief Structure representing a flat structuring element used in grey-level mathematical morphology.
+ * The origin is the center pixel, resp. the pixel left of/above the center for even sizes. */
+struct OSC_VIS_GREY_STREL {
+	enum EnOscVisGreyStrelShape shape;	/*!< @brief Shape of the structuring element */
+	uint16 width;						/*!< @brief Width of the rectangle or length of the line in pixels */
+	uint16 height;						/*!< @brief Height of the rectangle in pixels, ignored for lines */
+};
+
+/*! @brief Size in bytes of the temporary buffer of the grey-level morphology functions for a width x height
+ * image and a structuring element whose width and (for rectangles) height are at most strelSize. */
+#define OSC_VIS_GREY_MORPH_TEMP_SIZE(width, height, strelSize) \
+	(3 * ((uint32)((width) > (height) ? (width) : (height)) + 2 * (uint32)(strelSize)))
+
 /* Realizations of several structuring elements used in binary mathematical morphology (defined in 'morphology.c') */
 extern struct OSC_VIS_STREL DISK2;
 extern struct OSC_VIS_STREL DISK8;
 extern struct OSC_VIS_STREL DISK1;
 extern struct OSC_VIS_STREL DISK0;
 
+/*! @brief Number of 32-bit words per row of a packed binary image (OSC_PICTURE_BINARY_PACKED).
+ * Pixel x of a row is stored in bit (x % 32) of word (x / 32), unused bits of the last word are zero. */
+#define OSC_VIS_PACKED_WORDS_PER_ROW(width) (((width) + 31) >> 5)
+
 
 /* Datatypes needed by segmentation.c */
 #define MAX_NO_OF_RUNS 8192
@@ -76,7 +102,7 @@ struct OSC_VIS_REGIONS_RUN {
 struct OSC_VIS_REGIONS_OBJECT {
 	struct OSC_VIS_REGIONS_RUN *root;		/*!< @brief Pointer to the root run representing the object */
 	uint16 area;							/*!< @brief Property entry for object area */
-	uint16 perimeter;						/*!< @brief Property entry for object perimter (not implemented yet) */
+	uint16 perimeter;						/*!< @brief Property entry for object perimeter: number of pixel edges between the object and the background, saturated at 65535. Only filled by OscVisLabelBinarySet() with statistics, see OSC_VIS_REGION_STATS */
 	uint16 centroidX, centroidY;			/*!< @brief Property entry for object centroid pixel coordinates */
 	uint16 bboxTop, bboxBottom, bboxLeft, bboxRight; /*!< @brief Property entry for object bounding box coordinates */
 };
@@ -90,6 +116,37 @@ struct OSC_VIS_REGIONS {
 	struct OSC_VIS_REGIONS_OBJECT objects[MAX_NO_OF_OBJECTS];	/*!< @brief Array of the detected objects */
 };
 
+/*! @brief Statistics of an object (=region) accumulated during the connected components labeling. */
+struct OSC_VIS_REGION_STATS {
+	uint32 area;							/*!< @brief Number of pixels */
+	uint32 perimeter;						/*!< @brief Number of pixel edges between the object and the background */
+	float centroidX, centroidY;				/*!< @brief Centroid in sub-pixel coordinates */
+	uint16 bboxTop, bboxBottom, bboxLeft, bboxRight; /*!< @brief Bounding box, bboxBottom is exclusive as in OSC_VIS_REGIONS_OBJECT */
+	float mu20, mu02, mu11;					/*!< @brief Central second moments, normalized by the area */
+	float orientation;						/*!< @brief Angle of the major axis to the x axis in radians, in [-pi/2, pi/2] */
+	float eccentricity;						/*!< @brief Eccentricity of the ellipse with the same second moments, 0 for a circle */
+	uint8 meanIntensity;					/*!< @brief Mean value of the grey image under the object, 0 without grey image */
+};
+
+/*! @brief Structure representing the result of the connected components labeling with storage of variable capacity.
+ * Unlike OSC_VIS_REGIONS, the runs and objects are stored either in a caller-provided arena (see OscVisRegionSetInit())
+ * or on the heap, growing as needed (see OscVisRegionSetCreate()). The storage is reused for every labeled image. */
+struct OSC_VIS_REGION_SET {
+	uint32 noOfRuns;						/*!< @brief Number of stored runs */
+	uint32 noOfObjects;						/*!< @brief Number of detected objects/regions */
+	uint32 noOfRunsRequired;				/*!< @brief Number of runs in the last labeled image, larger than noOfRuns if the storage was exhausted */
+	uint32 maxNoOfRuns;						/*!< @brief Capacity of the run array */
+	uint32 maxNoOfObjects;					/*!< @brief Capacity of the object array */
+	struct OSC_VIS_REGIONS_RUN *runs;		/*!< @brief The array of all detected runs */
+	struct OSC_VIS_REGIONS_OBJECT *objects;	/*!< @brief Array of the detected objects */
+	bool isGrowable;						/*!< @brief The storage is allocated on the heap and grows as needed */
+	struct OSC_VIS_REGION_STATS *stats;		/*!< @brief Statistics of the objects, parallel to objects. NULL if no statistics are accumulated */
+	void *pAccus;							/*!< @brief Internal: Statistics accumulators, parallel to runs */
+	const struct OSC_PICTURE *pGreyImg;		/*!< @brief Optional grey image (OSC_PICTURE_GREYSCALE) of the same size for meanIntensity, may be NULL */
+	uint32 minArea;							/*!< @brief Objects with fewer pixels are dropped while labeling, 0 to keep all. Needs statistics */
+	uint32 maxArea;							/*!< @brief Objects with more pixels are dropped while labeling, 0 to keep all. Needs statistics */
+};
+
 /* Datatypes needed by filters.c */
 /*! @brief Structure representing a filter kernel used in the generic 2D filter. */
 struct OSC_VIS_FILTER_KERNEL {	
@@ -149,6 +206,121 @@ OSC_ERR OscVisDebayer(const uint8* pRaw,
 		const enum EnBayerOrder enBayerOrderFirstRow,
 		uint8 *const pOut);
 
+/*! @brief Maximum number of threads of OscVisDebayerParallel(). */
+#define OSC_VIS_DEBAYER_MAX_THREADS 64
+
+/*********************************************************************//*!
+ * @brief Convert a raw bayer image to BGR using several threads.
+ *
+ * Same as OscVisDebayer() with a bit-identical result, but the inner rows
+ * are split into bands of bandHeight rows, which are processed by a pool
+ * of noOfThreads threads. The green and the red/blue interpolation are run
+ * one after the other, as the latter needs the green values of the
+ * neighboring rows. The threads are started at the first call and kept
+ * until the vis module is destroyed. While they work for another caller,
+ * the image is debayered on the calling thread.
+ *
+ * On the target, the image is debayered on the calling thread.
+ *
+ * @param pRaw Pointer to the raw input picture of size width x height.
+ * @param width Width of the input and output image.
+ * @param height Height of the input and output image.
+ * @param enBayerOrderFirstRow The order of the bayer pattern colors
+ * in the first row of the image to be debayered.
+ * @param pOut Pointer to the BGR output image.
+ * @param noOfThreads Number of threads including the calling one, at most
+ * OSC_VIS_DEBAYER_MAX_THREADS, 0 for one per online CPU.
+ * @param bandHeight Number of rows per band, 0 for a default.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscVisDebayerParallel(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		const enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pOut,
+		uint16 noOfThreads,
+		uint16 bandHeight);
+
+/*! @brief Number of rows debayered at a time by the fused pipelines OscVisDebayerGrey(), OscVisDebayerBW() and OscVisDebayerYUV420(). */
+#define OSC_VIS_DEBAYER_STRIP_HEIGHT 16
+/*! @brief Size in bytes of the temporary buffer of the fused debayering pipelines. It holds a strip of BGR rows. */
+#define OSC_VIS_DEBAYER_PIPELINE_TEMP_SIZE(width) ((OSC_VIS_DEBAYER_STRIP_HEIGHT + 3) * 3 * (uint32)(width))
+
+/*********************************************************************//*!
+ * @brief Convert a raw bayer image to a greyscale image in one pass.
+ *
+ * Gives the same result as OscVisDebayer() followed by OscVisBGR2Grey(),
+ * but debayers a strip of a few rows at a time into a small temporary
+ * buffer and converts it right away. No full size BGR image is written.
+ *
+ * @param pRaw Pointer to the raw input picture of size width x height.
+ * @param width Width of the input and output image.
+ * @param height Height of the input and output image.
+ * @param enBayerOrderFirstRow The order of the bayer pattern colors
+ * in the first row of the image to be debayered.
+ * @param pTemp Temporary buffer of OSC_VIS_DEBAYER_PIPELINE_TEMP_SIZE(width) bytes.
+ * @param pOut Pointer to the greyscale output image.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscVisDebayerGrey(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		const enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		uint8 *const pOut);
+
+/*********************************************************************//*!
+ * @brief Convert a raw bayer image to a binary image in one pass.
+ *
+ * Gives the same result as OscVisDebayer() followed by OscVisBGR2Grey()
+ * and OscVisGrey2BW(), see OscVisDebayerGrey().
+ *
+ * @param pRaw Pointer to the raw input picture of size width x height.
+ * @param width Width of the input and output image.
+ * @param height Height of the input and output image.
+ * @param enBayerOrderFirstRow The order of the bayer pattern colors
+ * in the first row of the image to be debayered.
+ * @param pTemp Temporary buffer of OSC_VIS_DEBAYER_PIPELINE_TEMP_SIZE(width) bytes.
+ * @param threshold Grey values above the threshold are bright.
+ * @param bDarkIsForeground Set to TRUE to make dark pixels 1.
+ * @param pOut Pointer to the binary output image.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscVisDebayerBW(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		const enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		uint8 threshold,
+		bool bDarkIsForeground,
+		uint8 *const pOut);
+
+/*********************************************************************//*!
+ * @brief Convert a raw bayer image to YUV 4:2:0 in one pass.
+ *
+ * Debayers like OscVisDebayer() and converts to YUV with the coefficients
+ * of the JPEG encoder, see OscVisDebayerGrey(). The output has the layout
+ * of OSC_PICTURE_YUV_420 expected by the JPEG encoder: Every 2x2 block of
+ * pixels is stored as Y00 Y01 Y10 Y11 Cb Cr, where Cb and Cr are the means
+ * of the block. The blocks are stored row pair by row pair, which gives
+ * width * height * 3 / 2 bytes.
+ *
+ * @param pRaw Pointer to the raw input picture of size width x height.
+ * @param width Width of the input and output image.
+ * @param height Height of the input and output image, must be even.
+ * @param enBayerOrderFirstRow The order of the bayer pattern colors
+ * in the first row of the image to be debayered.
+ * @param pTemp Temporary buffer of OSC_VIS_DEBAYER_PIPELINE_TEMP_SIZE(width) bytes.
+ * @param pOut Pointer to the YUV output image.
+ * @return SUCCESS or an appropriate error code otherwise
+ *//*********************************************************************/
+OSC_ERR OscVisDebayerYUV420(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		const enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		uint8 *const pOut);
+
 /*!
  * @brief Convert a raw image captured by a camera sensor with bayer filter to a greyscale output image with halvened dimensions.
  * 
@@ -208,6 +380,38 @@ OSC_ERR OscVisDebayerHalfSize(uint8 const * const pRaw, uint16 const width, uint
  */
 OSC_ERR OscVisDebayerSpot(uint8 const * const pRaw, uint16 const width, uint16 const height, enum EnBayerOrder enBayerOrderFirstRow, uint16 const xPos, uint16 const yPos, uint16 const size, uint8 * color);
 
+/*! @brief Instruction sets used by the vectorized host implementations of the OscVisFastDebayer functions. */
+enum EnOscVisSimd {
+	OSC_VIS_SIMD_NONE,		/*!< @brief Scalar reference code only */
+	OSC_VIS_SIMD_SSE2,
+	OSC_VIS_SIMD_SSSE3,
+	OSC_VIS_SIMD_AVX2,
+	OSC_VIS_SIMD_NEON
+};
+
+/*********************************************************************//*!
+ * @brief Select the instruction set of the fast debayering.
+ *
+ * On the host, the OscVisFastDebayer functions use vectorized code for the
+ * best instruction set of the CPU, which is detected when the vis module is
+ * created, or at the first call without it. The result is bit-identical to
+ * the scalar code. This function selects a lower instruction set, e.g. to
+ * compare against the scalar code with OSC_VIS_SIMD_NONE. It is a
+ * configuration call and must not be made while other threads debayer. On
+ * the target, it only accepts OSC_VIS_SIMD_NONE.
+ *
+ * @param simd The instruction set to use.
+ * @return SUCCESS or -EUNSUPPORTED if the CPU does not support it.
+ *//*********************************************************************/
+OSC_ERR OscVisSetSimd(enum EnOscVisSimd simd);
+
+/*********************************************************************//*!
+ * @brief Get the instruction set used by the fast debayering.
+ *
+ * @return The instruction set in use, see OscVisSetSimd().
+ *//*********************************************************************/
+enum EnOscVisSimd OscVisGetSimd(void);
+
 
 /*********************************************************************//*!
  * @brief Convert a raw image captured by a camera sensor with bayer
@@ -407,6 +611,42 @@ OSC_ERR OscVisFastDebayerHSL_S(const struct OSC_PICTURE *pRaw, struct OSC_PICTUR
 OSC_ERR OscVisFastDebayerHSL_L(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut);
 
 
+/*********************************************************************//*!
+ * @brief Convert a raw image captured by a camera sensor with bayer
+ * filter to hue, saturation and luminance output images in one pass.
+ * 
+ * Gives the same results as OscVisFastDebayerHSL_H(), OscVisFastDebayerHSL_S()
+ * and OscVisFastDebayerHSL_L() while reading the raw image only once. The
+ * quotients are calculated with lookup tables of reciprocals.
+ * Image size is reduced by a factor of 4!
+ * 
+ * @param pRaw Pointer to an OSC_PICTURE structure which contains the raw input picture of size width x height.
+ * @param pOutH Pointer to the hue OSC_PICTURE structure of size (width/2) x (height/2) or NULL.
+ * @param pOutS Pointer to the saturation OSC_PICTURE structure of size (width/2) x (height/2) or NULL.
+ * @param pOutL Pointer to the luminance OSC_PICTURE structure of size (width/2) x (height/2) or NULL.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisFastDebayerHSL(const struct OSC_PICTURE *pRaw,
+		struct OSC_PICTURE *pOutH,
+		struct OSC_PICTURE *pOutS,
+		struct OSC_PICTURE *pOutL);
+
+
+/*********************************************************************//*!
+ * @brief Convert a raw image captured by a camera sensor with bayer
+ * filter to a packed HSL output image.
+ * 
+ * Same as OscVisFastDebayerHSL() but the three channels are stored in
+ * the order H, S, L per pixel (OSC_PICTURE_HSL_24).
+ * Image size is reduced by a factor of 4!
+ * 
+ * @param pRaw Pointer to an OSC_PICTURE structure which contains the raw input picture of size width x height.
+ * @param pOut Pointer to the result OSC_PICTURE structure of size (width/2) x (height/2) x 3 bytes.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisFastDebayerHSLPacked(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut);
+
+
 /*********************************************************************//*!
  * @brief Sobel edge filter.
  * 
@@ -466,6 +706,189 @@ OSC_ERR OscVisErode(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8
  *//*********************************************************************/
 OSC_ERR OscVisDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions);
 
+/*********************************************************************//*!
+ * @brief Pack a Binary Image
+ * 
+ * This function converts a binary image with one byte per pixel into a packed binary image with
+ * one bit per pixel, which is used by the packed morphology functions. Every non-zero pixel is
+ * foreground. Each row starts at a new 32-bit word, see OSC_VIS_PACKED_WORDS_PER_ROW().
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY).
+ * @param picOut Pointer to the output picture struct (type will be OSC_PICTURE_BINARY_PACKED). The data must be 4-byte aligned.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisBinaryPack(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut);
+
+/*********************************************************************//*!
+ * @brief Unpack a Binary Image
+ * 
+ * This function converts a packed binary image back into a binary image with one byte per pixel
+ * holding 0 (background) or 1 (foreground).
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY_PACKED).
+ * @param picOut Pointer to the output picture struct (type will be OSC_PICTURE_BINARY).
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisBinaryUnpack(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut);
+
+/*********************************************************************//*!
+ * @brief Packed Binary Erosion.
+ * 
+ * This function performs an erosion of a packed binary image. 32 pixels are processed with a
+ * single AND per offset vector of the structuring element. Unlike OscVisErode(), the whole output
+ * image is computed: pixels outside the image are treated as foreground.
+ * 
+ * Decomposed structuring elements and multiple runs alternate between the output and the
+ * temporary buffer without copying. This function can operate in-place, i.e picIn = picOut.
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY_PACKED).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTempBuffer Pointer to the temporary data buffer (same size as the packed image).
+ * @param pStrEl Pointer to structuring element.
+ * @param nRepetitions Number of operation repetitions.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisPackedErode(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions);
+
+/*********************************************************************//*!
+ * @brief Packed Binary Dilation.
+ * 
+ * This function performs a dilation of a packed binary image. 32 pixels are processed with a
+ * single OR per offset vector of the structuring element. Pixels outside the image are treated
+ * as background.
+ * 
+ * @see OscVisPackedErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY_PACKED).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTempBuffer Pointer to the temporary data buffer (same size as the packed image).
+ * @param pStrEl Pointer to structuring element.
+ * @param nRepetitions Number of operation repetitions.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisPackedDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions);
+
+/*********************************************************************//*!
+ * @brief Packed Binary Opening.
+ * 
+ * This function performs nRepetitions erosions followed by nRepetitions dilations of a packed
+ * binary image.
+ * 
+ * @see OscVisPackedErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY_PACKED).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTempBuffer Pointer to the temporary data buffer (same size as the packed image).
+ * @param pStrEl Pointer to structuring element.
+ * @param nRepetitions Number of erosions and dilations.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisPackedOpen(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions);
+
+/*********************************************************************//*!
+ * @brief Packed Binary Closing.
+ * 
+ * This function performs nRepetitions dilations followed by nRepetitions erosions of a packed
+ * binary image.
+ * 
+ * @see OscVisPackedErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY_PACKED).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTempBuffer Pointer to the temporary data buffer (same size as the packed image).
+ * @param pStrEl Pointer to structuring element.
+ * @param nRepetitions Number of dilations and erosions.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisPackedClose(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions);
+
+/*********************************************************************//*!
+ * @brief Grey-level Erosion.
+ * 
+ * This function computes the minimum of a greyscale image over a flat rectangular or line
+ * structuring element. The van Herk/Gil-Werman algorithm is used, which needs three comparisons
+ * per pixel and direction, independent of the size of the structuring element. Rectangles are
+ * decomposed into a horizontal and a vertical line.
+ * 
+ * Pixels outside the image are ignored, so the whole output image is computed. This function can
+ * operate in-place, i.e picIn = picOut. It needs a temporary buffer of a few lines.
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_GREYSCALE).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: OSC_VIS_GREY_MORPH_TEMP_SIZE()).
+ * @param pStrEl Pointer to the structuring element.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisGreyErode(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl);
+
+/*********************************************************************//*!
+ * @brief Grey-level Dilation.
+ * 
+ * This function computes the maximum of a greyscale image over a flat rectangular or line
+ * structuring element.
+ * 
+ * @see OscVisGreyErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_GREYSCALE).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: OSC_VIS_GREY_MORPH_TEMP_SIZE()).
+ * @param pStrEl Pointer to the structuring element.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisGreyDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl);
+
+/*********************************************************************//*!
+ * @brief Grey-level Opening.
+ * 
+ * This function performs a grey-level erosion followed by a grey-level dilation, which removes
+ * bright structures smaller than the structuring element.
+ * 
+ * @see OscVisGreyErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_GREYSCALE).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: OSC_VIS_GREY_MORPH_TEMP_SIZE()).
+ * @param pStrEl Pointer to the structuring element.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisGreyOpen(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl);
+
+/*********************************************************************//*!
+ * @brief Grey-level Closing.
+ * 
+ * This function performs a grey-level dilation followed by a grey-level erosion, which removes
+ * dark structures smaller than the structuring element.
+ * 
+ * @see OscVisGreyErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_GREYSCALE).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: OSC_VIS_GREY_MORPH_TEMP_SIZE()).
+ * @param pStrEl Pointer to the structuring element.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisGreyClose(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl);
+
+/*********************************************************************//*!
+ * @brief Grey-level Top-Hat Transform.
+ * 
+ * This function extracts structures smaller than the structuring element from an uneven
+ * background. The white top-hat (input minus opening) keeps bright structures, the black top-hat
+ * (closing minus input) keeps dark structures. The result is suited for a subsequent
+ * OscVisGrey2BW() with a fixed threshold.
+ * 
+ * @see OscVisGreyErode
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_GREYSCALE).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: OSC_VIS_GREY_MORPH_TEMP_SIZE(), plus width x height
+ * for in-place operation).
+ * @param pStrEl Pointer to the structuring element.
+ * @param bDarkIsForeground Flag to compute the black top-hat for dark structures on a bright background.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisGreyTopHat(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl, bool bDarkIsForeground);
+
 /*********************************************************************//*!
  * @brief Label Binary Image * 
  * 
@@ -473,12 +896,90 @@ OSC_ERR OscVisDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint
  * run-length encoding. This function outputs a representation of the binary image based on connected
  * sets of runs. The sets of runs are refered to as 'objects' (=regions of foreground pixels).
  * 
+ * If the image contains more than MAX_NO_OF_RUNS runs or MAX_NO_OF_OBJECTS objects, the
+ * remaining runs are dropped and -EBUFFER_TOO_SMALL is returned. Use OscVisLabelBinarySet()
+ * for images with more runs.
+ * 
  * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY).
  * @param regions Pointer to the regions struct
  * @return SUCCESS or an appropriate error code.
  *//*********************************************************************/
 OSC_ERR OscVisLabelBinary(struct OSC_PICTURE *picIn, struct OSC_VIS_REGIONS *regions);
 
+/*********************************************************************//*!
+ * @brief Initialize a Region Set in a caller-provided Arena
+ * 
+ * The arena is split into runs and objects and, with statistics, their accumulators. Use
+ * OscVisRegionSetArenaSize() to size it. The region set never allocates memory, exhausting it
+ * is reported by OscVisLabelBinarySet().
+ * 
+ * With statistics, the area, perimeter, bounding box, centroid, second moments and mean
+ * intensity of every object are accumulated while labeling, see OSC_VIS_REGION_STATS. Set
+ * pGreyImg, minArea and maxArea in the region set after initializing it.
+ * 
+ * @param pSet Pointer to the region set to initialize.
+ * @param pArena Pointer to the arena, aligned for a 64 bit integer.
+ * @param arenaSize Size of the arena in bytes.
+ * @param bStatistics TRUE to accumulate the object statistics while labeling.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisRegionSetInit(struct OSC_VIS_REGION_SET *pSet, void *pArena, uint32 arenaSize, bool bStatistics);
+
+/*********************************************************************//*!
+ * @brief Arena Size needed for a Region Set
+ * 
+ * @param noOfRuns Number of runs the region set should be able to store.
+ * @param bStatistics TRUE if statistics are accumulated.
+ * @return Size of the arena in bytes to pass to OscVisRegionSetInit().
+ *//*********************************************************************/
+uint32 OscVisRegionSetArenaSize(uint32 noOfRuns, bool bStatistics);
+
+/*********************************************************************//*!
+ * @brief Create a growable Region Set
+ * 
+ * The storage for runs and objects is allocated on the heap and is doubled whenever it is
+ * exhausted during labeling. It is kept for the next image. Free it with OscVisRegionSetDestroy().
+ * 
+ * @param pSet Pointer to the region set to initialize.
+ * @param initialNoOfRuns Number of runs and objects to allocate initially, may be 0.
+ * @param bStatistics TRUE to accumulate the object statistics while labeling, see OscVisRegionSetInit().
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisRegionSetCreate(struct OSC_VIS_REGION_SET *pSet, uint32 initialNoOfRuns, bool bStatistics);
+
+/*********************************************************************//*!
+ * @brief Destroy a Region Set
+ * 
+ * Frees the storage of a growable region set. An arena provided to OscVisRegionSetInit() is
+ * left to the caller.
+ * 
+ * @param pSet Pointer to the region set.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisRegionSetDestroy(struct OSC_VIS_REGION_SET *pSet);
+
+/*********************************************************************//*!
+ * @brief Label Binary Image into a Region Set
+ * 
+ * This function labels the binary image like OscVisLabelBinary(), but stores the runs and
+ * objects in a region set of variable capacity. Background pixels are skipped a machine word
+ * at a time.
+ * 
+ * If the storage of a region set initialized with OscVisRegionSetInit() is exhausted, the runs
+ * found so far are labeled, the remaining runs are only counted in noOfRunsRequired and
+ * -EBUFFER_TOO_SMALL is returned. If only the object storage is exhausted, the runs of the objects
+ * stored are labeled and the runs of the remaining objects keep label 0.
+ * 
+ * If the region set accumulates statistics, the stats array and the properties of the objects
+ * (area, perimeter, centroid, bounding box) are filled in the same pass, OscVisGetRegionSetProperties()
+ * need not be called. Objects outside of minArea and maxArea are dropped, their runs keep label 0.
+ * 
+ * @param picIn Pointer to the input picture struct (type must be OSC_PICTURE_BINARY).
+ * @param pSet Pointer to the region set.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisLabelBinarySet(struct OSC_PICTURE *picIn, struct OSC_VIS_REGION_SET *pSet);
+
 /*********************************************************************//*!
  * @brief Extract Properties of the Regions (=labeled binary Image) * 
  * 
@@ -490,6 +991,16 @@ OSC_ERR OscVisLabelBinary(struct OSC_PICTURE *picIn, struct OSC_VIS_REGIONS *reg
  *//*********************************************************************/
 OSC_ERR OscVisGetRegionProperties(struct OSC_VIS_REGIONS *regions);
 
+/*********************************************************************//*!
+ * @brief Extract Properties of the Regions of a Region Set
+ * 
+ * @see OscVisGetRegionProperties
+ * 
+ * @param pSet Pointer to the region set
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisGetRegionSetProperties(struct OSC_VIS_REGION_SET *pSet);
+
 /*********************************************************************//*!
  * @brief Draw Centroid Markers * 
  * 
@@ -571,14 +1082,43 @@ OSC_ERR OscVisBGR2BW(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint
  * 
  * A generic 2D filter for grayscale images only. A filter kernel must be provided with this function.
  * 
+ * Kernels with odd dimensions and non-negative coefficients that are the outer product of a column
+ * and a row vector (e.g. GAUSS3X3, GAUSS5X5) are computed in two 1-D passes. Uniform kernels
+ * (MEDIAN3X3, MEDIAN5X5) are computed with running sums, and a kernel weight that is a power of two
+ * is applied as a shift. The result is identical to the direct 2D convolution.
+ * 
+ * This function leaves a border of the output image untouched, its size depends on the kernel's width and height.
+ * 
  * @param picIn Pointer to the input grayscale picture struct (type must be OSC_PICTURE_GREYSCALE).
- * @param picOut Pointer to the output picture struct. 
- * @param pTemp Pointer to the temporary data buffer.
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: width x height). Only used for in-place operation.
  * @param pKernel Pointer to the filter kernel struct.
  * @return SUCCESS or an appropriate error code.
  *//*********************************************************************/
 OSC_ERR OscVisFilter2D(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_FILTER_KERNEL *pKernel);
 
+/*********************************************************************//*!
+ * @brief Median Filter for Grayscale Images * 
+ * 
+ * A rank-order median filter over a square window for grayscale images only. Unlike
+ * OscVisFilter2D() with the MEDIAN3X3 or MEDIAN5X5 kernel, which computes the mean of the
+ * neighbourhood, this function preserves edges and removes salt-and-pepper noise.
+ * 
+ * Windows of 3x3 and 5x5 are computed with sorting networks. Larger windows use a constant-time
+ * histogram algorithm, whose cost per pixel does not depend on the window size. It keeps
+ * width x 272 bytes of column histograms in the temporary buffer.
+ * 
+ * This function leaves a border of (kernelSize - 1) / 2 pixels of the output image untouched.
+ * 
+ * @param picIn Pointer to the input grayscale picture struct (type must be OSC_PICTURE_GREYSCALE).
+ * @param picOut Pointer to the output picture struct. For in-place operation, set this to the input picture.
+ * @param pTemp Pointer to the temporary data buffer (size: width x height for in-place operation, plus
+ * width x 272 for windows larger than 5x5). May be NULL if neither is the case.
+ * @param kernelSize Width and height of the window. Must be odd and not larger than the image.
+ * @return SUCCESS or an appropriate error code.
+ *//*********************************************************************/
+OSC_ERR OscVisMedianFilter(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, uint8 kernelSize);
+
 
 /*********************************************************************//*!
  * @brief Debayer an image to BGR color format using bilinear debayering.
@@ -21,6 +21,7 @@
 struct OscModule OscModule_jpg = {
 	.dependencies = {
 		&OscModule_log,
+		&OscModule_sup,
 		NULL // To end the flexible array.
 	}
 };
@@ -29,10 +29,55 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <sys/types.h>
+#if defined(OSC_HOST)
+#include <pthread.h>
+#endif
+
 #include "oscar.h"
 
 #define		BLOCK_SIZE				64
 
+/*! @brief Number of quality factors whose quantization tables are kept by an encoder. */
+#define		QUANT_CACHE_SIZE		4
+
+typedef struct IMGDATA {
+	int16	Y1 [BLOCK_SIZE];
+	int16	Y2 [BLOCK_SIZE];
+	int16	Y3 [BLOCK_SIZE];
+	int16	Y4 [BLOCK_SIZE];
+	int16	CB [BLOCK_SIZE];
+	int16	CR [BLOCK_SIZE];
+/*	int16	Temp [BLOCK_SIZE];*/
+} IMGDATA;
+
+#if defined(OSC_HOST)
+/*! @brief Fractional bits of the reciprocals of the quantization divisors of the fast DCT. */
+#define		QUANT_RECIP_BITS		31
+
+/*! @brief Reciprocals of the divisors of the fast DCT outputs in natural order, see fast_quantization_divisors(). */
+typedef struct FAST_QUANT_DIVISORS
+{
+	uint32	recip [BLOCK_SIZE];
+} FAST_QUANT_DIVISORS;
+#endif
+
+/*! @brief Quantization tables for one quality factor. */
+typedef struct QUANT_TABLES
+{
+	uint32	quality_factor;
+	bool	valid;
+
+	uint8	Lqt [BLOCK_SIZE];
+	uint8	Cqt [BLOCK_SIZE];
+	uint16	ILqt [BLOCK_SIZE];
+	uint16	ICqt [BLOCK_SIZE];
+#if defined(OSC_HOST)
+	FAST_QUANT_DIVISORS	fast_luminance;
+	FAST_QUANT_DIVISORS	fast_chrominance;
+#endif
+} QUANT_TABLES;
+
 typedef struct JPEG_ENCODER_STRUCTURE
 {
 	uint16	mcu_width;
@@ -50,6 +95,7 @@ typedef struct JPEG_ENCODER_STRUCTURE
 	uint16	incr;
 	uint16	mcu_width_size;
 	uint16	offset;
+	uint32	mcu_row_size;
 
 	int16 ldc1;
 	int16 ldc2;
@@ -57,47 +103,164 @@ typedef struct JPEG_ENCODER_STRUCTURE
 
 	int16 debug_pass;
 
+	/* Use fast_dct_quantization() instead of the reference DCT */
+	bool fast_dct;
+
+	/* Bit stream state of the Huffman coder */
+	uint64_t lcode;
+	uint16 bitindex;
+
+	void (*read_format) (IMGDATA *img, struct JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 *input_ptr);
+	const QUANT_TABLES *quant;
 } JPEG_ENCODER_STRUCTURE;
 
-extern uint8	Lqt [BLOCK_SIZE];
-extern uint8	Cqt [BLOCK_SIZE];
-extern uint16	ILqt [BLOCK_SIZE];
-extern uint16	ICqt [BLOCK_SIZE];
+/*! @brief Upper bound of the coded size of an MCU in bytes: 6 blocks of 64 coefficients of at most 26 bits each, every byte possibly stuffed. */
+#define		MAX_MCU_BYTES			(6 * 512)
+/*! @brief Upper bound of the bytes written when a bit stream is ended: fewer than 32 remaining bits, every byte possibly stuffed, and a marker. */
+#define		MAX_BITSTREAM_END_BYTES	(2 * 4 + 2)
+/*! @brief Upper bound of the size of the markers in front of the coded data. */
+#define		MAX_MARKER_BYTES		1024
 
-typedef struct IMGDATA {
-	int16	Y1 [BLOCK_SIZE];
-	int16	Y2 [BLOCK_SIZE];
-	int16	Y3 [BLOCK_SIZE];
-	int16	Y4 [BLOCK_SIZE];
-	int16	CB [BLOCK_SIZE];
-	int16	CR [BLOCK_SIZE];
-/*	int16	Temp [BLOCK_SIZE];*/
-} IMGDATA;
+/*! @brief The state needed to encode a sequence of MCUs. An encoder has one for every thread. */
+typedef struct JPG_MCU_CODER
+{
+	JPEG_ENCODER_STRUCTURE	jpeg;
+	IMGDATA					image;
+	uint16					Temp [BLOCK_SIZE];
+
+	/* Private output buffer of the restart intervals encoded by a worker thread */
+	uint8					*buffer;
+	uint32					buffer_size;
+	uint32					buffer_used;
+} JPG_MCU_CODER;
+
+#if defined(OSC_HOST)
+/*! @brief A thread of the worker pool of an encoder and the range of restart intervals it encodes for the current picture. */
+typedef struct JPG_WORKER
+{
+	JPG_MCU_CODER			coder;
+	struct JPG_ENCODER		*encoder;
+	pthread_t				thread;
+	bool					started;	/* The thread is running, otherwise the calling thread does the work */
+	bool					busy;		/* A range of intervals is waiting to be encoded */
+	uint32					first_interval;
+	uint32					end_interval;
+	OSC_ERR					err;
+} JPG_WORKER;
+#endif
+
+/*! @brief An encoder instance, see OscJpgCreateEncoder(). Everything needed to encode one image at a time. */
+typedef struct JPG_ENCODER
+{
+	JPG_MCU_CODER			coder;
+
+	QUANT_TABLES			quant_cache [QUANT_CACHE_SIZE];
+	uint16					next_quant_entry;
+
+	uint32					bgr_format;			/* JPEG format of BGR pictures */
+	bool					fast_dct;
+	uint16					restart_interval;	/* MCUs per restart interval, 0 for none */
+	uint16					noOfThreads;
+
+#if defined(OSC_HOST)
+	/* Worker pool, kept until the encoder is destroyed. The first worker is run by the calling thread */
+	JPG_WORKER				**workers;
+	uint16					noOfWorkers;
+	pthread_mutex_t			lock;
+	pthread_cond_t			start;		/* Signalled when new work is handed out or the encoder is destroyed */
+	pthread_cond_t			done;		/* Signalled when the last busy worker has finished */
+	uint16					pending;	/* Number of busy workers */
+	bool					closing;
+
+	/* The picture being encoded by the workers */
+	uint32					image_format;
+	uint8					*image_ptr;
+#endif
+} JPG_ENCODER;
+
+/*! @brief Number of frames that can be queued in a stream. */
+#define		STREAM_QUEUE_SIZE		64
+/*! @brief Size of the headers of an AVI file up to the first frame. */
+#define		AVI_HEADER_SIZE			224
+
+/*! @brief An encoded frame in the output buffer of a stream. */
+typedef struct JPG_STREAM_FRAME
+{
+	uint32	offset;
+	uint32	size;
+	uint32	skip;		/* Bytes left unused at the end of the buffer before this frame */
+} JPG_STREAM_FRAME;
+
+/*! @brief A Motion-JPEG stream, see OscJpgStreamOpen(). */
+typedef struct JPG_STREAM
+{
+	void					*hEncoder;
+	int						fd;
+	bool					closeFd;
+	enum EnOscJpgStreamFormat	format;
+	uint32					framesPerSecond;
+
+	/* The output buffer is used as a ring of encoded frames from tail to head */
+	uint8					*buffer;
+	uint32					bufferSize;
+	uint32					head;
+	uint32					tail;
+	uint32					used;
+	JPG_STREAM_FRAME		queue [STREAM_QUEUE_SIZE];
+	uint16					queueHead;
+	uint16					queueLength;
+
+	struct OSC_JPG_STREAM_STATS	stats;
+
+	/* AVI file */
+	off_t					start;		/* Position of the RIFF header */
+	uint16					width;
+	uint16					height;
+	uint32					moviSize;	/* Size of the frame chunks written */
+	uint32					maxFrameSize;
+	uint32					*index;		/* Offset and size of every frame */
+	uint32					indexSize;
+
+#if defined(OSC_HOST)
+	pthread_t				thread;
+	pthread_mutex_t			lock;
+	pthread_cond_t			cond;
+	bool					closing;
+#endif
+} JPG_STREAM;
 
-extern uint32 lcode;
-extern uint16 bitindex;
+extern uint8 zigzag_table [BLOCK_SIZE];
 
 /*======================= Private methods ==============================*/
-void initialization (JPEG_ENCODER_STRUCTURE *, uint32, uint32, uint32);
+void initialization (JPEG_ENCODER_STRUCTURE *, uint32, uint32, uint32, uint32);
 
 uint16 DSP_Division (uint32, uint32);
-void initialize_quantization_tables (uint32);
+void initialize_quantization_tables (QUANT_TABLES *, uint32);
+const QUANT_TABLES * get_quantization_tables (JPG_ENCODER *, uint32);
 
-uint8* write_markers (uint8 *, uint32, uint32, uint32);
+uint8* write_markers (uint8 *, const QUANT_TABLES *, uint32, uint32, uint32, uint16);
 
 void read_400_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
 void read_420_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
 void read_422_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
 void read_444_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
-void BGR_2_444 (uint8 *, uint8 *, uint32, uint32);
+void read_bgr_420_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
+void read_bgr_422_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
+void read_bgr_444_format (IMGDATA *img, JPEG_ENCODER_STRUCTURE *, uint8 *);
 
-uint8* encodeMCU (JPEG_ENCODER_STRUCTURE *, uint32, uint8 *);
+uint8* encodeMCU (JPG_MCU_CODER *, uint32, uint8 *);
+uint8* encode_mcus (JPG_MCU_CODER *, uint32, uint8 *, uint32, uint32, uint8 *, uint8 *);
 
 void levelshift (int16 *);
 void DCT (int16 *);
-void quantization (int16 *, uint16 *, uint16 *);
+void quantization (int16 *, const uint16 *, uint16 *);
+#if defined(OSC_HOST)
+void fast_quantization_divisors (FAST_QUANT_DIVISORS *, const uint8 *);
+void fast_dct_quantization (const int16 *, const FAST_QUANT_DIVISORS *, uint16 *);
+#endif
 uint8* huffman (JPEG_ENCODER_STRUCTURE *, uint16, uint8 *, uint16 *);
 
-uint8* close_bitstream (uint8 *);
+uint8* restart_bitstream (JPEG_ENCODER_STRUCTURE *, uint16, uint8 *);
+uint8* close_bitstream (JPEG_ENCODER_STRUCTURE *, uint8 *);
 #
 #endif /*JPG_PRIV_H_*/
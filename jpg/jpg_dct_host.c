@@ -0,0 +1,303 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+	
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+	
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+	
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*! @file
+ * @brief Fast DCT and quantization of the JPEG encoder on the host.
+ * 
+ * The DCT is the one of Arai, Agui and Nakajima (AAN), which needs only
+ * 5 multiplications per 8 samples. Its outputs are scaled by a factor
+ * per coefficient, which is folded into the quantization divisors. The
+ * level shift is folded into the DC output of the first pass. With SSE2,
+ * each pass transforms the 8 columns of a block at once.
+ * 
+ * The passes keep fractional bits as far as 16 bits allow: the outputs
+ * of the first pass are at most 8 * 255 in magnitude and get PASS1_BITS,
+ * the outputs of the second pass are at most about 12900 and get
+ * PASS2_BITS. The multiplications take no headroom.
+ */
+
+#include "jpg.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Fractional bits of the outputs of the first and the second pass */
+#define PASS1_BITS			3
+#define PASS2_BITS			1
+
+/* AAN constants multiplied by 2^16, as (c - 1) * 2^16 for those which do not fit in 15 bits */
+#define FIX_0_382683433		25080
+#define FIX_0_541196100_M1	(-30068)
+#define FIX_0_707106781_M1	(-19195)
+#define FIX_1_306562965_M1	20091
+
+/* Output scale of the AAN DCT multiplied by 2^14: cos(u*PI/16) * cos(v*PI/16) * 2 for u, v > 0, resp. without the factor root(2) for u or v = 0 */
+static const uint16 aan_scales [BLOCK_SIZE] =
+{
+	16384, 22725, 21407, 19266, 16384, 12873,  8867,  4520,
+	22725, 31521, 29692, 26722, 22725, 17855, 12299,  6270,
+	21407, 29692, 27969, 25172, 21407, 16819, 11585,  5906,
+	19266, 26722, 25172, 22654, 19266, 15137, 10426,  5315,
+	16384, 22725, 21407, 19266, 16384, 12873,  8867,  4520,
+	12873, 17855, 16819, 15137, 12873, 10114,  6967,  3552,
+	 8867, 12299, 11585, 10426,  8867,  6967,  4799,  2446,
+	 4520,  6270,  5906,  5315,  4520,  3552,  2446,  1247
+};
+
+/* Calculate the divisors of the AAN outputs from the quantization table in natural order.
+ * The divisor of a coefficient is quant * aan_scale * 2^PASS2_BITS / 2^11, which is fractional
+ * for small quantization steps, so it is not rounded. Its reciprocal is kept as a fixed-point
+ * number with QUANT_RECIP_BITS fractional bits, into which the 2^(11 - PASS2_BITS) is folded. The quotient round(x / d)
+ * of the absolute value x of a coefficient is calculated as (x * recip + 2^(QUANT_RECIP_BITS - 1)) >> QUANT_RECIP_BITS. */
+void fast_quantization_divisors (FAST_QUANT_DIVISORS *divisors, const uint8 *quant_table)
+{
+	uint16 i;
+	uint64_t divisor;
+
+	for (i=0; i<BLOCK_SIZE; i++)
+	{
+		divisor = (uint64_t) quant_table [i] * aan_scales [i];
+		divisors->recip [i] = (uint32) ((((uint64_t) 1 << (QUANT_RECIP_BITS + 11 - PASS2_BITS)) + divisor / 2) / divisor);
+	}
+}
+
+#if defined(__SSE2__)
+
+/* x * c >> 16 for the AAN constants below 0.5, resp. x + (x * (c - 1) >> 16) for the others */
+#define AAN_MULTIPLY(x, c) _mm_mulhi_epi16 ((x), (c))
+#define AAN_MULTIPLY_M1(x, c) _mm_add_epi16 ((x), _mm_mulhi_epi16 ((x), (c)))
+
+/* One pass of the AAN DCT over 8 rows, transforming the 8 columns at once */
+static inline void fdct_pass (__m128i *r)
+{
+	const __m128i f_0_382 = _mm_set1_epi16 (FIX_0_382683433);
+	const __m128i f_0_541 = _mm_set1_epi16 (FIX_0_541196100_M1);
+	const __m128i f_0_707 = _mm_set1_epi16 (FIX_0_707106781_M1);
+	const __m128i f_1_306 = _mm_set1_epi16 (FIX_1_306562965_M1);
+	__m128i tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+	__m128i tmp10, tmp11, tmp12, tmp13, z1, z2, z3, z4, z5, z11, z13;
+
+	tmp0 = _mm_add_epi16 (r [0], r [7]);
+	tmp7 = _mm_sub_epi16 (r [0], r [7]);
+	tmp1 = _mm_add_epi16 (r [1], r [6]);
+	tmp6 = _mm_sub_epi16 (r [1], r [6]);
+	tmp2 = _mm_add_epi16 (r [2], r [5]);
+	tmp5 = _mm_sub_epi16 (r [2], r [5]);
+	tmp3 = _mm_add_epi16 (r [3], r [4]);
+	tmp4 = _mm_sub_epi16 (r [3], r [4]);
+
+	/* Even part */
+	tmp10 = _mm_add_epi16 (tmp0, tmp3);
+	tmp13 = _mm_sub_epi16 (tmp0, tmp3);
+	tmp11 = _mm_add_epi16 (tmp1, tmp2);
+	tmp12 = _mm_sub_epi16 (tmp1, tmp2);
+
+	r [0] = _mm_add_epi16 (tmp10, tmp11);
+	r [4] = _mm_sub_epi16 (tmp10, tmp11);
+
+	z1 = AAN_MULTIPLY_M1 (_mm_add_epi16 (tmp12, tmp13), f_0_707);
+	r [2] = _mm_add_epi16 (tmp13, z1);
+	r [6] = _mm_sub_epi16 (tmp13, z1);
+
+	/* Odd part */
+	tmp10 = _mm_add_epi16 (tmp4, tmp5);
+	tmp11 = _mm_add_epi16 (tmp5, tmp6);
+	tmp12 = _mm_add_epi16 (tmp6, tmp7);
+
+	z5 = AAN_MULTIPLY (_mm_sub_epi16 (tmp10, tmp12), f_0_382);
+	z2 = _mm_add_epi16 (AAN_MULTIPLY_M1 (tmp10, f_0_541), z5);
+	z4 = _mm_add_epi16 (AAN_MULTIPLY_M1 (tmp12, f_1_306), z5);
+	z3 = AAN_MULTIPLY_M1 (tmp11, f_0_707);
+
+	z11 = _mm_add_epi16 (tmp7, z3);
+	z13 = _mm_sub_epi16 (tmp7, z3);
+
+	r [5] = _mm_add_epi16 (z13, z2);
+	r [3] = _mm_sub_epi16 (z13, z2);
+	r [1] = _mm_add_epi16 (z11, z4);
+	r [7] = _mm_sub_epi16 (z11, z4);
+}
+
+/* Transpose 8x8 16 bit values */
+static inline void transpose (__m128i *r)
+{
+	__m128i a0, a1, a2, a3, a4, a5, a6, a7, b0, b1, b2, b3, b4, b5, b6, b7;
+
+	a0 = _mm_unpacklo_epi16 (r [0], r [1]);
+	a1 = _mm_unpackhi_epi16 (r [0], r [1]);
+	a2 = _mm_unpacklo_epi16 (r [2], r [3]);
+	a3 = _mm_unpackhi_epi16 (r [2], r [3]);
+	a4 = _mm_unpacklo_epi16 (r [4], r [5]);
+	a5 = _mm_unpackhi_epi16 (r [4], r [5]);
+	a6 = _mm_unpacklo_epi16 (r [6], r [7]);
+	a7 = _mm_unpackhi_epi16 (r [6], r [7]);
+
+	b0 = _mm_unpacklo_epi32 (a0, a2);
+	b1 = _mm_unpackhi_epi32 (a0, a2);
+	b2 = _mm_unpacklo_epi32 (a1, a3);
+	b3 = _mm_unpackhi_epi32 (a1, a3);
+	b4 = _mm_unpacklo_epi32 (a4, a6);
+	b5 = _mm_unpackhi_epi32 (a4, a6);
+	b6 = _mm_unpacklo_epi32 (a5, a7);
+	b7 = _mm_unpackhi_epi32 (a5, a7);
+
+	r [0] = _mm_unpacklo_epi64 (b0, b4);
+	r [1] = _mm_unpackhi_epi64 (b0, b4);
+	r [2] = _mm_unpacklo_epi64 (b1, b5);
+	r [3] = _mm_unpackhi_epi64 (b1, b5);
+	r [4] = _mm_unpacklo_epi64 (b2, b6);
+	r [5] = _mm_unpackhi_epi64 (b2, b6);
+	r [6] = _mm_unpacklo_epi64 (b3, b7);
+	r [7] = _mm_unpackhi_epi64 (b3, b7);
+}
+
+/* Quantize the absolute values of 4 coefficients in 32 bit lanes with their 32 bit reciprocals */
+static inline __m128i quantize4 (__m128i x, const uint32 *recip)
+{
+	const __m128i round = _mm_set_epi32 (0, 1 << (QUANT_RECIP_BITS - 1), 0, 1 << (QUANT_RECIP_BITS - 1));
+	const __m128i r = _mm_loadu_si128 ((const __m128i *) recip);
+	__m128i even, odd;
+
+	/* 64 bit products of lanes 0 and 2 resp. 1 and 3 */
+	even = _mm_mul_epu32 (x, r);
+	odd = _mm_mul_epu32 (_mm_srli_epi64 (x, 32), _mm_srli_epi64 (r, 32));
+	even = _mm_srli_epi64 (_mm_add_epi64 (even, round), QUANT_RECIP_BITS);
+	odd = _mm_srli_epi64 (_mm_add_epi64 (odd, round), QUANT_RECIP_BITS);
+	return _mm_or_si128 (even, _mm_slli_epi64 (odd, 32));
+}
+
+void fast_dct_quantization (const int16 *data, const FAST_QUANT_DIVISORS *divisors, uint16 *Temp)
+{
+	__m128i r [8], sign, x;
+	int16 coeffs [BLOCK_SIZE];
+	uint16 i;
+
+	for (i=0; i<8; i++)
+		r [i] = _mm_slli_epi16 (_mm_loadu_si128 ((const __m128i *) &data [i * 8]), PASS1_BITS);
+
+	/* Columns, the level shift of the 8 samples only changes the DC output */
+	fdct_pass (r);
+	r [0] = _mm_sub_epi16 (r [0], _mm_set1_epi16 ((8 * 128) << PASS1_BITS));
+	for (i=0; i<8; i++)
+		r [i] = _mm_srai_epi16 (_mm_add_epi16 (r [i], _mm_set1_epi16 (1 << (PASS1_BITS - PASS2_BITS - 1))), PASS1_BITS - PASS2_BITS);
+
+	/* Rows */
+	transpose (r);
+	fdct_pass (r);
+	transpose (r);
+
+	for (i=0; i<8; i++)
+	{
+		sign = _mm_srai_epi16 (r [i], 15);
+		x = _mm_sub_epi16 (_mm_xor_si128 (r [i], sign), sign);
+		x = _mm_packs_epi32 (
+				quantize4 (_mm_unpacklo_epi16 (x, _mm_setzero_si128 ()), &divisors->recip [i * 8]),
+				quantize4 (_mm_unpackhi_epi16 (x, _mm_setzero_si128 ()), &divisors->recip [i * 8 + 4]));
+		x = _mm_sub_epi16 (_mm_xor_si128 (x, sign), sign);
+		_mm_storeu_si128 ((__m128i *) &coeffs [i * 8], x);
+	}
+
+	for (i=0; i<BLOCK_SIZE; i++)
+		Temp [zigzag_table [i]] = (uint16) coeffs [i];
+}
+
+#else /* __SSE2__ */
+
+/* The multiplications of the SSE2 version */
+#define AAN_MULTIPLY(x, c) (((x) * (c)) >> 16)
+#define AAN_MULTIPLY_M1(x, c) ((x) + (((x) * (c)) >> 16))
+
+/* One pass of the AAN DCT over 8 values, the same arithmetic as the SSE2 version */
+static inline void fdct_1d (int32 *d, uint16 stride)
+{
+	int32 tmp0, tmp1, tmp2, tmp3, tmp4, tmp5, tmp6, tmp7;
+	int32 tmp10, tmp11, tmp12, tmp13, z1, z2, z3, z4, z5, z11, z13;
+
+	tmp0 = d [0] + d [7 * stride];
+	tmp7 = d [0] - d [7 * stride];
+	tmp1 = d [stride] + d [6 * stride];
+	tmp6 = d [stride] - d [6 * stride];
+	tmp2 = d [2 * stride] + d [5 * stride];
+	tmp5 = d [2 * stride] - d [5 * stride];
+	tmp3 = d [3 * stride] + d [4 * stride];
+	tmp4 = d [3 * stride] - d [4 * stride];
+
+	/* Even part */
+	tmp10 = tmp0 + tmp3;
+	tmp13 = tmp0 - tmp3;
+	tmp11 = tmp1 + tmp2;
+	tmp12 = tmp1 - tmp2;
+
+	d [0] = tmp10 + tmp11;
+	d [4 * stride] = tmp10 - tmp11;
+
+	z1 = AAN_MULTIPLY_M1 (tmp12 + tmp13, FIX_0_707106781_M1);
+	d [2 * stride] = tmp13 + z1;
+	d [6 * stride] = tmp13 - z1;
+
+	/* Odd part */
+	tmp10 = tmp4 + tmp5;
+	tmp11 = tmp5 + tmp6;
+	tmp12 = tmp6 + tmp7;
+
+	z5 = AAN_MULTIPLY (tmp10 - tmp12, FIX_0_382683433);
+	z2 = AAN_MULTIPLY_M1 (tmp10, FIX_0_541196100_M1) + z5;
+	z4 = AAN_MULTIPLY_M1 (tmp12, FIX_1_306562965_M1) + z5;
+	z3 = AAN_MULTIPLY_M1 (tmp11, FIX_0_707106781_M1);
+
+	z11 = tmp7 + z3;
+	z13 = tmp7 - z3;
+
+	d [5 * stride] = z13 + z2;
+	d [3 * stride] = z13 - z2;
+	d [stride] = z11 + z4;
+	d [7 * stride] = z11 - z4;
+}
+
+void fast_dct_quantization (const int16 *data, const FAST_QUANT_DIVISORS *divisors, uint16 *Temp)
+{
+	int32 coeffs [BLOCK_SIZE];
+	uint32 x;
+	uint16 i;
+
+	for (i=0; i<BLOCK_SIZE; i++)
+		coeffs [i] = data [i] << PASS1_BITS;
+
+	/* Columns, the level shift of the 8 samples only changes the DC output */
+	for (i=0; i<8; i++)
+	{
+		fdct_1d (&coeffs [i], 8);
+		coeffs [i] -= (8 * 128) << PASS1_BITS;
+	}
+	for (i=0; i<BLOCK_SIZE; i++)
+		coeffs [i] = (coeffs [i] + (1 << (PASS1_BITS - PASS2_BITS - 1))) >> (PASS1_BITS - PASS2_BITS);
+
+	/* Rows */
+	for (i=0; i<8; i++)
+		fdct_1d (&coeffs [i * 8], 1);
+
+	for (i=0; i<BLOCK_SIZE; i++)
+	{
+		x = coeffs [i] < 0 ? -coeffs [i] : coeffs [i];
+		x = (uint32) (((uint64_t) x * divisors->recip [i] + ((uint64_t) 1 << (QUANT_RECIP_BITS - 1))) >> QUANT_RECIP_BITS);
+		Temp [zigzag_table [i]] = (uint16) (coeffs [i] < 0 ? -(int32) x : (int32) x);
+	}
+}
+
+#endif /* __SSE2__ */
@@ -23,51 +23,47 @@
 
 #include <stdlib.h>
 #include <string.h>
+#if defined(OSC_HOST)
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 #include "jpg.h"
 
-uint8	Lqt [BLOCK_SIZE];
-uint8	Cqt [BLOCK_SIZE];
-uint16	ILqt [BLOCK_SIZE];
-uint16	ICqt [BLOCK_SIZE];
+/* Encoder used by OscJpgEncode() */
+static JPG_ENCODER *DefaultEncoder = NULL;
 
-struct IMGDATA *Image=NULL; /* Singleton */
-JPEG_ENCODER_STRUCTURE *JpegStruct = NULL /* Singleton */;
-uint32 lcode = 0;
-uint16 bitindex = 0; 
-uint16  Temp [BLOCK_SIZE];
-
-void (*read_format) (IMGDATA *img, JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 *input_ptr);
-
-void initialization (JPEG_ENCODER_STRUCTURE *jpeg, uint32 image_format, uint32 image_width, uint32 image_height)
+/* Set up the geometry of the MCUs. The image_format is the format of the JPEG image, input_format the one of the input picture,
+ * which is the same or OSC_PICTURE_BGR_24 to convert and subsample the picture while reading the MCUs */
+void initialization (JPEG_ENCODER_STRUCTURE *jpeg, uint32 image_format, uint32 input_format, uint32 image_width, uint32 image_height)
 {
 	uint16 mcu_width, mcu_height, bytes_per_pixel;
 
 	/* RB there was a bug in the original code that bitindex and lcode were not initialized at
 	 * the second time
  	 */
-	bitindex = 0; 
-	lcode=0;
+	jpeg->bitindex = 0; 
+	jpeg->lcode=0;
 
 	jpeg->debug_pass = 0; 
 
 	switch (image_format) 
 	{
 	case OSC_PICTURE_YUV_444:
-		read_format = read_444_format;
+		jpeg->read_format = input_format == OSC_PICTURE_BGR_24 ? read_bgr_444_format : read_444_format;
 		break;
 	case OSC_PICTURE_YUV_422:
-		read_format = read_422_format;
+		jpeg->read_format = input_format == OSC_PICTURE_BGR_24 ? read_bgr_422_format : read_422_format;
 		break;
 	case OSC_PICTURE_YUV_420:
-		read_format = read_420_format;
+		jpeg->read_format = input_format == OSC_PICTURE_BGR_24 ? read_bgr_420_format : read_420_format;
 		break;
 	case OSC_PICTURE_YUV_400:
-		read_format = read_400_format;
+		jpeg->read_format = read_400_format;
 		break;
 	}
 
-	bytes_per_pixel = OSC_PICTURE_TYPE_COLOR_DEPTH(image_format)/8;
+	bytes_per_pixel = OSC_PICTURE_TYPE_COLOR_DEPTH(input_format)/8;
 
 	if (image_format == OSC_PICTURE_YUV_400|| 
 	    image_format == OSC_PICTURE_YUV_444)
@@ -105,135 +101,568 @@ void initialization (JPEG_ENCODER_STRUCTURE *jpeg, uint32 image_format, uint32 i
 
 	jpeg->mcu_width_size = (uint16) (mcu_width * bytes_per_pixel);
 
-	if (image_format != OSC_PICTURE_YUV_420)
+	if (input_format != OSC_PICTURE_YUV_420)
 		jpeg->offset = (uint16) ((image_width * (mcu_height - 1) - (mcu_width - jpeg->cols_in_right_mcus)) * bytes_per_pixel);
 	else
 		jpeg->offset = (uint16) ((image_width * ((mcu_height >> 1) - 1) - (mcu_width - jpeg->cols_in_right_mcus)) * bytes_per_pixel);
 
+	if (input_format != OSC_PICTURE_YUV_420)
+		jpeg->mcu_row_size = image_width * mcu_height * bytes_per_pixel;
+	else
+		jpeg->mcu_row_size = image_width * (mcu_height >> 1) * bytes_per_pixel;
+
 	jpeg->ldc1 = 0;
 	jpeg->ldc2 = 0;
 	jpeg->ldc3 = 0;
 }
 
-uint8* OscJpgEncode(struct OSC_PICTURE *pic, uint8 *output_ptr, uint32 quality_factor)
+/* Encode the MCUs first_mcu to first_mcu + number_of_mcus - 1, counted row by row. Unless output_limit is NULL, no output is
+ * written at or beyond output_limit and NULL is returned if the MCUs do not fit. */
+uint8* encode_mcus (JPG_MCU_CODER *coder, uint32 image_format, uint8 *image_ptr, uint32 first_mcu, uint32 number_of_mcus, uint8 *output_ptr, uint8 *output_limit)
 {
-	uint16 i, j;
-	uint8 *input_ptr = (uint8 *)pic->data;
+	JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure = &coder->jpeg;
+	uint16 i = (uint16) (first_mcu / jpeg_encoder_structure->horizontal_mcus) + 1;
+	uint16 j = (uint16) (first_mcu % jpeg_encoder_structure->horizontal_mcus) + 1;
+	uint8 *input_ptr = image_ptr + (i - 1) * jpeg_encoder_structure->mcu_row_size + (j - 1) * jpeg_encoder_structure->mcu_width_size;
+
+	for (; number_of_mcus > 0; number_of_mcus--)
+	{
+		if (i < jpeg_encoder_structure->vertical_mcus)
+			jpeg_encoder_structure->rows = jpeg_encoder_structure->mcu_height;
+		else
+			jpeg_encoder_structure->rows = jpeg_encoder_structure->rows_in_bottom_mcus;
 
-	JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure;
+		if (j < jpeg_encoder_structure->horizontal_mcus)
+		{
+			jpeg_encoder_structure->cols = jpeg_encoder_structure->mcu_width;
+			jpeg_encoder_structure->incr = jpeg_encoder_structure->length_minus_mcu_width;
+		}
+		else
+		{
+			jpeg_encoder_structure->cols = jpeg_encoder_structure->cols_in_right_mcus;
+			jpeg_encoder_structure->incr = jpeg_encoder_structure->length_minus_width;
+		}
 
-	if (Image==NULL) {
-		Image = malloc(sizeof(struct IMGDATA));	
-		if (Image == NULL)
-			OscFatalErr("Could not allocate memory\n");
+		jpeg_encoder_structure->read_format (&coder->image, jpeg_encoder_structure, input_ptr);
+		/* Encode the data in MCU */
+		if (output_limit == NULL || output_limit - output_ptr >= MAX_MCU_BYTES)
+			output_ptr = encodeMCU (coder, image_format, output_ptr);
+		else
+		{
+			/* Near the end of the buffer the MCU is encoded aside and copied if it fits */
+			uint8 mcu [MAX_MCU_BYTES];
+			uint32 size = encodeMCU (coder, image_format, mcu) - mcu;
+
+			if (size > output_limit - output_ptr)
+				return NULL;
+			memcpy (output_ptr, mcu, size);
+			output_ptr += size;
+		}
+
+		input_ptr += jpeg_encoder_structure->mcu_width_size;
+
+		if (j++ == jpeg_encoder_structure->horizontal_mcus)
+		{
+			input_ptr += jpeg_encoder_structure->offset;
+			j = 1;
+			i++;
+		}
 	}
+	return output_ptr;
+}
 
-	if (JpegStruct==NULL) {
-		JpegStruct= malloc(sizeof(JPEG_ENCODER_STRUCTURE));	
-		if (JpegStruct == NULL)
-			OscFatalErr("Could not allocate memory\n");
+/* End the bit stream with the restart marker restart_index or, if that is negative, with the EOI marker. Near output_limit
+ * the end is written aside and copied if it fits, NULL is returned otherwise. */
+static uint8* end_bitstream (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, int32 restart_index, uint8 *output_ptr, uint8 *output_limit)
+{
+	uint8 end [MAX_BITSTREAM_END_BYTES];
+	bool aside = output_limit != NULL && output_limit - output_ptr < MAX_BITSTREAM_END_BYTES;
+	uint8 *ptr = aside ? end : output_ptr;
+	uint32 size;
+
+	if (restart_index >= 0)
+		ptr = restart_bitstream (jpeg_encoder_structure, (uint16) restart_index, ptr);
+	else
+		ptr = close_bitstream (jpeg_encoder_structure, ptr);
+
+	if (!aside)
+		return ptr;
+
+	size = ptr - end;
+	if (size > output_limit - output_ptr)
+		return NULL;
+	memcpy (output_ptr, end, size);
+	return output_ptr + size;
+}
+
+/* Encode the restart intervals first_interval to end_interval - 1. The last interval of the image is closed with the EOI marker.
+ * Returns NULL if the output does not fit below output_limit, unless that is NULL. */
+static uint8* encode_intervals (JPG_MCU_CODER *coder, uint32 image_format, uint8 *image_ptr, uint16 restart_interval, uint32 first_interval, uint32 end_interval, uint8 *output_ptr, uint8 *output_limit)
+{
+	uint32 k, number_of_mcus;
+	uint32 total_mcus = (uint32) coder->jpeg.horizontal_mcus * coder->jpeg.vertical_mcus;
+
+	for (k=first_interval; k<end_interval; k++)
+	{
+		number_of_mcus = MIN(restart_interval, total_mcus - k * restart_interval);
+		output_ptr = encode_mcus (coder, image_format, image_ptr, k * restart_interval, number_of_mcus, output_ptr, output_limit);
+		if (output_ptr == NULL)
+			return NULL;
+
+		output_ptr = end_bitstream (&coder->jpeg, (k + 1) * restart_interval < total_mcus ? (int32) k : -1, output_ptr, output_limit);
+		if (output_ptr == NULL)
+			return NULL;
 	}
+	return output_ptr;
+}
 
-	jpeg_encoder_structure = JpegStruct;
-	
-	if (pic->type == OSC_PICTURE_BGR_24)
+#if defined(OSC_HOST)
+/* Encode the range of restart intervals of a worker into the private buffer of its coder */
+static OSC_ERR encode_worker_intervals (JPG_ENCODER *encoder, JPG_WORKER *worker)
+{
+	JPG_MCU_CODER *coder = &worker->coder;
+	uint64_t total_mcus = (uint64_t) coder->jpeg.horizontal_mcus * coder->jpeg.vertical_mcus;
+	uint64_t number_of_intervals = worker->end_interval - worker->first_interval;
+	uint64_t number_of_mcus, needed;
+	uint8 *buffer;
+
+	/* The last interval of the picture may be shorter than the restart interval */
+	number_of_mcus = MIN(number_of_intervals * encoder->restart_interval, total_mcus - (uint64_t) worker->first_interval * encoder->restart_interval);
+	needed = number_of_mcus * MAX_MCU_BYTES + number_of_intervals * MAX_BITSTREAM_END_BYTES;
+	if (needed > UINT32_MAX)
+		return -EOUT_OF_MEMORY;
+
+	if (coder->buffer_size < needed)
+	{
+		buffer = realloc(coder->buffer, needed);
+		if (buffer == NULL)
+			return -EOUT_OF_MEMORY;
+		coder->buffer = buffer;
+		coder->buffer_size = (uint32) needed;
+	}
+
+	coder->buffer_used = encode_intervals (coder, encoder->image_format, encoder->image_ptr, encoder->restart_interval,
+			worker->first_interval, worker->end_interval, coder->buffer, NULL) - coder->buffer;
+	return SUCCESS;
+}
+
+/* A thread of the worker pool, encodes the intervals handed to it until the encoder is destroyed */
+static void *encoder_worker (void *arg)
+{
+	JPG_WORKER *worker = (JPG_WORKER *)arg;
+	JPG_ENCODER *encoder = worker->encoder;
+
+	pthread_mutex_lock (&encoder->lock);
+	for (;;)
+	{
+		while (!worker->busy && !encoder->closing)
+			pthread_cond_wait (&encoder->start, &encoder->lock);
+		if (!worker->busy)
+			break;
+
+		pthread_mutex_unlock (&encoder->lock);
+		worker->err = encode_worker_intervals (encoder, worker);
+		pthread_mutex_lock (&encoder->lock);
+
+		worker->busy = FALSE;
+		if (--encoder->pending == 0)
+			pthread_cond_signal (&encoder->done);
+	}
+	pthread_mutex_unlock (&encoder->lock);
+	return NULL;
+}
+
+/* Grow the worker pool to noOfThreads workers. A thread that cannot be started leaves its work to the calling thread */
+static OSC_ERR grow_workers (JPG_ENCODER *encoder, uint16 noOfThreads)
+{
+	JPG_WORKER **workers, *worker;
+
+	if (encoder->noOfWorkers >= noOfThreads)
+		return SUCCESS;
+
+	workers = realloc(encoder->workers, noOfThreads * sizeof(JPG_WORKER *));
+	if (workers == NULL)
+		return -EOUT_OF_MEMORY;
+	encoder->workers = workers;
+
+	while (encoder->noOfWorkers < noOfThreads)
+	{
+		worker = malloc(sizeof(JPG_WORKER));
+		if (worker == NULL)
+			return -EOUT_OF_MEMORY;
+		memset(worker, 0, sizeof(JPG_WORKER));
+		worker->encoder = encoder;
+		worker->started = encoder->noOfWorkers > 0 && pthread_create(&worker->thread, NULL, encoder_worker, worker) == 0;
+		workers[encoder->noOfWorkers++] = worker;
+	}
+	return SUCCESS;
+}
+
+/* Distribute the restart intervals evenly over noOfThreads workers and concatenate their output, up to output_limit unless that is NULL */
+static OSC_ERR encode_parallel (JPG_ENCODER *encoder, uint32 image_format, uint8 *image_ptr, uint32 number_of_intervals, uint16 noOfThreads, uint8 **output_ptr, uint8 *output_limit)
+{
+	JPG_WORKER *worker;
+	uint16 t;
+	OSC_ERR err;
+
+	err = grow_workers (encoder, noOfThreads);
+	if (err != SUCCESS)
+		return err;
+
+	pthread_mutex_lock (&encoder->lock);
+	encoder->image_format = image_format;
+	encoder->image_ptr = image_ptr;
+	for (t=0; t<noOfThreads; t++)
+	{
+		worker = encoder->workers[t];
+
+		/* Every worker starts with the state set up for the picture */
+		worker->coder.jpeg = encoder->coder.jpeg;
+		worker->first_interval = number_of_intervals * t / noOfThreads;
+		worker->end_interval = number_of_intervals * (t + 1) / noOfThreads;
+		if (worker->started)
+		{
+			worker->busy = TRUE;
+			encoder->pending++;
+		}
+	}
+	pthread_cond_broadcast (&encoder->start);
+	pthread_mutex_unlock (&encoder->lock);
+
+	for (t=0; t<noOfThreads; t++)
+	{
+		worker = encoder->workers[t];
+		if (!worker->started)
+			worker->err = encode_worker_intervals (encoder, worker);
+	}
+
+	pthread_mutex_lock (&encoder->lock);
+	while (encoder->pending > 0)
+		pthread_cond_wait (&encoder->done, &encoder->lock);
+	pthread_mutex_unlock (&encoder->lock);
+
+	for (t=0; t<noOfThreads; t++)
+	{
+		worker = encoder->workers[t];
+		if (worker->err != SUCCESS)
+		{
+			err = worker->err;
+			continue;
+		}
+		if (output_limit != NULL && worker->coder.buffer_used > output_limit - *output_ptr)
+		{
+			if (err == SUCCESS)
+				err = -EBUFFER_TOO_SMALL;
+			continue;
+		}
+		memcpy(*output_ptr, worker->coder.buffer, worker->coder.buffer_used);
+		*output_ptr += worker->coder.buffer_used;
+	}
+	return err;
+}
+#endif /* OSC_HOST */
+
+OSC_ERR OscJpgCreateEncoder(void **phEncoder)
+{
+	JPG_ENCODER *encoder;
+
+	if (phEncoder == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	encoder = malloc(sizeof(JPG_ENCODER));
+	if (encoder == NULL)
 	{
-		pic->type = OSC_PICTURE_YUV_444;
-		BGR_2_444 (input_ptr, output_ptr, pic->width, pic->height);
-		memcpy(input_ptr, output_ptr, pic->width*pic->height*3);
+		OscLog(ERROR, "%s: Could not allocate memory!\n", __func__);
+		return -EOUT_OF_MEMORY;
 	}
+	memset(encoder, 0, sizeof(JPG_ENCODER));
+	encoder->noOfThreads = 1;
+	encoder->bgr_format = OSC_PICTURE_YUV_444;
+#if defined(OSC_HOST)
+	encoder->fast_dct = TRUE;
+	pthread_mutex_init(&encoder->lock, NULL);
+	pthread_cond_init(&encoder->start, NULL);
+	pthread_cond_init(&encoder->done, NULL);
+#endif
+
+	*phEncoder = encoder;
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgDestroyEncoder(void *hEncoder)
+{
+	JPG_ENCODER *encoder = (JPG_ENCODER *)hEncoder;
+#if defined(OSC_HOST)
+	uint16 t;
+#endif
+
+	if (encoder == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+#if defined(OSC_HOST)
+	pthread_mutex_lock(&encoder->lock);
+	encoder->closing = TRUE;
+	pthread_cond_broadcast(&encoder->start);
+	pthread_mutex_unlock(&encoder->lock);
+
+	for (t=0; t<encoder->noOfWorkers; t++)
+	{
+		if (encoder->workers[t]->started)
+			pthread_join(encoder->workers[t]->thread, NULL);
+		free(encoder->workers[t]->coder.buffer);
+		free(encoder->workers[t]);
+	}
+	free(encoder->workers);
+	pthread_cond_destroy(&encoder->done);
+	pthread_cond_destroy(&encoder->start);
+	pthread_mutex_destroy(&encoder->lock);
+#endif
+	free(encoder);
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgSetRestartInterval(void *hEncoder, uint16 restartInterval, uint16 noOfThreads)
+{
+	JPG_ENCODER *encoder = (JPG_ENCODER *)hEncoder;
+
+	if (encoder == NULL || (restartInterval == 0 && noOfThreads != 1))
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+#if defined(OSC_HOST)
+	if (noOfThreads == 0)
+	{
+		long noOfCpus = sysconf(_SC_NPROCESSORS_ONLN);
+		noOfThreads = noOfCpus > 0 ? MIN(noOfCpus, 64) : 1;
+	}
+#else
+	/* The intervals are encoded by the calling thread. */
+	noOfThreads = 1;
+#endif
+
+	encoder->restart_interval = restartInterval;
+	encoder->noOfThreads = noOfThreads;
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgSetChromaSubsampling(void *hEncoder, enum EnOscPictureType format)
+{
+	JPG_ENCODER *encoder = (JPG_ENCODER *)hEncoder;
 
-	if (pic->type != OSC_PICTURE_YUV_444)
+	if (encoder == NULL || (format != OSC_PICTURE_YUV_444 && format != OSC_PICTURE_YUV_422 && format != OSC_PICTURE_YUV_420))
 	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	encoder->bgr_format = format;
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgSetDctMode(void *hEncoder, enum EnOscJpgDctMode mode)
+{
+	JPG_ENCODER *encoder = (JPG_ENCODER *)hEncoder;
+
+	if (encoder == NULL || (mode != OSC_JPG_DCT_REFERENCE && mode != OSC_JPG_DCT_FAST))
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+#if defined(OSC_HOST)
+	encoder->fast_dct = mode == OSC_JPG_DCT_FAST;
+	return SUCCESS;
+#else
+	/* The target keeps the reference DCT. */
+	return mode == OSC_JPG_DCT_REFERENCE ? SUCCESS : -EUNSUPPORTED;
+#endif
+}
+
+/* Encode a picture to output_ptr, without writing at or beyond output_limit unless that is NULL */
+static OSC_ERR encode_picture (JPG_ENCODER *encoder, const struct OSC_PICTURE *pic, uint8 *output_ptr, uint8 *output_limit, uint32 quality_factor, uint8 **pOutputEnd)
+{
+	JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure = &encoder->coder.jpeg;
+	uint8 *input_ptr = (uint8 *)pic->data;
+	uint8 markers [MAX_MARKER_BYTES];
+	uint32 image_format, number_of_intervals, size;
+	uint16 noOfThreads;
+
+	switch (pic->type)
+	{
+	case OSC_PICTURE_BGR_24:
+		/* converted and subsampled while reading the MCUs */
+		image_format = encoder->bgr_format;
+		break;
+	case OSC_PICTURE_YUV_444:
+	case OSC_PICTURE_YUV_422:
+	case OSC_PICTURE_YUV_420:
+	case OSC_PICTURE_YUV_400:
+		image_format = pic->type;
+		break;
+	default:
 		/* unsupported or untested image format */
-		OscFatalErr("Unsupported Image Format in OscJpgEncode\n");
+		OscLog(ERROR, "%s: Unsupported image format %d!\n", __func__, pic->type);
+		return -EUNSUPPORTED;
 	} 
 
 	/* Initialization of JPEG control structure */
-	initialization (jpeg_encoder_structure, pic->type, pic->width, pic->height);
+	initialization (jpeg_encoder_structure, image_format, pic->type, pic->width, pic->height);
 	
-	/* Quantization Table Initialization */
-	initialize_quantization_tables (quality_factor);
+	/* Quantization Table Initialization, cached per quality factor */
+	jpeg_encoder_structure->quant = get_quantization_tables (encoder, quality_factor);
+	jpeg_encoder_structure->fast_dct = encoder->fast_dct;
 
 	/* Writing Marker Data */
+	if (output_limit == NULL)
+		output_ptr = write_markers (output_ptr, jpeg_encoder_structure->quant, image_format, pic->width, pic->height, encoder->restart_interval);
+	else
+	{
+		size = write_markers (markers, jpeg_encoder_structure->quant, image_format, pic->width, pic->height, encoder->restart_interval) - markers;
+		if (size > output_limit - output_ptr)
+			return -EBUFFER_TOO_SMALL;
+		memcpy (output_ptr, markers, size);
+		output_ptr += size;
+	}
 
-	output_ptr = write_markers (output_ptr, pic->type, pic->width, pic->height);
+	if (encoder->restart_interval == 0)
+	{
+		output_ptr = encode_mcus (&encoder->coder, image_format, input_ptr, 0,
+				(uint32) jpeg_encoder_structure->horizontal_mcus * jpeg_encoder_structure->vertical_mcus, output_ptr, output_limit);
+
+		/* Close Routine */
+		if (output_ptr != NULL)
+			output_ptr = end_bitstream (jpeg_encoder_structure, -1, output_ptr, output_limit);
+		if (output_ptr == NULL)
+			return -EBUFFER_TOO_SMALL;
+		*pOutputEnd = output_ptr;
+		return SUCCESS;
+	}
 
-	for (i=1; i<=jpeg_encoder_structure->vertical_mcus; i++)
+	number_of_intervals = ((uint32) jpeg_encoder_structure->horizontal_mcus * jpeg_encoder_structure->vertical_mcus
+			+ encoder->restart_interval - 1) / encoder->restart_interval;
+	noOfThreads = (uint16) MIN(encoder->noOfThreads, number_of_intervals);
+
+#if defined(OSC_HOST)
+	if (noOfThreads > 1)
 	{
-		if (i < jpeg_encoder_structure->vertical_mcus)
-			jpeg_encoder_structure->rows = jpeg_encoder_structure->mcu_height;
-		else
-			jpeg_encoder_structure->rows = jpeg_encoder_structure->rows_in_bottom_mcus;
+		OSC_ERR err = encode_parallel (encoder, image_format, input_ptr, number_of_intervals, noOfThreads, &output_ptr, output_limit);
+		if (err == -EOUT_OF_MEMORY)
+			OscLog(ERROR, "%s: Could not allocate memory!\n", __func__);
+		if (err != SUCCESS)
+			return err;
+		*pOutputEnd = output_ptr;
+		return SUCCESS;
+	}
+#endif
+	output_ptr = encode_intervals (&encoder->coder, image_format, input_ptr, encoder->restart_interval, 0, number_of_intervals, output_ptr, output_limit);
+	if (output_ptr == NULL)
+		return -EBUFFER_TOO_SMALL;
+	*pOutputEnd = output_ptr;
+	return SUCCESS;
+}
 
-		for (j=1; j<=jpeg_encoder_structure->horizontal_mcus; j++)
-		{
-			if (j < jpeg_encoder_structure->horizontal_mcus)
-			{
-				jpeg_encoder_structure->cols = jpeg_encoder_structure->mcu_width;
-				jpeg_encoder_structure->incr = jpeg_encoder_structure->length_minus_mcu_width;
-			}
-			else
-			{
-				jpeg_encoder_structure->cols = jpeg_encoder_structure->cols_in_right_mcus;
-				jpeg_encoder_structure->incr = jpeg_encoder_structure->length_minus_width;
-			}
-
-			read_format (Image, jpeg_encoder_structure, input_ptr);
-			/* Encode the data in MCU */
-			output_ptr = encodeMCU (jpeg_encoder_structure, pic->type, output_ptr);
-
-			input_ptr += jpeg_encoder_structure->mcu_width_size;
-		}
+OSC_ERR OscJpgEncodePicture(void *hEncoder, const struct OSC_PICTURE *pic, uint8 *output_ptr, uint32 quality_factor, uint8 **pOutputEnd)
+{
+	if (hEncoder == NULL || pic == NULL || output_ptr == NULL || pOutputEnd == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	return encode_picture ((JPG_ENCODER *)hEncoder, pic, output_ptr, NULL, quality_factor, pOutputEnd);
+}
+
+OSC_ERR OscJpgEncodePictureToBuffer(void *hEncoder, const struct OSC_PICTURE *pic, uint8 *pBuffer, uint32 bufferSize, uint32 quality_factor, uint32 *pSize)
+{
+	uint8 *output_end;
+	OSC_ERR err;
 
-		input_ptr += jpeg_encoder_structure->offset;
+	if (hEncoder == NULL || pic == NULL || pBuffer == NULL || pSize == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
 	}
 
-	/* Close Routine */
-	output_ptr = close_bitstream (output_ptr);
-	return output_ptr;
+	err = encode_picture ((JPG_ENCODER *)hEncoder, pic, pBuffer, pBuffer + bufferSize, quality_factor, &output_end);
+	if (err != SUCCESS)
+		return err;
+
+	*pSize = output_end - pBuffer;
+	return SUCCESS;
+}
+
+uint8* OscJpgEncode(struct OSC_PICTURE *pic, uint8 *output_ptr, uint32 quality_factor)
+{
+	uint8 *output_end;
+
+	if (DefaultEncoder == NULL) {
+		if (OscJpgCreateEncoder((void **)&DefaultEncoder) != SUCCESS)
+			OscFatalErr("Could not allocate memory\n");
+	}
+
+	if (OscJpgEncodePicture(DefaultEncoder, pic, output_ptr, quality_factor, &output_end) != SUCCESS)
+	{
+		/* unsupported or untested image format */
+		OscFatalErr("Unsupported Image Format in OscJpgEncode\n");
+	}
+	return output_end;
+}
+
+/* Transform and quantize one block into Temp */
+static inline void transform_block (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, int16 *block, bool chrominance, uint16 *Temp)
+{
+#if defined(OSC_HOST)
+	if (jpeg_encoder_structure->fast_dct)
+	{
+		fast_dct_quantization (block, chrominance ? &jpeg_encoder_structure->quant->fast_chrominance :
+				&jpeg_encoder_structure->quant->fast_luminance, Temp);
+		return;
+	}
+#endif
+	levelshift (block);
+	DCT (block);
+	quantization (block, chrominance ? jpeg_encoder_structure->quant->ICqt : jpeg_encoder_structure->quant->ILqt, Temp);
 }
 
-uint8* encodeMCU (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint32 image_format, uint8 *output_ptr)
+uint8* encodeMCU (JPG_MCU_CODER *coder, uint32 image_format, uint8 *output_ptr)
 {
-	levelshift (Image->Y1);
-	DCT ((int16 *)Image->Y1);
-	quantization (Image->Y1, ILqt, Temp);
+	JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure = &coder->jpeg;
+	IMGDATA *Image = &coder->image;
+	uint16 *Temp = coder->Temp;
 
+	transform_block (jpeg_encoder_structure, Image->Y1, FALSE, Temp);
 	output_ptr = huffman (jpeg_encoder_structure, 1, output_ptr, Temp);
 
 	if (image_format == OSC_PICTURE_YUV_420 || 
 	    image_format == OSC_PICTURE_YUV_422)
 	{
-		levelshift (Image->Y2);
-		DCT (Image->Y2);
-		quantization (Image->Y2, ILqt, Temp);
+		transform_block (jpeg_encoder_structure, Image->Y2, FALSE, Temp);
 		output_ptr = huffman (jpeg_encoder_structure, 1, output_ptr, Temp);
 
 		if (image_format == OSC_PICTURE_YUV_420)
 		{
-			levelshift (Image->Y3);
-			DCT (Image->Y3);
-			quantization (Image->Y3, ILqt, Temp);
+			transform_block (jpeg_encoder_structure, Image->Y3, FALSE, Temp);
 			output_ptr = huffman (jpeg_encoder_structure, 1, output_ptr, Temp);
 
-			levelshift (Image->Y4);
-			DCT (Image->Y4);
-			quantization (Image->Y4, ILqt, Temp);
+			transform_block (jpeg_encoder_structure, Image->Y4, FALSE, Temp);
 			output_ptr = huffman (jpeg_encoder_structure, 1, output_ptr, Temp);
 		}
 	}
 
 	if (image_format != OSC_PICTURE_YUV_400)
 	{
-		levelshift (Image->CB);
-		DCT (Image->CB);
-		quantization (Image->CB, ICqt, Temp);
+		transform_block (jpeg_encoder_structure, Image->CB, TRUE, Temp);
 		output_ptr = huffman (jpeg_encoder_structure, 2, output_ptr, Temp);
 
-		levelshift (Image->CR);
-		DCT (Image->CR);
-		quantization (Image->CR, ICqt, Temp);
+		transform_block (jpeg_encoder_structure, Image->CR, TRUE, Temp);
 		output_ptr = huffman (jpeg_encoder_structure, 3, output_ptr, Temp);
 	}
 
@@ -132,40 +132,522 @@ uint16 chrominance_ac_size_table [] =
 	0x000A
 };
 
-uint8 bitsize [] =
+/* Category of the coefficient values -2047 to 2047 in the lower 4 bits, the additional bits coding
+   the value in the bits above. Indexed by value + 2048, -2048 does not occur in baseline JPEG. */
+uint16 coefficient_bits [] =
 {
-	0, 1, 2, 2, 3, 3, 3, 3,
-	4, 4, 4, 4, 4, 4, 4, 4,
-	5, 5, 5, 5, 5, 5, 5, 5,
-	5, 5, 5, 5, 5, 5, 5, 5,
-	6, 6, 6, 6, 6, 6, 6, 6,
-	6, 6, 6, 6, 6, 6, 6, 6,
-	6, 6, 6, 6, 6, 6, 6, 6,
-	6, 6, 6, 6, 6, 6, 6, 6,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	7, 7, 7, 7, 7, 7, 7, 7,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8,
-	8, 8, 8, 8, 8, 8, 8, 8
+	0x000B, 0x000B, 0x001B, 0x002B, 0x003B, 0x004B, 0x005B, 0x006B,
+	0x007B, 0x008B, 0x009B, 0x00AB, 0x00BB, 0x00CB, 0x00DB, 0x00EB,
+	0x00FB, 0x010B, 0x011B, 0x012B, 0x013B, 0x014B, 0x015B, 0x016B,
+	0x017B, 0x018B, 0x019B, 0x01AB, 0x01BB, 0x01CB, 0x01DB, 0x01EB,
+	0x01FB, 0x020B, 0x021B, 0x022B, 0x023B, 0x024B, 0x025B, 0x026B,
+	0x027B, 0x028B, 0x029B, 0x02AB, 0x02BB, 0x02CB, 0x02DB, 0x02EB,
+	0x02FB, 0x030B, 0x031B, 0x032B, 0x033B, 0x034B, 0x035B, 0x036B,
+	0x037B, 0x038B, 0x039B, 0x03AB, 0x03BB, 0x03CB, 0x03DB, 0x03EB,
+	0x03FB, 0x040B, 0x041B, 0x042B, 0x043B, 0x044B, 0x045B, 0x046B,
+	0x047B, 0x048B, 0x049B, 0x04AB, 0x04BB, 0x04CB, 0x04DB, 0x04EB,
+	0x04FB, 0x050B, 0x051B, 0x052B, 0x053B, 0x054B, 0x055B, 0x056B,
+	0x057B, 0x058B, 0x059B, 0x05AB, 0x05BB, 0x05CB, 0x05DB, 0x05EB,
+	0x05FB, 0x060B, 0x061B, 0x062B, 0x063B, 0x064B, 0x065B, 0x066B,
+	0x067B, 0x068B, 0x069B, 0x06AB, 0x06BB, 0x06CB, 0x06DB, 0x06EB,
+	0x06FB, 0x070B, 0x071B, 0x072B, 0x073B, 0x074B, 0x075B, 0x076B,
+	0x077B, 0x078B, 0x079B, 0x07AB, 0x07BB, 0x07CB, 0x07DB, 0x07EB,
+	0x07FB, 0x080B, 0x081B, 0x082B, 0x083B, 0x084B, 0x085B, 0x086B,
+	0x087B, 0x088B, 0x089B, 0x08AB, 0x08BB, 0x08CB, 0x08DB, 0x08EB,
+	0x08FB, 0x090B, 0x091B, 0x092B, 0x093B, 0x094B, 0x095B, 0x096B,
+	0x097B, 0x098B, 0x099B, 0x09AB, 0x09BB, 0x09CB, 0x09DB, 0x09EB,
+	0x09FB, 0x0A0B, 0x0A1B, 0x0A2B, 0x0A3B, 0x0A4B, 0x0A5B, 0x0A6B,
+	0x0A7B, 0x0A8B, 0x0A9B, 0x0AAB, 0x0ABB, 0x0ACB, 0x0ADB, 0x0AEB,
+	0x0AFB, 0x0B0B, 0x0B1B, 0x0B2B, 0x0B3B, 0x0B4B, 0x0B5B, 0x0B6B,
+	0x0B7B, 0x0B8B, 0x0B9B, 0x0BAB, 0x0BBB, 0x0BCB, 0x0BDB, 0x0BEB,
+	0x0BFB, 0x0C0B, 0x0C1B, 0x0C2B, 0x0C3B, 0x0C4B, 0x0C5B, 0x0C6B,
+	0x0C7B, 0x0C8B, 0x0C9B, 0x0CAB, 0x0CBB, 0x0CCB, 0x0CDB, 0x0CEB,
+	0x0CFB, 0x0D0B, 0x0D1B, 0x0D2B, 0x0D3B, 0x0D4B, 0x0D5B, 0x0D6B,
+	0x0D7B, 0x0D8B, 0x0D9B, 0x0DAB, 0x0DBB, 0x0DCB, 0x0DDB, 0x0DEB,
+	0x0DFB, 0x0E0B, 0x0E1B, 0x0E2B, 0x0E3B, 0x0E4B, 0x0E5B, 0x0E6B,
+	0x0E7B, 0x0E8B, 0x0E9B, 0x0EAB, 0x0EBB, 0x0ECB, 0x0EDB, 0x0EEB,
+	0x0EFB, 0x0F0B, 0x0F1B, 0x0F2B, 0x0F3B, 0x0F4B, 0x0F5B, 0x0F6B,
+	0x0F7B, 0x0F8B, 0x0F9B, 0x0FAB, 0x0FBB, 0x0FCB, 0x0FDB, 0x0FEB,
+	0x0FFB, 0x100B, 0x101B, 0x102B, 0x103B, 0x104B, 0x105B, 0x106B,
+	0x107B, 0x108B, 0x109B, 0x10AB, 0x10BB, 0x10CB, 0x10DB, 0x10EB,
+	0x10FB, 0x110B, 0x111B, 0x112B, 0x113B, 0x114B, 0x115B, 0x116B,
+	0x117B, 0x118B, 0x119B, 0x11AB, 0x11BB, 0x11CB, 0x11DB, 0x11EB,
+	0x11FB, 0x120B, 0x121B, 0x122B, 0x123B, 0x124B, 0x125B, 0x126B,
+	0x127B, 0x128B, 0x129B, 0x12AB, 0x12BB, 0x12CB, 0x12DB, 0x12EB,
+	0x12FB, 0x130B, 0x131B, 0x132B, 0x133B, 0x134B, 0x135B, 0x136B,
+	0x137B, 0x138B, 0x139B, 0x13AB, 0x13BB, 0x13CB, 0x13DB, 0x13EB,
+	0x13FB, 0x140B, 0x141B, 0x142B, 0x143B, 0x144B, 0x145B, 0x146B,
+	0x147B, 0x148B, 0x149B, 0x14AB, 0x14BB, 0x14CB, 0x14DB, 0x14EB,
+	0x14FB, 0x150B, 0x151B, 0x152B, 0x153B, 0x154B, 0x155B, 0x156B,
+	0x157B, 0x158B, 0x159B, 0x15AB, 0x15BB, 0x15CB, 0x15DB, 0x15EB,
+	0x15FB, 0x160B, 0x161B, 0x162B, 0x163B, 0x164B, 0x165B, 0x166B,
+	0x167B, 0x168B, 0x169B, 0x16AB, 0x16BB, 0x16CB, 0x16DB, 0x16EB,
+	0x16FB, 0x170B, 0x171B, 0x172B, 0x173B, 0x174B, 0x175B, 0x176B,
+	0x177B, 0x178B, 0x179B, 0x17AB, 0x17BB, 0x17CB, 0x17DB, 0x17EB,
+	0x17FB, 0x180B, 0x181B, 0x182B, 0x183B, 0x184B, 0x185B, 0x186B,
+	0x187B, 0x188B, 0x189B, 0x18AB, 0x18BB, 0x18CB, 0x18DB, 0x18EB,
+	0x18FB, 0x190B, 0x191B, 0x192B, 0x193B, 0x194B, 0x195B, 0x196B,
+	0x197B, 0x198B, 0x199B, 0x19AB, 0x19BB, 0x19CB, 0x19DB, 0x19EB,
+	0x19FB, 0x1A0B, 0x1A1B, 0x1A2B, 0x1A3B, 0x1A4B, 0x1A5B, 0x1A6B,
+	0x1A7B, 0x1A8B, 0x1A9B, 0x1AAB, 0x1ABB, 0x1ACB, 0x1ADB, 0x1AEB,
+	0x1AFB, 0x1B0B, 0x1B1B, 0x1B2B, 0x1B3B, 0x1B4B, 0x1B5B, 0x1B6B,
+	0x1B7B, 0x1B8B, 0x1B9B, 0x1BAB, 0x1BBB, 0x1BCB, 0x1BDB, 0x1BEB,
+	0x1BFB, 0x1C0B, 0x1C1B, 0x1C2B, 0x1C3B, 0x1C4B, 0x1C5B, 0x1C6B,
+	0x1C7B, 0x1C8B, 0x1C9B, 0x1CAB, 0x1CBB, 0x1CCB, 0x1CDB, 0x1CEB,
+	0x1CFB, 0x1D0B, 0x1D1B, 0x1D2B, 0x1D3B, 0x1D4B, 0x1D5B, 0x1D6B,
+	0x1D7B, 0x1D8B, 0x1D9B, 0x1DAB, 0x1DBB, 0x1DCB, 0x1DDB, 0x1DEB,
+	0x1DFB, 0x1E0B, 0x1E1B, 0x1E2B, 0x1E3B, 0x1E4B, 0x1E5B, 0x1E6B,
+	0x1E7B, 0x1E8B, 0x1E9B, 0x1EAB, 0x1EBB, 0x1ECB, 0x1EDB, 0x1EEB,
+	0x1EFB, 0x1F0B, 0x1F1B, 0x1F2B, 0x1F3B, 0x1F4B, 0x1F5B, 0x1F6B,
+	0x1F7B, 0x1F8B, 0x1F9B, 0x1FAB, 0x1FBB, 0x1FCB, 0x1FDB, 0x1FEB,
+	0x1FFB, 0x200B, 0x201B, 0x202B, 0x203B, 0x204B, 0x205B, 0x206B,
+	0x207B, 0x208B, 0x209B, 0x20AB, 0x20BB, 0x20CB, 0x20DB, 0x20EB,
+	0x20FB, 0x210B, 0x211B, 0x212B, 0x213B, 0x214B, 0x215B, 0x216B,
+	0x217B, 0x218B, 0x219B, 0x21AB, 0x21BB, 0x21CB, 0x21DB, 0x21EB,
+	0x21FB, 0x220B, 0x221B, 0x222B, 0x223B, 0x224B, 0x225B, 0x226B,
+	0x227B, 0x228B, 0x229B, 0x22AB, 0x22BB, 0x22CB, 0x22DB, 0x22EB,
+	0x22FB, 0x230B, 0x231B, 0x232B, 0x233B, 0x234B, 0x235B, 0x236B,
+	0x237B, 0x238B, 0x239B, 0x23AB, 0x23BB, 0x23CB, 0x23DB, 0x23EB,
+	0x23FB, 0x240B, 0x241B, 0x242B, 0x243B, 0x244B, 0x245B, 0x246B,
+	0x247B, 0x248B, 0x249B, 0x24AB, 0x24BB, 0x24CB, 0x24DB, 0x24EB,
+	0x24FB, 0x250B, 0x251B, 0x252B, 0x253B, 0x254B, 0x255B, 0x256B,
+	0x257B, 0x258B, 0x259B, 0x25AB, 0x25BB, 0x25CB, 0x25DB, 0x25EB,
+	0x25FB, 0x260B, 0x261B, 0x262B, 0x263B, 0x264B, 0x265B, 0x266B,
+	0x267B, 0x268B, 0x269B, 0x26AB, 0x26BB, 0x26CB, 0x26DB, 0x26EB,
+	0x26FB, 0x270B, 0x271B, 0x272B, 0x273B, 0x274B, 0x275B, 0x276B,
+	0x277B, 0x278B, 0x279B, 0x27AB, 0x27BB, 0x27CB, 0x27DB, 0x27EB,
+	0x27FB, 0x280B, 0x281B, 0x282B, 0x283B, 0x284B, 0x285B, 0x286B,
+	0x287B, 0x288B, 0x289B, 0x28AB, 0x28BB, 0x28CB, 0x28DB, 0x28EB,
+	0x28FB, 0x290B, 0x291B, 0x292B, 0x293B, 0x294B, 0x295B, 0x296B,
+	0x297B, 0x298B, 0x299B, 0x29AB, 0x29BB, 0x29CB, 0x29DB, 0x29EB,
+	0x29FB, 0x2A0B, 0x2A1B, 0x2A2B, 0x2A3B, 0x2A4B, 0x2A5B, 0x2A6B,
+	0x2A7B, 0x2A8B, 0x2A9B, 0x2AAB, 0x2ABB, 0x2ACB, 0x2ADB, 0x2AEB,
+	0x2AFB, 0x2B0B, 0x2B1B, 0x2B2B, 0x2B3B, 0x2B4B, 0x2B5B, 0x2B6B,
+	0x2B7B, 0x2B8B, 0x2B9B, 0x2BAB, 0x2BBB, 0x2BCB, 0x2BDB, 0x2BEB,
+	0x2BFB, 0x2C0B, 0x2C1B, 0x2C2B, 0x2C3B, 0x2C4B, 0x2C5B, 0x2C6B,
+	0x2C7B, 0x2C8B, 0x2C9B, 0x2CAB, 0x2CBB, 0x2CCB, 0x2CDB, 0x2CEB,
+	0x2CFB, 0x2D0B, 0x2D1B, 0x2D2B, 0x2D3B, 0x2D4B, 0x2D5B, 0x2D6B,
+	0x2D7B, 0x2D8B, 0x2D9B, 0x2DAB, 0x2DBB, 0x2DCB, 0x2DDB, 0x2DEB,
+	0x2DFB, 0x2E0B, 0x2E1B, 0x2E2B, 0x2E3B, 0x2E4B, 0x2E5B, 0x2E6B,
+	0x2E7B, 0x2E8B, 0x2E9B, 0x2EAB, 0x2EBB, 0x2ECB, 0x2EDB, 0x2EEB,
+	0x2EFB, 0x2F0B, 0x2F1B, 0x2F2B, 0x2F3B, 0x2F4B, 0x2F5B, 0x2F6B,
+	0x2F7B, 0x2F8B, 0x2F9B, 0x2FAB, 0x2FBB, 0x2FCB, 0x2FDB, 0x2FEB,
+	0x2FFB, 0x300B, 0x301B, 0x302B, 0x303B, 0x304B, 0x305B, 0x306B,
+	0x307B, 0x308B, 0x309B, 0x30AB, 0x30BB, 0x30CB, 0x30DB, 0x30EB,
+	0x30FB, 0x310B, 0x311B, 0x312B, 0x313B, 0x314B, 0x315B, 0x316B,
+	0x317B, 0x318B, 0x319B, 0x31AB, 0x31BB, 0x31CB, 0x31DB, 0x31EB,
+	0x31FB, 0x320B, 0x321B, 0x322B, 0x323B, 0x324B, 0x325B, 0x326B,
+	0x327B, 0x328B, 0x329B, 0x32AB, 0x32BB, 0x32CB, 0x32DB, 0x32EB,
+	0x32FB, 0x330B, 0x331B, 0x332B, 0x333B, 0x334B, 0x335B, 0x336B,
+	0x337B, 0x338B, 0x339B, 0x33AB, 0x33BB, 0x33CB, 0x33DB, 0x33EB,
+	0x33FB, 0x340B, 0x341B, 0x342B, 0x343B, 0x344B, 0x345B, 0x346B,
+	0x347B, 0x348B, 0x349B, 0x34AB, 0x34BB, 0x34CB, 0x34DB, 0x34EB,
+	0x34FB, 0x350B, 0x351B, 0x352B, 0x353B, 0x354B, 0x355B, 0x356B,
+	0x357B, 0x358B, 0x359B, 0x35AB, 0x35BB, 0x35CB, 0x35DB, 0x35EB,
+	0x35FB, 0x360B, 0x361B, 0x362B, 0x363B, 0x364B, 0x365B, 0x366B,
+	0x367B, 0x368B, 0x369B, 0x36AB, 0x36BB, 0x36CB, 0x36DB, 0x36EB,
+	0x36FB, 0x370B, 0x371B, 0x372B, 0x373B, 0x374B, 0x375B, 0x376B,
+	0x377B, 0x378B, 0x379B, 0x37AB, 0x37BB, 0x37CB, 0x37DB, 0x37EB,
+	0x37FB, 0x380B, 0x381B, 0x382B, 0x383B, 0x384B, 0x385B, 0x386B,
+	0x387B, 0x388B, 0x389B, 0x38AB, 0x38BB, 0x38CB, 0x38DB, 0x38EB,
+	0x38FB, 0x390B, 0x391B, 0x392B, 0x393B, 0x394B, 0x395B, 0x396B,
+	0x397B, 0x398B, 0x399B, 0x39AB, 0x39BB, 0x39CB, 0x39DB, 0x39EB,
+	0x39FB, 0x3A0B, 0x3A1B, 0x3A2B, 0x3A3B, 0x3A4B, 0x3A5B, 0x3A6B,
+	0x3A7B, 0x3A8B, 0x3A9B, 0x3AAB, 0x3ABB, 0x3ACB, 0x3ADB, 0x3AEB,
+	0x3AFB, 0x3B0B, 0x3B1B, 0x3B2B, 0x3B3B, 0x3B4B, 0x3B5B, 0x3B6B,
+	0x3B7B, 0x3B8B, 0x3B9B, 0x3BAB, 0x3BBB, 0x3BCB, 0x3BDB, 0x3BEB,
+	0x3BFB, 0x3C0B, 0x3C1B, 0x3C2B, 0x3C3B, 0x3C4B, 0x3C5B, 0x3C6B,
+	0x3C7B, 0x3C8B, 0x3C9B, 0x3CAB, 0x3CBB, 0x3CCB, 0x3CDB, 0x3CEB,
+	0x3CFB, 0x3D0B, 0x3D1B, 0x3D2B, 0x3D3B, 0x3D4B, 0x3D5B, 0x3D6B,
+	0x3D7B, 0x3D8B, 0x3D9B, 0x3DAB, 0x3DBB, 0x3DCB, 0x3DDB, 0x3DEB,
+	0x3DFB, 0x3E0B, 0x3E1B, 0x3E2B, 0x3E3B, 0x3E4B, 0x3E5B, 0x3E6B,
+	0x3E7B, 0x3E8B, 0x3E9B, 0x3EAB, 0x3EBB, 0x3ECB, 0x3EDB, 0x3EEB,
+	0x3EFB, 0x3F0B, 0x3F1B, 0x3F2B, 0x3F3B, 0x3F4B, 0x3F5B, 0x3F6B,
+	0x3F7B, 0x3F8B, 0x3F9B, 0x3FAB, 0x3FBB, 0x3FCB, 0x3FDB, 0x3FEB,
+	0x3FFB, 0x000A, 0x001A, 0x002A, 0x003A, 0x004A, 0x005A, 0x006A,
+	0x007A, 0x008A, 0x009A, 0x00AA, 0x00BA, 0x00CA, 0x00DA, 0x00EA,
+	0x00FA, 0x010A, 0x011A, 0x012A, 0x013A, 0x014A, 0x015A, 0x016A,
+	0x017A, 0x018A, 0x019A, 0x01AA, 0x01BA, 0x01CA, 0x01DA, 0x01EA,
+	0x01FA, 0x020A, 0x021A, 0x022A, 0x023A, 0x024A, 0x025A, 0x026A,
+	0x027A, 0x028A, 0x029A, 0x02AA, 0x02BA, 0x02CA, 0x02DA, 0x02EA,
+	0x02FA, 0x030A, 0x031A, 0x032A, 0x033A, 0x034A, 0x035A, 0x036A,
+	0x037A, 0x038A, 0x039A, 0x03AA, 0x03BA, 0x03CA, 0x03DA, 0x03EA,
+	0x03FA, 0x040A, 0x041A, 0x042A, 0x043A, 0x044A, 0x045A, 0x046A,
+	0x047A, 0x048A, 0x049A, 0x04AA, 0x04BA, 0x04CA, 0x04DA, 0x04EA,
+	0x04FA, 0x050A, 0x051A, 0x052A, 0x053A, 0x054A, 0x055A, 0x056A,
+	0x057A, 0x058A, 0x059A, 0x05AA, 0x05BA, 0x05CA, 0x05DA, 0x05EA,
+	0x05FA, 0x060A, 0x061A, 0x062A, 0x063A, 0x064A, 0x065A, 0x066A,
+	0x067A, 0x068A, 0x069A, 0x06AA, 0x06BA, 0x06CA, 0x06DA, 0x06EA,
+	0x06FA, 0x070A, 0x071A, 0x072A, 0x073A, 0x074A, 0x075A, 0x076A,
+	0x077A, 0x078A, 0x079A, 0x07AA, 0x07BA, 0x07CA, 0x07DA, 0x07EA,
+	0x07FA, 0x080A, 0x081A, 0x082A, 0x083A, 0x084A, 0x085A, 0x086A,
+	0x087A, 0x088A, 0x089A, 0x08AA, 0x08BA, 0x08CA, 0x08DA, 0x08EA,
+	0x08FA, 0x090A, 0x091A, 0x092A, 0x093A, 0x094A, 0x095A, 0x096A,
+	0x097A, 0x098A, 0x099A, 0x09AA, 0x09BA, 0x09CA, 0x09DA, 0x09EA,
+	0x09FA, 0x0A0A, 0x0A1A, 0x0A2A, 0x0A3A, 0x0A4A, 0x0A5A, 0x0A6A,
+	0x0A7A, 0x0A8A, 0x0A9A, 0x0AAA, 0x0ABA, 0x0ACA, 0x0ADA, 0x0AEA,
+	0x0AFA, 0x0B0A, 0x0B1A, 0x0B2A, 0x0B3A, 0x0B4A, 0x0B5A, 0x0B6A,
+	0x0B7A, 0x0B8A, 0x0B9A, 0x0BAA, 0x0BBA, 0x0BCA, 0x0BDA, 0x0BEA,
+	0x0BFA, 0x0C0A, 0x0C1A, 0x0C2A, 0x0C3A, 0x0C4A, 0x0C5A, 0x0C6A,
+	0x0C7A, 0x0C8A, 0x0C9A, 0x0CAA, 0x0CBA, 0x0CCA, 0x0CDA, 0x0CEA,
+	0x0CFA, 0x0D0A, 0x0D1A, 0x0D2A, 0x0D3A, 0x0D4A, 0x0D5A, 0x0D6A,
+	0x0D7A, 0x0D8A, 0x0D9A, 0x0DAA, 0x0DBA, 0x0DCA, 0x0DDA, 0x0DEA,
+	0x0DFA, 0x0E0A, 0x0E1A, 0x0E2A, 0x0E3A, 0x0E4A, 0x0E5A, 0x0E6A,
+	0x0E7A, 0x0E8A, 0x0E9A, 0x0EAA, 0x0EBA, 0x0ECA, 0x0EDA, 0x0EEA,
+	0x0EFA, 0x0F0A, 0x0F1A, 0x0F2A, 0x0F3A, 0x0F4A, 0x0F5A, 0x0F6A,
+	0x0F7A, 0x0F8A, 0x0F9A, 0x0FAA, 0x0FBA, 0x0FCA, 0x0FDA, 0x0FEA,
+	0x0FFA, 0x100A, 0x101A, 0x102A, 0x103A, 0x104A, 0x105A, 0x106A,
+	0x107A, 0x108A, 0x109A, 0x10AA, 0x10BA, 0x10CA, 0x10DA, 0x10EA,
+	0x10FA, 0x110A, 0x111A, 0x112A, 0x113A, 0x114A, 0x115A, 0x116A,
+	0x117A, 0x118A, 0x119A, 0x11AA, 0x11BA, 0x11CA, 0x11DA, 0x11EA,
+	0x11FA, 0x120A, 0x121A, 0x122A, 0x123A, 0x124A, 0x125A, 0x126A,
+	0x127A, 0x128A, 0x129A, 0x12AA, 0x12BA, 0x12CA, 0x12DA, 0x12EA,
+	0x12FA, 0x130A, 0x131A, 0x132A, 0x133A, 0x134A, 0x135A, 0x136A,
+	0x137A, 0x138A, 0x139A, 0x13AA, 0x13BA, 0x13CA, 0x13DA, 0x13EA,
+	0x13FA, 0x140A, 0x141A, 0x142A, 0x143A, 0x144A, 0x145A, 0x146A,
+	0x147A, 0x148A, 0x149A, 0x14AA, 0x14BA, 0x14CA, 0x14DA, 0x14EA,
+	0x14FA, 0x150A, 0x151A, 0x152A, 0x153A, 0x154A, 0x155A, 0x156A,
+	0x157A, 0x158A, 0x159A, 0x15AA, 0x15BA, 0x15CA, 0x15DA, 0x15EA,
+	0x15FA, 0x160A, 0x161A, 0x162A, 0x163A, 0x164A, 0x165A, 0x166A,
+	0x167A, 0x168A, 0x169A, 0x16AA, 0x16BA, 0x16CA, 0x16DA, 0x16EA,
+	0x16FA, 0x170A, 0x171A, 0x172A, 0x173A, 0x174A, 0x175A, 0x176A,
+	0x177A, 0x178A, 0x179A, 0x17AA, 0x17BA, 0x17CA, 0x17DA, 0x17EA,
+	0x17FA, 0x180A, 0x181A, 0x182A, 0x183A, 0x184A, 0x185A, 0x186A,
+	0x187A, 0x188A, 0x189A, 0x18AA, 0x18BA, 0x18CA, 0x18DA, 0x18EA,
+	0x18FA, 0x190A, 0x191A, 0x192A, 0x193A, 0x194A, 0x195A, 0x196A,
+	0x197A, 0x198A, 0x199A, 0x19AA, 0x19BA, 0x19CA, 0x19DA, 0x19EA,
+	0x19FA, 0x1A0A, 0x1A1A, 0x1A2A, 0x1A3A, 0x1A4A, 0x1A5A, 0x1A6A,
+	0x1A7A, 0x1A8A, 0x1A9A, 0x1AAA, 0x1ABA, 0x1ACA, 0x1ADA, 0x1AEA,
+	0x1AFA, 0x1B0A, 0x1B1A, 0x1B2A, 0x1B3A, 0x1B4A, 0x1B5A, 0x1B6A,
+	0x1B7A, 0x1B8A, 0x1B9A, 0x1BAA, 0x1BBA, 0x1BCA, 0x1BDA, 0x1BEA,
+	0x1BFA, 0x1C0A, 0x1C1A, 0x1C2A, 0x1C3A, 0x1C4A, 0x1C5A, 0x1C6A,
+	0x1C7A, 0x1C8A, 0x1C9A, 0x1CAA, 0x1CBA, 0x1CCA, 0x1CDA, 0x1CEA,
+	0x1CFA, 0x1D0A, 0x1D1A, 0x1D2A, 0x1D3A, 0x1D4A, 0x1D5A, 0x1D6A,
+	0x1D7A, 0x1D8A, 0x1D9A, 0x1DAA, 0x1DBA, 0x1DCA, 0x1DDA, 0x1DEA,
+	0x1DFA, 0x1E0A, 0x1E1A, 0x1E2A, 0x1E3A, 0x1E4A, 0x1E5A, 0x1E6A,
+	0x1E7A, 0x1E8A, 0x1E9A, 0x1EAA, 0x1EBA, 0x1ECA, 0x1EDA, 0x1EEA,
+	0x1EFA, 0x1F0A, 0x1F1A, 0x1F2A, 0x1F3A, 0x1F4A, 0x1F5A, 0x1F6A,
+	0x1F7A, 0x1F8A, 0x1F9A, 0x1FAA, 0x1FBA, 0x1FCA, 0x1FDA, 0x1FEA,
+	0x1FFA, 0x0009, 0x0019, 0x0029, 0x0039, 0x0049, 0x0059, 0x0069,
+	0x0079, 0x0089, 0x0099, 0x00A9, 0x00B9, 0x00C9, 0x00D9, 0x00E9,
+	0x00F9, 0x0109, 0x0119, 0x0129, 0x0139, 0x0149, 0x0159, 0x0169,
+	0x0179, 0x0189, 0x0199, 0x01A9, 0x01B9, 0x01C9, 0x01D9, 0x01E9,
+	0x01F9, 0x0209, 0x0219, 0x0229, 0x0239, 0x0249, 0x0259, 0x0269,
+	0x0279, 0x0289, 0x0299, 0x02A9, 0x02B9, 0x02C9, 0x02D9, 0x02E9,
+	0x02F9, 0x0309, 0x0319, 0x0329, 0x0339, 0x0349, 0x0359, 0x0369,
+	0x0379, 0x0389, 0x0399, 0x03A9, 0x03B9, 0x03C9, 0x03D9, 0x03E9,
+	0x03F9, 0x0409, 0x0419, 0x0429, 0x0439, 0x0449, 0x0459, 0x0469,
+	0x0479, 0x0489, 0x0499, 0x04A9, 0x04B9, 0x04C9, 0x04D9, 0x04E9,
+	0x04F9, 0x0509, 0x0519, 0x0529, 0x0539, 0x0549, 0x0559, 0x0569,
+	0x0579, 0x0589, 0x0599, 0x05A9, 0x05B9, 0x05C9, 0x05D9, 0x05E9,
+	0x05F9, 0x0609, 0x0619, 0x0629, 0x0639, 0x0649, 0x0659, 0x0669,
+	0x0679, 0x0689, 0x0699, 0x06A9, 0x06B9, 0x06C9, 0x06D9, 0x06E9,
+	0x06F9, 0x0709, 0x0719, 0x0729, 0x0739, 0x0749, 0x0759, 0x0769,
+	0x0779, 0x0789, 0x0799, 0x07A9, 0x07B9, 0x07C9, 0x07D9, 0x07E9,
+	0x07F9, 0x0809, 0x0819, 0x0829, 0x0839, 0x0849, 0x0859, 0x0869,
+	0x0879, 0x0889, 0x0899, 0x08A9, 0x08B9, 0x08C9, 0x08D9, 0x08E9,
+	0x08F9, 0x0909, 0x0919, 0x0929, 0x0939, 0x0949, 0x0959, 0x0969,
+	0x0979, 0x0989, 0x0999, 0x09A9, 0x09B9, 0x09C9, 0x09D9, 0x09E9,
+	0x09F9, 0x0A09, 0x0A19, 0x0A29, 0x0A39, 0x0A49, 0x0A59, 0x0A69,
+	0x0A79, 0x0A89, 0x0A99, 0x0AA9, 0x0AB9, 0x0AC9, 0x0AD9, 0x0AE9,
+	0x0AF9, 0x0B09, 0x0B19, 0x0B29, 0x0B39, 0x0B49, 0x0B59, 0x0B69,
+	0x0B79, 0x0B89, 0x0B99, 0x0BA9, 0x0BB9, 0x0BC9, 0x0BD9, 0x0BE9,
+	0x0BF9, 0x0C09, 0x0C19, 0x0C29, 0x0C39, 0x0C49, 0x0C59, 0x0C69,
+	0x0C79, 0x0C89, 0x0C99, 0x0CA9, 0x0CB9, 0x0CC9, 0x0CD9, 0x0CE9,
+	0x0CF9, 0x0D09, 0x0D19, 0x0D29, 0x0D39, 0x0D49, 0x0D59, 0x0D69,
+	0x0D79, 0x0D89, 0x0D99, 0x0DA9, 0x0DB9, 0x0DC9, 0x0DD9, 0x0DE9,
+	0x0DF9, 0x0E09, 0x0E19, 0x0E29, 0x0E39, 0x0E49, 0x0E59, 0x0E69,
+	0x0E79, 0x0E89, 0x0E99, 0x0EA9, 0x0EB9, 0x0EC9, 0x0ED9, 0x0EE9,
+	0x0EF9, 0x0F09, 0x0F19, 0x0F29, 0x0F39, 0x0F49, 0x0F59, 0x0F69,
+	0x0F79, 0x0F89, 0x0F99, 0x0FA9, 0x0FB9, 0x0FC9, 0x0FD9, 0x0FE9,
+	0x0FF9, 0x0008, 0x0018, 0x0028, 0x0038, 0x0048, 0x0058, 0x0068,
+	0x0078, 0x0088, 0x0098, 0x00A8, 0x00B8, 0x00C8, 0x00D8, 0x00E8,
+	0x00F8, 0x0108, 0x0118, 0x0128, 0x0138, 0x0148, 0x0158, 0x0168,
+	0x0178, 0x0188, 0x0198, 0x01A8, 0x01B8, 0x01C8, 0x01D8, 0x01E8,
+	0x01F8, 0x0208, 0x0218, 0x0228, 0x0238, 0x0248, 0x0258, 0x0268,
+	0x0278, 0x0288, 0x0298, 0x02A8, 0x02B8, 0x02C8, 0x02D8, 0x02E8,
+	0x02F8, 0x0308, 0x0318, 0x0328, 0x0338, 0x0348, 0x0358, 0x0368,
+	0x0378, 0x0388, 0x0398, 0x03A8, 0x03B8, 0x03C8, 0x03D8, 0x03E8,
+	0x03F8, 0x0408, 0x0418, 0x0428, 0x0438, 0x0448, 0x0458, 0x0468,
+	0x0478, 0x0488, 0x0498, 0x04A8, 0x04B8, 0x04C8, 0x04D8, 0x04E8,
+	0x04F8, 0x0508, 0x0518, 0x0528, 0x0538, 0x0548, 0x0558, 0x0568,
+	0x0578, 0x0588, 0x0598, 0x05A8, 0x05B8, 0x05C8, 0x05D8, 0x05E8,
+	0x05F8, 0x0608, 0x0618, 0x0628, 0x0638, 0x0648, 0x0658, 0x0668,
+	0x0678, 0x0688, 0x0698, 0x06A8, 0x06B8, 0x06C8, 0x06D8, 0x06E8,
+	0x06F8, 0x0708, 0x0718, 0x0728, 0x0738, 0x0748, 0x0758, 0x0768,
+	0x0778, 0x0788, 0x0798, 0x07A8, 0x07B8, 0x07C8, 0x07D8, 0x07E8,
+	0x07F8, 0x0007, 0x0017, 0x0027, 0x0037, 0x0047, 0x0057, 0x0067,
+	0x0077, 0x0087, 0x0097, 0x00A7, 0x00B7, 0x00C7, 0x00D7, 0x00E7,
+	0x00F7, 0x0107, 0x0117, 0x0127, 0x0137, 0x0147, 0x0157, 0x0167,
+	0x0177, 0x0187, 0x0197, 0x01A7, 0x01B7, 0x01C7, 0x01D7, 0x01E7,
+	0x01F7, 0x0207, 0x0217, 0x0227, 0x0237, 0x0247, 0x0257, 0x0267,
+	0x0277, 0x0287, 0x0297, 0x02A7, 0x02B7, 0x02C7, 0x02D7, 0x02E7,
+	0x02F7, 0x0307, 0x0317, 0x0327, 0x0337, 0x0347, 0x0357, 0x0367,
+	0x0377, 0x0387, 0x0397, 0x03A7, 0x03B7, 0x03C7, 0x03D7, 0x03E7,
+	0x03F7, 0x0006, 0x0016, 0x0026, 0x0036, 0x0046, 0x0056, 0x0066,
+	0x0076, 0x0086, 0x0096, 0x00A6, 0x00B6, 0x00C6, 0x00D6, 0x00E6,
+	0x00F6, 0x0106, 0x0116, 0x0126, 0x0136, 0x0146, 0x0156, 0x0166,
+	0x0176, 0x0186, 0x0196, 0x01A6, 0x01B6, 0x01C6, 0x01D6, 0x01E6,
+	0x01F6, 0x0005, 0x0015, 0x0025, 0x0035, 0x0045, 0x0055, 0x0065,
+	0x0075, 0x0085, 0x0095, 0x00A5, 0x00B5, 0x00C5, 0x00D5, 0x00E5,
+	0x00F5, 0x0004, 0x0014, 0x0024, 0x0034, 0x0044, 0x0054, 0x0064,
+	0x0074, 0x0003, 0x0013, 0x0023, 0x0033, 0x0002, 0x0012, 0x0001,
+	0x0000, 0x0011, 0x0022, 0x0032, 0x0043, 0x0053, 0x0063, 0x0073,
+	0x0084, 0x0094, 0x00A4, 0x00B4, 0x00C4, 0x00D4, 0x00E4, 0x00F4,
+	0x0105, 0x0115, 0x0125, 0x0135, 0x0145, 0x0155, 0x0165, 0x0175,
+	0x0185, 0x0195, 0x01A5, 0x01B5, 0x01C5, 0x01D5, 0x01E5, 0x01F5,
+	0x0206, 0x0216, 0x0226, 0x0236, 0x0246, 0x0256, 0x0266, 0x0276,
+	0x0286, 0x0296, 0x02A6, 0x02B6, 0x02C6, 0x02D6, 0x02E6, 0x02F6,
+	0x0306, 0x0316, 0x0326, 0x0336, 0x0346, 0x0356, 0x0366, 0x0376,
+	0x0386, 0x0396, 0x03A6, 0x03B6, 0x03C6, 0x03D6, 0x03E6, 0x03F6,
+	0x0407, 0x0417, 0x0427, 0x0437, 0x0447, 0x0457, 0x0467, 0x0477,
+	0x0487, 0x0497, 0x04A7, 0x04B7, 0x04C7, 0x04D7, 0x04E7, 0x04F7,
+	0x0507, 0x0517, 0x0527, 0x0537, 0x0547, 0x0557, 0x0567, 0x0577,
+	0x0587, 0x0597, 0x05A7, 0x05B7, 0x05C7, 0x05D7, 0x05E7, 0x05F7,
+	0x0607, 0x0617, 0x0627, 0x0637, 0x0647, 0x0657, 0x0667, 0x0677,
+	0x0687, 0x0697, 0x06A7, 0x06B7, 0x06C7, 0x06D7, 0x06E7, 0x06F7,
+	0x0707, 0x0717, 0x0727, 0x0737, 0x0747, 0x0757, 0x0767, 0x0777,
+	0x0787, 0x0797, 0x07A7, 0x07B7, 0x07C7, 0x07D7, 0x07E7, 0x07F7,
+	0x0808, 0x0818, 0x0828, 0x0838, 0x0848, 0x0858, 0x0868, 0x0878,
+	0x0888, 0x0898, 0x08A8, 0x08B8, 0x08C8, 0x08D8, 0x08E8, 0x08F8,
+	0x0908, 0x0918, 0x0928, 0x0938, 0x0948, 0x0958, 0x0968, 0x0978,
+	0x0988, 0x0998, 0x09A8, 0x09B8, 0x09C8, 0x09D8, 0x09E8, 0x09F8,
+	0x0A08, 0x0A18, 0x0A28, 0x0A38, 0x0A48, 0x0A58, 0x0A68, 0x0A78,
+	0x0A88, 0x0A98, 0x0AA8, 0x0AB8, 0x0AC8, 0x0AD8, 0x0AE8, 0x0AF8,
+	0x0B08, 0x0B18, 0x0B28, 0x0B38, 0x0B48, 0x0B58, 0x0B68, 0x0B78,
+	0x0B88, 0x0B98, 0x0BA8, 0x0BB8, 0x0BC8, 0x0BD8, 0x0BE8, 0x0BF8,
+	0x0C08, 0x0C18, 0x0C28, 0x0C38, 0x0C48, 0x0C58, 0x0C68, 0x0C78,
+	0x0C88, 0x0C98, 0x0CA8, 0x0CB8, 0x0CC8, 0x0CD8, 0x0CE8, 0x0CF8,
+	0x0D08, 0x0D18, 0x0D28, 0x0D38, 0x0D48, 0x0D58, 0x0D68, 0x0D78,
+	0x0D88, 0x0D98, 0x0DA8, 0x0DB8, 0x0DC8, 0x0DD8, 0x0DE8, 0x0DF8,
+	0x0E08, 0x0E18, 0x0E28, 0x0E38, 0x0E48, 0x0E58, 0x0E68, 0x0E78,
+	0x0E88, 0x0E98, 0x0EA8, 0x0EB8, 0x0EC8, 0x0ED8, 0x0EE8, 0x0EF8,
+	0x0F08, 0x0F18, 0x0F28, 0x0F38, 0x0F48, 0x0F58, 0x0F68, 0x0F78,
+	0x0F88, 0x0F98, 0x0FA8, 0x0FB8, 0x0FC8, 0x0FD8, 0x0FE8, 0x0FF8,
+	0x1009, 0x1019, 0x1029, 0x1039, 0x1049, 0x1059, 0x1069, 0x1079,
+	0x1089, 0x1099, 0x10A9, 0x10B9, 0x10C9, 0x10D9, 0x10E9, 0x10F9,
+	0x1109, 0x1119, 0x1129, 0x1139, 0x1149, 0x1159, 0x1169, 0x1179,
+	0x1189, 0x1199, 0x11A9, 0x11B9, 0x11C9, 0x11D9, 0x11E9, 0x11F9,
+	0x1209, 0x1219, 0x1229, 0x1239, 0x1249, 0x1259, 0x1269, 0x1279,
+	0x1289, 0x1299, 0x12A9, 0x12B9, 0x12C9, 0x12D9, 0x12E9, 0x12F9,
+	0x1309, 0x1319, 0x1329, 0x1339, 0x1349, 0x1359, 0x1369, 0x1379,
+	0x1389, 0x1399, 0x13A9, 0x13B9, 0x13C9, 0x13D9, 0x13E9, 0x13F9,
+	0x1409, 0x1419, 0x1429, 0x1439, 0x1449, 0x1459, 0x1469, 0x1479,
+	0x1489, 0x1499, 0x14A9, 0x14B9, 0x14C9, 0x14D9, 0x14E9, 0x14F9,
+	0x1509, 0x1519, 0x1529, 0x1539, 0x1549, 0x1559, 0x1569, 0x1579,
+	0x1589, 0x1599, 0x15A9, 0x15B9, 0x15C9, 0x15D9, 0x15E9, 0x15F9,
+	0x1609, 0x1619, 0x1629, 0x1639, 0x1649, 0x1659, 0x1669, 0x1679,
+	0x1689, 0x1699, 0x16A9, 0x16B9, 0x16C9, 0x16D9, 0x16E9, 0x16F9,
+	0x1709, 0x1719, 0x1729, 0x1739, 0x1749, 0x1759, 0x1769, 0x1779,
+	0x1789, 0x1799, 0x17A9, 0x17B9, 0x17C9, 0x17D9, 0x17E9, 0x17F9,
+	0x1809, 0x1819, 0x1829, 0x1839, 0x1849, 0x1859, 0x1869, 0x1879,
+	0x1889, 0x1899, 0x18A9, 0x18B9, 0x18C9, 0x18D9, 0x18E9, 0x18F9,
+	0x1909, 0x1919, 0x1929, 0x1939, 0x1949, 0x1959, 0x1969, 0x1979,
+	0x1989, 0x1999, 0x19A9, 0x19B9, 0x19C9, 0x19D9, 0x19E9, 0x19F9,
+	0x1A09, 0x1A19, 0x1A29, 0x1A39, 0x1A49, 0x1A59, 0x1A69, 0x1A79,
+	0x1A89, 0x1A99, 0x1AA9, 0x1AB9, 0x1AC9, 0x1AD9, 0x1AE9, 0x1AF9,
+	0x1B09, 0x1B19, 0x1B29, 0x1B39, 0x1B49, 0x1B59, 0x1B69, 0x1B79,
+	0x1B89, 0x1B99, 0x1BA9, 0x1BB9, 0x1BC9, 0x1BD9, 0x1BE9, 0x1BF9,
+	0x1C09, 0x1C19, 0x1C29, 0x1C39, 0x1C49, 0x1C59, 0x1C69, 0x1C79,
+	0x1C89, 0x1C99, 0x1CA9, 0x1CB9, 0x1CC9, 0x1CD9, 0x1CE9, 0x1CF9,
+	0x1D09, 0x1D19, 0x1D29, 0x1D39, 0x1D49, 0x1D59, 0x1D69, 0x1D79,
+	0x1D89, 0x1D99, 0x1DA9, 0x1DB9, 0x1DC9, 0x1DD9, 0x1DE9, 0x1DF9,
+	0x1E09, 0x1E19, 0x1E29, 0x1E39, 0x1E49, 0x1E59, 0x1E69, 0x1E79,
+	0x1E89, 0x1E99, 0x1EA9, 0x1EB9, 0x1EC9, 0x1ED9, 0x1EE9, 0x1EF9,
+	0x1F09, 0x1F19, 0x1F29, 0x1F39, 0x1F49, 0x1F59, 0x1F69, 0x1F79,
+	0x1F89, 0x1F99, 0x1FA9, 0x1FB9, 0x1FC9, 0x1FD9, 0x1FE9, 0x1FF9,
+	0x200A, 0x201A, 0x202A, 0x203A, 0x204A, 0x205A, 0x206A, 0x207A,
+	0x208A, 0x209A, 0x20AA, 0x20BA, 0x20CA, 0x20DA, 0x20EA, 0x20FA,
+	0x210A, 0x211A, 0x212A, 0x213A, 0x214A, 0x215A, 0x216A, 0x217A,
+	0x218A, 0x219A, 0x21AA, 0x21BA, 0x21CA, 0x21DA, 0x21EA, 0x21FA,
+	0x220A, 0x221A, 0x222A, 0x223A, 0x224A, 0x225A, 0x226A, 0x227A,
+	0x228A, 0x229A, 0x22AA, 0x22BA, 0x22CA, 0x22DA, 0x22EA, 0x22FA,
+	0x230A, 0x231A, 0x232A, 0x233A, 0x234A, 0x235A, 0x236A, 0x237A,
+	0x238A, 0x239A, 0x23AA, 0x23BA, 0x23CA, 0x23DA, 0x23EA, 0x23FA,
+	0x240A, 0x241A, 0x242A, 0x243A, 0x244A, 0x245A, 0x246A, 0x247A,
+	0x248A, 0x249A, 0x24AA, 0x24BA, 0x24CA, 0x24DA, 0x24EA, 0x24FA,
+	0x250A, 0x251A, 0x252A, 0x253A, 0x254A, 0x255A, 0x256A, 0x257A,
+	0x258A, 0x259A, 0x25AA, 0x25BA, 0x25CA, 0x25DA, 0x25EA, 0x25FA,
+	0x260A, 0x261A, 0x262A, 0x263A, 0x264A, 0x265A, 0x266A, 0x267A,
+	0x268A, 0x269A, 0x26AA, 0x26BA, 0x26CA, 0x26DA, 0x26EA, 0x26FA,
+	0x270A, 0x271A, 0x272A, 0x273A, 0x274A, 0x275A, 0x276A, 0x277A,
+	0x278A, 0x279A, 0x27AA, 0x27BA, 0x27CA, 0x27DA, 0x27EA, 0x27FA,
+	0x280A, 0x281A, 0x282A, 0x283A, 0x284A, 0x285A, 0x286A, 0x287A,
+	0x288A, 0x289A, 0x28AA, 0x28BA, 0x28CA, 0x28DA, 0x28EA, 0x28FA,
+	0x290A, 0x291A, 0x292A, 0x293A, 0x294A, 0x295A, 0x296A, 0x297A,
+	0x298A, 0x299A, 0x29AA, 0x29BA, 0x29CA, 0x29DA, 0x29EA, 0x29FA,
+	0x2A0A, 0x2A1A, 0x2A2A, 0x2A3A, 0x2A4A, 0x2A5A, 0x2A6A, 0x2A7A,
+	0x2A8A, 0x2A9A, 0x2AAA, 0x2ABA, 0x2ACA, 0x2ADA, 0x2AEA, 0x2AFA,
+	0x2B0A, 0x2B1A, 0x2B2A, 0x2B3A, 0x2B4A, 0x2B5A, 0x2B6A, 0x2B7A,
+	0x2B8A, 0x2B9A, 0x2BAA, 0x2BBA, 0x2BCA, 0x2BDA, 0x2BEA, 0x2BFA,
+	0x2C0A, 0x2C1A, 0x2C2A, 0x2C3A, 0x2C4A, 0x2C5A, 0x2C6A, 0x2C7A,
+	0x2C8A, 0x2C9A, 0x2CAA, 0x2CBA, 0x2CCA, 0x2CDA, 0x2CEA, 0x2CFA,
+	0x2D0A, 0x2D1A, 0x2D2A, 0x2D3A, 0x2D4A, 0x2D5A, 0x2D6A, 0x2D7A,
+	0x2D8A, 0x2D9A, 0x2DAA, 0x2DBA, 0x2DCA, 0x2DDA, 0x2DEA, 0x2DFA,
+	0x2E0A, 0x2E1A, 0x2E2A, 0x2E3A, 0x2E4A, 0x2E5A, 0x2E6A, 0x2E7A,
+	0x2E8A, 0x2E9A, 0x2EAA, 0x2EBA, 0x2ECA, 0x2EDA, 0x2EEA, 0x2EFA,
+	0x2F0A, 0x2F1A, 0x2F2A, 0x2F3A, 0x2F4A, 0x2F5A, 0x2F6A, 0x2F7A,
+	0x2F8A, 0x2F9A, 0x2FAA, 0x2FBA, 0x2FCA, 0x2FDA, 0x2FEA, 0x2FFA,
+	0x300A, 0x301A, 0x302A, 0x303A, 0x304A, 0x305A, 0x306A, 0x307A,
+	0x308A, 0x309A, 0x30AA, 0x30BA, 0x30CA, 0x30DA, 0x30EA, 0x30FA,
+	0x310A, 0x311A, 0x312A, 0x313A, 0x314A, 0x315A, 0x316A, 0x317A,
+	0x318A, 0x319A, 0x31AA, 0x31BA, 0x31CA, 0x31DA, 0x31EA, 0x31FA,
+	0x320A, 0x321A, 0x322A, 0x323A, 0x324A, 0x325A, 0x326A, 0x327A,
+	0x328A, 0x329A, 0x32AA, 0x32BA, 0x32CA, 0x32DA, 0x32EA, 0x32FA,
+	0x330A, 0x331A, 0x332A, 0x333A, 0x334A, 0x335A, 0x336A, 0x337A,
+	0x338A, 0x339A, 0x33AA, 0x33BA, 0x33CA, 0x33DA, 0x33EA, 0x33FA,
+	0x340A, 0x341A, 0x342A, 0x343A, 0x344A, 0x345A, 0x346A, 0x347A,
+	0x348A, 0x349A, 0x34AA, 0x34BA, 0x34CA, 0x34DA, 0x34EA, 0x34FA,
+	0x350A, 0x351A, 0x352A, 0x353A, 0x354A, 0x355A, 0x356A, 0x357A,
+	0x358A, 0x359A, 0x35AA, 0x35BA, 0x35CA, 0x35DA, 0x35EA, 0x35FA,
+	0x360A, 0x361A, 0x362A, 0x363A, 0x364A, 0x365A, 0x366A, 0x367A,
+	0x368A, 0x369A, 0x36AA, 0x36BA, 0x36CA, 0x36DA, 0x36EA, 0x36FA,
+	0x370A, 0x371A, 0x372A, 0x373A, 0x374A, 0x375A, 0x376A, 0x377A,
+	0x378A, 0x379A, 0x37AA, 0x37BA, 0x37CA, 0x37DA, 0x37EA, 0x37FA,
+	0x380A, 0x381A, 0x382A, 0x383A, 0x384A, 0x385A, 0x386A, 0x387A,
+	0x388A, 0x389A, 0x38AA, 0x38BA, 0x38CA, 0x38DA, 0x38EA, 0x38FA,
+	0x390A, 0x391A, 0x392A, 0x393A, 0x394A, 0x395A, 0x396A, 0x397A,
+	0x398A, 0x399A, 0x39AA, 0x39BA, 0x39CA, 0x39DA, 0x39EA, 0x39FA,
+	0x3A0A, 0x3A1A, 0x3A2A, 0x3A3A, 0x3A4A, 0x3A5A, 0x3A6A, 0x3A7A,
+	0x3A8A, 0x3A9A, 0x3AAA, 0x3ABA, 0x3ACA, 0x3ADA, 0x3AEA, 0x3AFA,
+	0x3B0A, 0x3B1A, 0x3B2A, 0x3B3A, 0x3B4A, 0x3B5A, 0x3B6A, 0x3B7A,
+	0x3B8A, 0x3B9A, 0x3BAA, 0x3BBA, 0x3BCA, 0x3BDA, 0x3BEA, 0x3BFA,
+	0x3C0A, 0x3C1A, 0x3C2A, 0x3C3A, 0x3C4A, 0x3C5A, 0x3C6A, 0x3C7A,
+	0x3C8A, 0x3C9A, 0x3CAA, 0x3CBA, 0x3CCA, 0x3CDA, 0x3CEA, 0x3CFA,
+	0x3D0A, 0x3D1A, 0x3D2A, 0x3D3A, 0x3D4A, 0x3D5A, 0x3D6A, 0x3D7A,
+	0x3D8A, 0x3D9A, 0x3DAA, 0x3DBA, 0x3DCA, 0x3DDA, 0x3DEA, 0x3DFA,
+	0x3E0A, 0x3E1A, 0x3E2A, 0x3E3A, 0x3E4A, 0x3E5A, 0x3E6A, 0x3E7A,
+	0x3E8A, 0x3E9A, 0x3EAA, 0x3EBA, 0x3ECA, 0x3EDA, 0x3EEA, 0x3EFA,
+	0x3F0A, 0x3F1A, 0x3F2A, 0x3F3A, 0x3F4A, 0x3F5A, 0x3F6A, 0x3F7A,
+	0x3F8A, 0x3F9A, 0x3FAA, 0x3FBA, 0x3FCA, 0x3FDA, 0x3FEA, 0x3FFA,
+	0x400B, 0x401B, 0x402B, 0x403B, 0x404B, 0x405B, 0x406B, 0x407B,
+	0x408B, 0x409B, 0x40AB, 0x40BB, 0x40CB, 0x40DB, 0x40EB, 0x40FB,
+	0x410B, 0x411B, 0x412B, 0x413B, 0x414B, 0x415B, 0x416B, 0x417B,
+	0x418B, 0x419B, 0x41AB, 0x41BB, 0x41CB, 0x41DB, 0x41EB, 0x41FB,
+	0x420B, 0x421B, 0x422B, 0x423B, 0x424B, 0x425B, 0x426B, 0x427B,
+	0x428B, 0x429B, 0x42AB, 0x42BB, 0x42CB, 0x42DB, 0x42EB, 0x42FB,
+	0x430B, 0x431B, 0x432B, 0x433B, 0x434B, 0x435B, 0x436B, 0x437B,
+	0x438B, 0x439B, 0x43AB, 0x43BB, 0x43CB, 0x43DB, 0x43EB, 0x43FB,
+	0x440B, 0x441B, 0x442B, 0x443B, 0x444B, 0x445B, 0x446B, 0x447B,
+	0x448B, 0x449B, 0x44AB, 0x44BB, 0x44CB, 0x44DB, 0x44EB, 0x44FB,
+	0x450B, 0x451B, 0x452B, 0x453B, 0x454B, 0x455B, 0x456B, 0x457B,
+	0x458B, 0x459B, 0x45AB, 0x45BB, 0x45CB, 0x45DB, 0x45EB, 0x45FB,
+	0x460B, 0x461B, 0x462B, 0x463B, 0x464B, 0x465B, 0x466B, 0x467B,
+	0x468B, 0x469B, 0x46AB, 0x46BB, 0x46CB, 0x46DB, 0x46EB, 0x46FB,
+	0x470B, 0x471B, 0x472B, 0x473B, 0x474B, 0x475B, 0x476B, 0x477B,
+	0x478B, 0x479B, 0x47AB, 0x47BB, 0x47CB, 0x47DB, 0x47EB, 0x47FB,
+	0x480B, 0x481B, 0x482B, 0x483B, 0x484B, 0x485B, 0x486B, 0x487B,
+	0x488B, 0x489B, 0x48AB, 0x48BB, 0x48CB, 0x48DB, 0x48EB, 0x48FB,
+	0x490B, 0x491B, 0x492B, 0x493B, 0x494B, 0x495B, 0x496B, 0x497B,
+	0x498B, 0x499B, 0x49AB, 0x49BB, 0x49CB, 0x49DB, 0x49EB, 0x49FB,
+	0x4A0B, 0x4A1B, 0x4A2B, 0x4A3B, 0x4A4B, 0x4A5B, 0x4A6B, 0x4A7B,
+	0x4A8B, 0x4A9B, 0x4AAB, 0x4ABB, 0x4ACB, 0x4ADB, 0x4AEB, 0x4AFB,
+	0x4B0B, 0x4B1B, 0x4B2B, 0x4B3B, 0x4B4B, 0x4B5B, 0x4B6B, 0x4B7B,
+	0x4B8B, 0x4B9B, 0x4BAB, 0x4BBB, 0x4BCB, 0x4BDB, 0x4BEB, 0x4BFB,
+	0x4C0B, 0x4C1B, 0x4C2B, 0x4C3B, 0x4C4B, 0x4C5B, 0x4C6B, 0x4C7B,
+	0x4C8B, 0x4C9B, 0x4CAB, 0x4CBB, 0x4CCB, 0x4CDB, 0x4CEB, 0x4CFB,
+	0x4D0B, 0x4D1B, 0x4D2B, 0x4D3B, 0x4D4B, 0x4D5B, 0x4D6B, 0x4D7B,
+	0x4D8B, 0x4D9B, 0x4DAB, 0x4DBB, 0x4DCB, 0x4DDB, 0x4DEB, 0x4DFB,
+	0x4E0B, 0x4E1B, 0x4E2B, 0x4E3B, 0x4E4B, 0x4E5B, 0x4E6B, 0x4E7B,
+	0x4E8B, 0x4E9B, 0x4EAB, 0x4EBB, 0x4ECB, 0x4EDB, 0x4EEB, 0x4EFB,
+	0x4F0B, 0x4F1B, 0x4F2B, 0x4F3B, 0x4F4B, 0x4F5B, 0x4F6B, 0x4F7B,
+	0x4F8B, 0x4F9B, 0x4FAB, 0x4FBB, 0x4FCB, 0x4FDB, 0x4FEB, 0x4FFB,
+	0x500B, 0x501B, 0x502B, 0x503B, 0x504B, 0x505B, 0x506B, 0x507B,
+	0x508B, 0x509B, 0x50AB, 0x50BB, 0x50CB, 0x50DB, 0x50EB, 0x50FB,
+	0x510B, 0x511B, 0x512B, 0x513B, 0x514B, 0x515B, 0x516B, 0x517B,
+	0x518B, 0x519B, 0x51AB, 0x51BB, 0x51CB, 0x51DB, 0x51EB, 0x51FB,
+	0x520B, 0x521B, 0x522B, 0x523B, 0x524B, 0x525B, 0x526B, 0x527B,
+	0x528B, 0x529B, 0x52AB, 0x52BB, 0x52CB, 0x52DB, 0x52EB, 0x52FB,
+	0x530B, 0x531B, 0x532B, 0x533B, 0x534B, 0x535B, 0x536B, 0x537B,
+	0x538B, 0x539B, 0x53AB, 0x53BB, 0x53CB, 0x53DB, 0x53EB, 0x53FB,
+	0x540B, 0x541B, 0x542B, 0x543B, 0x544B, 0x545B, 0x546B, 0x547B,
+	0x548B, 0x549B, 0x54AB, 0x54BB, 0x54CB, 0x54DB, 0x54EB, 0x54FB,
+	0x550B, 0x551B, 0x552B, 0x553B, 0x554B, 0x555B, 0x556B, 0x557B,
+	0x558B, 0x559B, 0x55AB, 0x55BB, 0x55CB, 0x55DB, 0x55EB, 0x55FB,
+	0x560B, 0x561B, 0x562B, 0x563B, 0x564B, 0x565B, 0x566B, 0x567B,
+	0x568B, 0x569B, 0x56AB, 0x56BB, 0x56CB, 0x56DB, 0x56EB, 0x56FB,
+	0x570B, 0x571B, 0x572B, 0x573B, 0x574B, 0x575B, 0x576B, 0x577B,
+	0x578B, 0x579B, 0x57AB, 0x57BB, 0x57CB, 0x57DB, 0x57EB, 0x57FB,
+	0x580B, 0x581B, 0x582B, 0x583B, 0x584B, 0x585B, 0x586B, 0x587B,
+	0x588B, 0x589B, 0x58AB, 0x58BB, 0x58CB, 0x58DB, 0x58EB, 0x58FB,
+	0x590B, 0x591B, 0x592B, 0x593B, 0x594B, 0x595B, 0x596B, 0x597B,
+	0x598B, 0x599B, 0x59AB, 0x59BB, 0x59CB, 0x59DB, 0x59EB, 0x59FB,
+	0x5A0B, 0x5A1B, 0x5A2B, 0x5A3B, 0x5A4B, 0x5A5B, 0x5A6B, 0x5A7B,
+	0x5A8B, 0x5A9B, 0x5AAB, 0x5ABB, 0x5ACB, 0x5ADB, 0x5AEB, 0x5AFB,
+	0x5B0B, 0x5B1B, 0x5B2B, 0x5B3B, 0x5B4B, 0x5B5B, 0x5B6B, 0x5B7B,
+	0x5B8B, 0x5B9B, 0x5BAB, 0x5BBB, 0x5BCB, 0x5BDB, 0x5BEB, 0x5BFB,
+	0x5C0B, 0x5C1B, 0x5C2B, 0x5C3B, 0x5C4B, 0x5C5B, 0x5C6B, 0x5C7B,
+	0x5C8B, 0x5C9B, 0x5CAB, 0x5CBB, 0x5CCB, 0x5CDB, 0x5CEB, 0x5CFB,
+	0x5D0B, 0x5D1B, 0x5D2B, 0x5D3B, 0x5D4B, 0x5D5B, 0x5D6B, 0x5D7B,
+	0x5D8B, 0x5D9B, 0x5DAB, 0x5DBB, 0x5DCB, 0x5DDB, 0x5DEB, 0x5DFB,
+	0x5E0B, 0x5E1B, 0x5E2B, 0x5E3B, 0x5E4B, 0x5E5B, 0x5E6B, 0x5E7B,
+	0x5E8B, 0x5E9B, 0x5EAB, 0x5EBB, 0x5ECB, 0x5EDB, 0x5EEB, 0x5EFB,
+	0x5F0B, 0x5F1B, 0x5F2B, 0x5F3B, 0x5F4B, 0x5F5B, 0x5F6B, 0x5F7B,
+	0x5F8B, 0x5F9B, 0x5FAB, 0x5FBB, 0x5FCB, 0x5FDB, 0x5FEB, 0x5FFB,
+	0x600B, 0x601B, 0x602B, 0x603B, 0x604B, 0x605B, 0x606B, 0x607B,
+	0x608B, 0x609B, 0x60AB, 0x60BB, 0x60CB, 0x60DB, 0x60EB, 0x60FB,
+	0x610B, 0x611B, 0x612B, 0x613B, 0x614B, 0x615B, 0x616B, 0x617B,
+	0x618B, 0x619B, 0x61AB, 0x61BB, 0x61CB, 0x61DB, 0x61EB, 0x61FB,
+	0x620B, 0x621B, 0x622B, 0x623B, 0x624B, 0x625B, 0x626B, 0x627B,
+	0x628B, 0x629B, 0x62AB, 0x62BB, 0x62CB, 0x62DB, 0x62EB, 0x62FB,
+	0x630B, 0x631B, 0x632B, 0x633B, 0x634B, 0x635B, 0x636B, 0x637B,
+	0x638B, 0x639B, 0x63AB, 0x63BB, 0x63CB, 0x63DB, 0x63EB, 0x63FB,
+	0x640B, 0x641B, 0x642B, 0x643B, 0x644B, 0x645B, 0x646B, 0x647B,
+	0x648B, 0x649B, 0x64AB, 0x64BB, 0x64CB, 0x64DB, 0x64EB, 0x64FB,
+	0x650B, 0x651B, 0x652B, 0x653B, 0x654B, 0x655B, 0x656B, 0x657B,
+	0x658B, 0x659B, 0x65AB, 0x65BB, 0x65CB, 0x65DB, 0x65EB, 0x65FB,
+	0x660B, 0x661B, 0x662B, 0x663B, 0x664B, 0x665B, 0x666B, 0x667B,
+	0x668B, 0x669B, 0x66AB, 0x66BB, 0x66CB, 0x66DB, 0x66EB, 0x66FB,
+	0x670B, 0x671B, 0x672B, 0x673B, 0x674B, 0x675B, 0x676B, 0x677B,
+	0x678B, 0x679B, 0x67AB, 0x67BB, 0x67CB, 0x67DB, 0x67EB, 0x67FB,
+	0x680B, 0x681B, 0x682B, 0x683B, 0x684B, 0x685B, 0x686B, 0x687B,
+	0x688B, 0x689B, 0x68AB, 0x68BB, 0x68CB, 0x68DB, 0x68EB, 0x68FB,
+	0x690B, 0x691B, 0x692B, 0x693B, 0x694B, 0x695B, 0x696B, 0x697B,
+	0x698B, 0x699B, 0x69AB, 0x69BB, 0x69CB, 0x69DB, 0x69EB, 0x69FB,
+	0x6A0B, 0x6A1B, 0x6A2B, 0x6A3B, 0x6A4B, 0x6A5B, 0x6A6B, 0x6A7B,
+	0x6A8B, 0x6A9B, 0x6AAB, 0x6ABB, 0x6ACB, 0x6ADB, 0x6AEB, 0x6AFB,
+	0x6B0B, 0x6B1B, 0x6B2B, 0x6B3B, 0x6B4B, 0x6B5B, 0x6B6B, 0x6B7B,
+	0x6B8B, 0x6B9B, 0x6BAB, 0x6BBB, 0x6BCB, 0x6BDB, 0x6BEB, 0x6BFB,
+	0x6C0B, 0x6C1B, 0x6C2B, 0x6C3B, 0x6C4B, 0x6C5B, 0x6C6B, 0x6C7B,
+	0x6C8B, 0x6C9B, 0x6CAB, 0x6CBB, 0x6CCB, 0x6CDB, 0x6CEB, 0x6CFB,
+	0x6D0B, 0x6D1B, 0x6D2B, 0x6D3B, 0x6D4B, 0x6D5B, 0x6D6B, 0x6D7B,
+	0x6D8B, 0x6D9B, 0x6DAB, 0x6DBB, 0x6DCB, 0x6DDB, 0x6DEB, 0x6DFB,
+	0x6E0B, 0x6E1B, 0x6E2B, 0x6E3B, 0x6E4B, 0x6E5B, 0x6E6B, 0x6E7B,
+	0x6E8B, 0x6E9B, 0x6EAB, 0x6EBB, 0x6ECB, 0x6EDB, 0x6EEB, 0x6EFB,
+	0x6F0B, 0x6F1B, 0x6F2B, 0x6F3B, 0x6F4B, 0x6F5B, 0x6F6B, 0x6F7B,
+	0x6F8B, 0x6F9B, 0x6FAB, 0x6FBB, 0x6FCB, 0x6FDB, 0x6FEB, 0x6FFB,
+	0x700B, 0x701B, 0x702B, 0x703B, 0x704B, 0x705B, 0x706B, 0x707B,
+	0x708B, 0x709B, 0x70AB, 0x70BB, 0x70CB, 0x70DB, 0x70EB, 0x70FB,
+	0x710B, 0x711B, 0x712B, 0x713B, 0x714B, 0x715B, 0x716B, 0x717B,
+	0x718B, 0x719B, 0x71AB, 0x71BB, 0x71CB, 0x71DB, 0x71EB, 0x71FB,
+	0x720B, 0x721B, 0x722B, 0x723B, 0x724B, 0x725B, 0x726B, 0x727B,
+	0x728B, 0x729B, 0x72AB, 0x72BB, 0x72CB, 0x72DB, 0x72EB, 0x72FB,
+	0x730B, 0x731B, 0x732B, 0x733B, 0x734B, 0x735B, 0x736B, 0x737B,
+	0x738B, 0x739B, 0x73AB, 0x73BB, 0x73CB, 0x73DB, 0x73EB, 0x73FB,
+	0x740B, 0x741B, 0x742B, 0x743B, 0x744B, 0x745B, 0x746B, 0x747B,
+	0x748B, 0x749B, 0x74AB, 0x74BB, 0x74CB, 0x74DB, 0x74EB, 0x74FB,
+	0x750B, 0x751B, 0x752B, 0x753B, 0x754B, 0x755B, 0x756B, 0x757B,
+	0x758B, 0x759B, 0x75AB, 0x75BB, 0x75CB, 0x75DB, 0x75EB, 0x75FB,
+	0x760B, 0x761B, 0x762B, 0x763B, 0x764B, 0x765B, 0x766B, 0x767B,
+	0x768B, 0x769B, 0x76AB, 0x76BB, 0x76CB, 0x76DB, 0x76EB, 0x76FB,
+	0x770B, 0x771B, 0x772B, 0x773B, 0x774B, 0x775B, 0x776B, 0x777B,
+	0x778B, 0x779B, 0x77AB, 0x77BB, 0x77CB, 0x77DB, 0x77EB, 0x77FB,
+	0x780B, 0x781B, 0x782B, 0x783B, 0x784B, 0x785B, 0x786B, 0x787B,
+	0x788B, 0x789B, 0x78AB, 0x78BB, 0x78CB, 0x78DB, 0x78EB, 0x78FB,
+	0x790B, 0x791B, 0x792B, 0x793B, 0x794B, 0x795B, 0x796B, 0x797B,
+	0x798B, 0x799B, 0x79AB, 0x79BB, 0x79CB, 0x79DB, 0x79EB, 0x79FB,
+	0x7A0B, 0x7A1B, 0x7A2B, 0x7A3B, 0x7A4B, 0x7A5B, 0x7A6B, 0x7A7B,
+	0x7A8B, 0x7A9B, 0x7AAB, 0x7ABB, 0x7ACB, 0x7ADB, 0x7AEB, 0x7AFB,
+	0x7B0B, 0x7B1B, 0x7B2B, 0x7B3B, 0x7B4B, 0x7B5B, 0x7B6B, 0x7B7B,
+	0x7B8B, 0x7B9B, 0x7BAB, 0x7BBB, 0x7BCB, 0x7BDB, 0x7BEB, 0x7BFB,
+	0x7C0B, 0x7C1B, 0x7C2B, 0x7C3B, 0x7C4B, 0x7C5B, 0x7C6B, 0x7C7B,
+	0x7C8B, 0x7C9B, 0x7CAB, 0x7CBB, 0x7CCB, 0x7CDB, 0x7CEB, 0x7CFB,
+	0x7D0B, 0x7D1B, 0x7D2B, 0x7D3B, 0x7D4B, 0x7D5B, 0x7D6B, 0x7D7B,
+	0x7D8B, 0x7D9B, 0x7DAB, 0x7DBB, 0x7DCB, 0x7DDB, 0x7DEB, 0x7DFB,
+	0x7E0B, 0x7E1B, 0x7E2B, 0x7E3B, 0x7E4B, 0x7E5B, 0x7E6B, 0x7E7B,
+	0x7E8B, 0x7E9B, 0x7EAB, 0x7EBB, 0x7ECB, 0x7EDB, 0x7EEB, 0x7EFB,
+	0x7F0B, 0x7F1B, 0x7F2B, 0x7F3B, 0x7F4B, 0x7F5B, 0x7F6B, 0x7F7B,
+	0x7F8B, 0x7F9B, 0x7FAB, 0x7FBB, 0x7FCB, 0x7FDB, 0x7FEB, 0x7FFB
 };
 
 #endif
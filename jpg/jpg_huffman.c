@@ -20,42 +20,59 @@
 #include "jpg.h"
 #include "jpg_huffdata.h"
 
+/* Write the upper 32 bits of the bit buffer once it holds at least 32. At most 27 bits are put at a time,
+ * so the 64 bit buffer never overflows. */
 #define PUTBITS	\
 {	\
-	bits_in_next_word = (int16) (bitindex + numbits - 32);	\
-	if (bits_in_next_word < 0)	\
+	lcode = (lcode << numbits) | data;	\
+	bitindex += numbits;	\
+	if (bitindex >= 32)	\
 	{	\
-		lcode = (lcode << numbits) | data;	\
-		bitindex += numbits;	\
-	}	\
-	else	\
-	{	\
-		lcode = (lcode << (32 - bitindex)) | (data >> bits_in_next_word);	\
-		if ((*output_ptr++ = (uint8)(lcode >> 24)) == 0xff)	\
-			*output_ptr++ = 0;	\
-		if ((*output_ptr++ = (uint8)(lcode >> 16)) == 0xff)	\
-			*output_ptr++ = 0;	\
-		if ((*output_ptr++ = (uint8)(lcode >> 8)) == 0xff)	\
-			*output_ptr++ = 0;	\
-		if ((*output_ptr++ = (uint8) lcode) == 0xff)	\
-			*output_ptr++ = 0;	\
-		lcode = data;	\
-		bitindex = bits_in_next_word;	\
+		bitindex -= 32;	\
+		output_ptr = write_word (output_ptr, (uint32) (lcode >> bitindex));	\
 	}	\
 }
 
+/* Write 32 bits of the bit stream. Only if one of the bytes is 0xff, the bytes are written one by one to stuff a 0 after it. */
+static inline uint8* write_word (uint8 *output_ptr, uint32 word)
+{
+	uint32 inverted = ~word;
+
+	/* A byte of 0xff is a zero byte of the inverted word */
+	if (((inverted - 0x01010101) & ~inverted & 0x80808080) == 0)
+	{
+		output_ptr [0] = (uint8) (word >> 24);
+		output_ptr [1] = (uint8) (word >> 16);
+		output_ptr [2] = (uint8) (word >> 8);
+		output_ptr [3] = (uint8) word;
+		return output_ptr + 4;
+	}
+
+	if ((*output_ptr++ = (uint8) (word >> 24)) == 0xff)
+		*output_ptr++ = 0;
+	if ((*output_ptr++ = (uint8) (word >> 16)) == 0xff)
+		*output_ptr++ = 0;
+	if ((*output_ptr++ = (uint8) (word >> 8)) == 0xff)
+		*output_ptr++ = 0;
+	if ((*output_ptr++ = (uint8) word) == 0xff)
+		*output_ptr++ = 0;
+	return output_ptr;
+}
+
 uint8* huffman (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint16 component, uint8 *output_ptr, uint16 *Temp)
 {
 	uint16 i;
 	uint16 *DcCodeTable, *DcSizeTable, *AcCodeTable, *AcSizeTable;
 
 	int16 *Temp_Ptr, Coeff, LastDc;
-	uint16 AbsCoeff, HuffCode, HuffSize, RunLength=0, DataSize=0, index;
+	uint16 Bits, DataSize, RunLength=0, index;
 
-	int16 bits_in_next_word;
 	uint16 numbits;
 	uint32 data;
 
+	uint64_t lcode = jpeg_encoder_structure->lcode;
+	uint16 bitindex = jpeg_encoder_structure->bitindex;
+
 	Temp_Ptr = (int16 *)Temp;
 	Coeff = *Temp_Ptr++;
 
@@ -88,22 +105,11 @@ uint8* huffman (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint16 component
 		}
 	}
 
-	Coeff -= LastDc;
-
-	AbsCoeff = (Coeff < 0) ? -Coeff-- : Coeff;
+	Bits = coefficient_bits [Coeff - LastDc + 2048];
+	DataSize = Bits & 0xf;
 
-	while (AbsCoeff != 0)
-	{
-		AbsCoeff >>= 1;
-		DataSize++;
-	}
-
-	HuffCode = DcCodeTable [DataSize];
-	HuffSize = DcSizeTable [DataSize];
-
-	Coeff &= (1 << DataSize) - 1;
-	data = (HuffCode << DataSize) | Coeff;
-	numbits = HuffSize + DataSize;
+	data = ((uint32) DcCodeTable [DataSize] << DataSize) | (Bits >> 4);
+	numbits = DcSizeTable [DataSize] + DataSize;
 
 	PUTBITS
 
@@ -119,20 +125,12 @@ uint8* huffman (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint16 component
 				PUTBITS
 			}
 
-			AbsCoeff = (Coeff < 0) ? -Coeff-- : Coeff;
-
-			if (AbsCoeff >> 8 == 0)
-				DataSize = bitsize [AbsCoeff];
-			else
-				DataSize = bitsize [AbsCoeff >> 8] + 8;
+			Bits = coefficient_bits [Coeff + 2048];
+			DataSize = Bits & 0xf;
 
 			index = RunLength * 10 + DataSize;
-			HuffCode = AcCodeTable [index];
-			HuffSize = AcSizeTable [index];
-
-			Coeff &= (1 << DataSize) - 1;
-			data = (HuffCode << DataSize) | Coeff;
-			numbits = HuffSize + DataSize;
+			data = ((uint32) AcCodeTable [index] << DataSize) | (Bits >> 4);
+			numbits = AcSizeTable [index] + DataSize;
 
 			PUTBITS
 			RunLength = 0;
@@ -147,28 +145,49 @@ uint8* huffman (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint16 component
 		numbits = AcSizeTable [0];
 		PUTBITS
 	}
+
+	jpeg_encoder_structure->lcode = lcode;
+	jpeg_encoder_structure->bitindex = bitindex;
 	return output_ptr;
 }
 
-/* For bit Stuffing and EOI marker */
-uint8* close_bitstream (uint8 *output_ptr)
+/* Write the remaining bits, the last byte filled with fill_bits */
+static uint8* flush_bitstream (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 fill_bits, uint8 *output_ptr)
 {
-	uint16 i, count;
-	uint8 *ptr;
+	uint64_t lcode = jpeg_encoder_structure->lcode;
+	uint16 bitindex = jpeg_encoder_structure->bitindex;
+	uint16 fill = (8 - (bitindex & 7)) & 7;
 
-	if (bitindex > 0)
+	lcode = (lcode << fill) | (fill_bits & ((1 << fill) - 1));
+	for (bitindex += fill; bitindex > 0; bitindex -= 8)
 	{
-		lcode <<= (32 - bitindex);
-		count = (bitindex + 7) >> 3;
+		if ((*output_ptr++ = (uint8) (lcode >> (bitindex - 8))) == 0xff)
+			*output_ptr++ = 0;
+	}
 
-		ptr = (uint8 *) &lcode + 3;
+	jpeg_encoder_structure->lcode = 0;
+	jpeg_encoder_structure->bitindex = 0;
+	return output_ptr;
+}
 
-		for (i=count; i>0; i--)
-		{
-			if ((*output_ptr++ = *ptr--) == 0xff)
-				*output_ptr++ = 0;
-		}
-	}
+/* Fill the last byte with 1 bits, write the restart marker RSTn and reset the DC predictions */
+uint8* restart_bitstream (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint16 restart_index, uint8 *output_ptr)
+{
+	output_ptr = flush_bitstream (jpeg_encoder_structure, 0xff, output_ptr);
+
+	jpeg_encoder_structure->ldc1 = 0;
+	jpeg_encoder_structure->ldc2 = 0;
+	jpeg_encoder_structure->ldc3 = 0;
+
+	*output_ptr++ = 0xFF;
+	*output_ptr++ = (uint8) (0xD0 + (restart_index & 7));
+	return output_ptr;
+}
+
+/* For bit Stuffing and EOI marker */
+uint8* close_bitstream (JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 *output_ptr)
+{
+	output_ptr = flush_bitstream (jpeg_encoder_structure, 0, output_ptr);
 
 	/* End of image marker */
 	*output_ptr++ = 0xFF;
@@ -22,7 +22,7 @@
 
 /* Header for JPEG Encoder */
 
-uint8* write_markers (uint8 *output_ptr, uint32 image_format, uint32 image_width, uint32 image_height)
+uint8* write_markers (uint8 *output_ptr, const QUANT_TABLES *quant, uint32 image_format, uint32 image_width, uint32 image_height, uint16 restart_interval)
 {
 	uint16 i, header_length;
 	uint8 number_of_components;
@@ -44,14 +44,14 @@ uint8* write_markers (uint8 *output_ptr, uint32 image_format, uint32 image_width
 
 	/* Lqt table */
 	for (i=0; i<64; i++)
-		*output_ptr++ = Lqt [i];
+		*output_ptr++ = quant->Lqt [i];
 
 	/* Pq, Tq */
 	*output_ptr++ = 0x01;
 
 	/* Cqt table */
 	for (i=0; i<64; i++)
-		*output_ptr++ = Cqt [i];
+		*output_ptr++ = quant->Cqt [i];
 
 	/* huffman table(DHT) */
 	for (i=0; i<210; i++)
@@ -60,6 +60,19 @@ uint8* write_markers (uint8 *output_ptr, uint32 image_format, uint32 image_width
 		*output_ptr++ = (uint8) markerdata [i];
 	}
 
+	/* Restart interval marker(DRI) */
+	if (restart_interval != 0)
+	{
+		*output_ptr++ = 0xFF;
+		*output_ptr++ = 0xDD;
+
+		*output_ptr++ = 0x00;
+		*output_ptr++ = 0x04;
+
+		*output_ptr++ = (uint8) (restart_interval >> 8);
+		*output_ptr++ = (uint8) restart_interval;
+	}
+
 	if (image_format == OSC_PICTURE_YUV_400)
 		number_of_components = 1;
 	else
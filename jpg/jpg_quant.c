@@ -43,10 +43,13 @@ uint16 DSP_Division (uint32 numer, uint32 denom)
 }
 
 /* Multiply Quantization table with quality factor to get LQT and CQT */
-void initialize_quantization_tables (uint32 quality_factor)
+void initialize_quantization_tables (QUANT_TABLES *quant, uint32 quality_factor)
 {
 	uint16 i, index;
 	uint32 value;
+#if defined(OSC_HOST)
+	uint8 luminance_table [BLOCK_SIZE], chrominance_table [BLOCK_SIZE];
+#endif
 
 	uint8 luminance_quant_table [] =
 	{
@@ -85,8 +88,11 @@ void initialize_quantization_tables (uint32 quality_factor)
 		else if (value > 255)
 			value = 255;
 
-		Lqt [index] = (uint8) value;
-		ILqt [i] = DSP_Division (0x8000, value);
+		quant->Lqt [index] = (uint8) value;
+#if defined(OSC_HOST)
+		luminance_table [i] = (uint8) value;
+#endif
+		quant->ILqt [i] = DSP_Division (0x8000, value);
 
 		/* chrominance quantization table * quality factor */
 		value = chrominance_quant_table [i] * quality_factor;
@@ -97,13 +103,44 @@ void initialize_quantization_tables (uint32 quality_factor)
 		else if (value > 255)
 			value = 255;
 
-		Cqt [index] = (uint8) value;
-		ICqt [i] = DSP_Division (0x8000, value);
+		quant->Cqt [index] = (uint8) value;
+#if defined(OSC_HOST)
+		chrominance_table [i] = (uint8) value;
+#endif
+		quant->ICqt [i] = DSP_Division (0x8000, value);
 	}
+
+#if defined(OSC_HOST)
+	fast_quantization_divisors (&quant->fast_luminance, luminance_table);
+	fast_quantization_divisors (&quant->fast_chrominance, chrominance_table);
+#endif
+
+	quant->quality_factor = quality_factor;
+	quant->valid = TRUE;
+}
+
+/* Get the tables for a quality factor from the cache of the encoder or calculate them, replacing the oldest entry */
+const QUANT_TABLES * get_quantization_tables (JPG_ENCODER *encoder, uint32 quality_factor)
+{
+	uint16 i;
+	QUANT_TABLES *quant;
+
+	for (i=0; i<QUANT_CACHE_SIZE; i++)
+	{
+		quant = &encoder->quant_cache [i];
+		if (quant->valid && quant->quality_factor == quality_factor)
+			return quant;
+	}
+
+	quant = &encoder->quant_cache [encoder->next_quant_entry];
+	encoder->next_quant_entry = (encoder->next_quant_entry + 1) % QUANT_CACHE_SIZE;
+
+	initialize_quantization_tables (quant, quality_factor);
+	return quant;
 }
 
 /* multiply DCT Coefficients with Quantization table and store in ZigZag location */
-void quantization (int16* const data, uint16* const quant_table_ptr, uint16 *Temp)
+void quantization (int16* const data, const uint16* const quant_table_ptr, uint16 *Temp)
 {
 	int16 i;
 	int32 value;
@@ -22,7 +22,7 @@
 
 #include "jpg.h"
 
-uint8 zigzag_table [] =
+uint8 zigzag_table [BLOCK_SIZE] =
 {
 	0,  1,   5,  6, 14, 15, 27, 28,
 	2,  4,   7, 13, 16, 26, 29, 42,
@@ -439,41 +439,137 @@ void read_444_format (struct IMGDATA *img, JPEG_ENCODER_STRUCTURE *jpeg_encoder_
 	}
 }
 
-void BGR_2_444 (uint8 *input_ptr, uint8 *output_ptr, uint32 image_width, uint32 image_height)
+/* Convert a BGR pixel to Y, Cb and Cr */
+static inline void BGR_2_YCbCr (const uint8 *input_ptr, int16 *Y_Ptr, int16 *CB_Ptr, int16 *CR_Ptr)
 {
-	uint32 i, size;
 	uint8 R, G, B;
 	int32 Y, Cb, Cr;
 
-	size = image_width * image_height;
+	B = input_ptr [0];
+	G = input_ptr [1];
+	R = input_ptr [2];
 
-	for (i=size; i>0; i--)
+	Y = ((77 * R + 150 * G + 29 * B) >> 8);
+	Cb = ((-43 * R - 85 * G + 128 * B) >> 8) + 128;
+	Cr = ((128 * R - 107 * G - 21 * B) >> 8) + 128;
+
+	if (Y < 0)
+		Y = 0;
+	else if (Y > 255)
+		Y = 255;
+
+	if (Cb < 0)
+		Cb = 0;
+	else if (Cb > 255)
+		Cb = 255;
+
+	if (Cr < 0)
+		Cr = 0;
+	else if (Cr > 255)
+		Cr = 255;
+
+	*Y_Ptr = (int16) Y;
+	*CB_Ptr = (int16) Cb;
+	*CR_Ptr = (int16) Cr;
+}
+
+/* The readers of BGR pictures convert the pixels of an MCU while reading them. Rows and columns outside of
+ * the picture repeat the last row or column. The input rows are incr bytes longer than the cols pixels read. */
+
+void read_bgr_444_format (struct IMGDATA *img, JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 *input_ptr)
+{
+	int32 i, j;
+	int16 *Y1_Ptr = img->Y1;
+	int16 *CB_Ptr = img->CB;
+	int16 *CR_Ptr = img->CR;
+	const uint8 *row_ptr;
+
+	uint16 rows = jpeg_encoder_structure->rows;
+	uint16 cols = jpeg_encoder_structure->cols;
+	uint32 stride = cols * 3 + jpeg_encoder_structure->incr;
+
+	for (i=0; i<8; i++)
+	{
+		row_ptr = input_ptr + MIN(i, rows - 1) * stride;
+
+		for (j=0; j<8; j++)
+			BGR_2_YCbCr (row_ptr + MIN(j, cols - 1) * 3, Y1_Ptr++, CB_Ptr++, CR_Ptr++);
+	}
+}
+
+void read_bgr_422_format (struct IMGDATA *img, JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 *input_ptr)
+{
+	int32 i, j, k;
+	int16 *CB_Ptr = img->CB;
+	int16 *CR_Ptr = img->CR;
+	int16 *Y_Ptr, Cb, Cr;
+	int32 SumCb, SumCr;
+	const uint8 *row_ptr;
+
+	uint16 rows = jpeg_encoder_structure->rows;
+	uint16 cols = jpeg_encoder_structure->cols;
+	uint32 stride = cols * 3 + jpeg_encoder_structure->incr;
+
+	for (i=0; i<8; i++)
+	{
+		row_ptr = input_ptr + MIN(i, rows - 1) * stride;
+
+		for (j=0; j<16; j+=2)
+		{
+			/* Y1 holds the left, Y2 the right half of the MCU */
+			Y_Ptr = (j < 8 ? img->Y1 : img->Y2) + i * 8 + (j & 7);
+			SumCb = SumCr = 0;
+
+			for (k=0; k<2; k++)
+			{
+				BGR_2_YCbCr (row_ptr + MIN(j + k, cols - 1) * 3, Y_Ptr + k, &Cb, &Cr);
+				SumCb += Cb;
+				SumCr += Cr;
+			}
+
+			*CB_Ptr++ = (int16) ((SumCb + 1) >> 1);
+			*CR_Ptr++ = (int16) ((SumCr + 1) >> 1);
+		}
+	}
+}
+
+void read_bgr_420_format (struct IMGDATA *img, JPEG_ENCODER_STRUCTURE *jpeg_encoder_structure, uint8 *input_ptr)
+{
+	int32 i, j, k;
+	int16 *CB_Ptr = img->CB;
+	int16 *CR_Ptr = img->CR;
+	int16 *Y_Ptr, Cb, Cr;
+	int32 SumCb, SumCr;
+	const uint8 *row_ptr [2];
+
+	uint16 rows = jpeg_encoder_structure->rows;
+	uint16 cols = jpeg_encoder_structure->cols;
+	uint32 stride = cols * 3 + jpeg_encoder_structure->incr;
+
+	for (i=0; i<16; i+=2)
 	{
-		B = *input_ptr++;
-		G = *input_ptr++;
-		R = *input_ptr++;
-
-		Y = ((77 * R + 150 * G + 29 * B) >> 8);
-		Cb = ((-43 * R - 85 * G + 128 * B) >> 8) + 128;
-		Cr = ((128 * R - 107 * G - 21 * B) >> 8) + 128;
-
-		if (Y < 0)
-			Y = 0;
-		else if (Y > 255)
-			Y = 255;
-
-		if (Cb < 0)
-			Cb = 0;
-		else if (Cb > 255)
-			Cb = 255;
-
-		if (Cr < 0)
-			Cr = 0;
-		else if (Cr > 255)
-			Cr = 255;
-
-		*output_ptr++ = (uint8) Y;
-		*output_ptr++ = (uint8) Cb;
-		*output_ptr++ = (uint8) Cr;
+		row_ptr [0] = input_ptr + MIN(i, rows - 1) * stride;
+		row_ptr [1] = input_ptr + MIN(i + 1, rows - 1) * stride;
+
+		for (j=0; j<16; j+=2)
+		{
+			/* Y1 to Y4 hold the top left, top right, bottom left and bottom right quarter of the MCU */
+			if (i < 8)
+				Y_Ptr = (j < 8 ? img->Y1 : img->Y2) + i * 8 + (j & 7);
+			else
+				Y_Ptr = (j < 8 ? img->Y3 : img->Y4) + (i & 7) * 8 + (j & 7);
+			SumCb = SumCr = 0;
+
+			for (k=0; k<4; k++)
+			{
+				BGR_2_YCbCr (row_ptr [k >> 1] + MIN(j + (k & 1), cols - 1) * 3,
+						Y_Ptr + (k >> 1) * 8 + (k & 1), &Cb, &Cr);
+				SumCb += Cb;
+				SumCr += Cr;
+			}
+
+			*CB_Ptr++ = (int16) ((SumCb + 2) >> 2);
+			*CR_Ptr++ = (int16) ((SumCr + 2) >> 2);
+		}
 	}
 }
@@ -0,0 +1,565 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*! @file
+ * @brief Motion-JPEG streams written to a file by a writer thread.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include "jpg.h"
+
+/* Write all of the given buffers, retrying after partial writes */
+static OSC_ERR write_all (int fd, struct iovec *iov, int iovcnt)
+{
+	ssize_t written;
+
+	while (iovcnt > 0)
+	{
+		written = writev (fd, iov, iovcnt);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return -EFILE_ERROR;
+		}
+
+		while (iovcnt > 0 && (size_t) written >= iov->iov_len)
+		{
+			written -= iov->iov_len;
+			iov++;
+			iovcnt--;
+		}
+		if (iovcnt > 0)
+		{
+			iov->iov_base = (uint8 *) iov->iov_base + written;
+			iov->iov_len -= written;
+		}
+	}
+	return SUCCESS;
+}
+
+#define FOURCC(p, s) memcpy (p, s, 4)
+
+/* Fill in the headers of an AVI file with the frames written so far */
+static void avi_header (JPG_STREAM *stream, uint8 *header)
+{
+	uint32 frames = stream->stats.framesWritten;
+	uint32 indexSize = 8 + 16 * frames;
+
+	memset (header, 0, AVI_HEADER_SIZE);
+
+	FOURCC (header, "RIFF");
+	ST_INT32 (header + 4, AVI_HEADER_SIZE - 8 + stream->moviSize + indexSize);
+	FOURCC (header + 8, "AVI ");
+
+	FOURCC (header + 12, "LIST");
+	ST_INT32 (header + 16, 192);
+	FOURCC (header + 20, "hdrl");
+
+	/* Main AVI header */
+	FOURCC (header + 24, "avih");
+	ST_INT32 (header + 28, 56);
+	ST_INT32 (header + 32, 1000000 / stream->framesPerSecond);
+	ST_INT32 (header + 36, stream->maxFrameSize * stream->framesPerSecond);
+	ST_INT32 (header + 44, 0x10);					/* AVIF_HASINDEX */
+	ST_INT32 (header + 48, frames);
+	ST_INT32 (header + 56, 1);						/* Streams */
+	ST_INT32 (header + 60, stream->maxFrameSize + 8);
+	ST_INT32 (header + 64, stream->width);
+	ST_INT32 (header + 68, stream->height);
+
+	FOURCC (header + 88, "LIST");
+	ST_INT32 (header + 92, 116);
+	FOURCC (header + 96, "strl");
+
+	/* Stream header */
+	FOURCC (header + 100, "strh");
+	ST_INT32 (header + 104, 56);
+	FOURCC (header + 108, "vids");
+	FOURCC (header + 112, "MJPG");
+	ST_INT32 (header + 128, 1);						/* Scale */
+	ST_INT32 (header + 132, stream->framesPerSecond);	/* Rate */
+	ST_INT32 (header + 140, frames);
+	ST_INT32 (header + 144, stream->maxFrameSize + 8);
+	ST_INT32 (header + 148, 0xffffffff);			/* Quality */
+	ST_INT16 (header + 160, stream->width);
+	ST_INT16 (header + 162, stream->height);
+
+	/* Stream format, a BITMAPINFOHEADER */
+	FOURCC (header + 164, "strf");
+	ST_INT32 (header + 168, 40);
+	ST_INT32 (header + 172, 40);
+	ST_INT32 (header + 176, stream->width);
+	ST_INT32 (header + 180, stream->height);
+	ST_INT16 (header + 184, 1);						/* Planes */
+	ST_INT16 (header + 186, 24);					/* Bit count */
+	FOURCC (header + 188, "MJPG");
+	ST_INT32 (header + 192, (uint32) stream->width * stream->height * 3);
+
+	FOURCC (header + 212, "LIST");
+	ST_INT32 (header + 216, 4 + stream->moviSize);
+	FOURCC (header + 220, "movi");
+}
+
+/* Write an encoded frame with the headers of the container format, the number of bytes written is returned in pSize */
+static OSC_ERR write_frame (JPG_STREAM *stream, const JPG_STREAM_FRAME *frame, uint32 *pSize)
+{
+	uint8 header [AVI_HEADER_SIZE], pad = 0;
+	uint32 *index;
+	char part [128];
+	struct iovec iov [4];
+	int i, iovcnt = 0;
+
+	if (stream->format == OSC_JPG_STREAM_MULTIPART)
+	{
+		iov [iovcnt].iov_base = part;
+		iov [iovcnt++].iov_len = sprintf (part, "--" OSC_JPG_STREAM_BOUNDARY "\r\nContent-Type: image/jpeg\r\nContent-Length: %u\r\n\r\n", frame->size);
+		iov [iovcnt].iov_base = stream->buffer + frame->offset;
+		iov [iovcnt++].iov_len = frame->size;
+		iov [iovcnt].iov_base = "\r\n";
+		iov [iovcnt++].iov_len = 2;
+	}
+	else
+	{
+		if (stream->stats.framesWritten == 0)
+		{
+			/* Written again with the final sizes by OscJpgStreamClose() */
+			avi_header (stream, header);
+			iov [iovcnt].iov_base = header;
+			iov [iovcnt++].iov_len = AVI_HEADER_SIZE;
+		}
+
+		if (stream->stats.framesWritten == stream->indexSize / 2)
+		{
+			index = realloc (stream->index, (stream->indexSize * 2 + 1024) * sizeof(uint32));
+			if (index == NULL)
+				return -EOUT_OF_MEMORY;
+			stream->index = index;
+			stream->indexSize = stream->indexSize * 2 + 1024;
+		}
+		stream->index [2 * stream->stats.framesWritten] = 4 + stream->moviSize;
+		stream->index [2 * stream->stats.framesWritten + 1] = frame->size;
+
+		FOURCC (part, "00dc");
+		ST_INT32 (part + 4, frame->size);
+		iov [iovcnt].iov_base = part;
+		iov [iovcnt++].iov_len = 8;
+		iov [iovcnt].iov_base = stream->buffer + frame->offset;
+		iov [iovcnt++].iov_len = frame->size;
+		/* Chunks are padded to an even size */
+		if (frame->size & 1)
+		{
+			iov [iovcnt].iov_base = &pad;
+			iov [iovcnt++].iov_len = 1;
+		}
+
+		stream->moviSize += 8 + ((frame->size + 1) & ~1);
+		stream->maxFrameSize = MAX(stream->maxFrameSize, frame->size);
+	}
+
+	for (*pSize = 0, i = 0; i < iovcnt; i++)
+		*pSize += iov [i].iov_len;
+	return write_all (stream->fd, iov, iovcnt);
+}
+
+#if defined(OSC_HOST)
+#define LOCK(stream) pthread_mutex_lock (&(stream)->lock)
+#define UNLOCK(stream) pthread_mutex_unlock (&(stream)->lock)
+#else
+#define LOCK(stream)
+#define UNLOCK(stream)
+#endif
+
+/* Account for the frame at the head of the queue having been written and release its space. Called with the lock held. */
+static void release_frame (JPG_STREAM *stream, OSC_ERR err, uint32 size)
+{
+	JPG_STREAM_FRAME *frame = &stream->queue [stream->queueHead];
+
+	if (err != SUCCESS)
+	{
+		if (stream->stats.writeError == SUCCESS)
+			OscLog(ERROR, "%s: Could not write the stream (%d)!\n", __func__, err);
+		stream->stats.writeError = err;
+	}
+	else
+	{
+		stream->stats.framesWritten++;
+		stream->stats.bytesWritten += size;
+	}
+
+	stream->used -= frame->skip + frame->size;
+	stream->tail = frame->offset + frame->size;
+	stream->queueHead = (stream->queueHead + 1) % STREAM_QUEUE_SIZE;
+	stream->queueLength--;
+	stream->stats.queuedBytes = stream->used;
+}
+
+/* Write the frame at the head of the queue, called without the lock. After an error the frames are discarded. */
+static void write_queued_frame (JPG_STREAM *stream)
+{
+	JPG_STREAM_FRAME frame;
+	uint32 size = 0;
+	OSC_ERR err;
+
+	LOCK(stream);
+	frame = stream->queue [stream->queueHead];
+	err = stream->stats.writeError;
+	UNLOCK(stream);
+
+	if (err == SUCCESS)
+		err = write_frame (stream, &frame, &size);
+
+	LOCK(stream);
+	release_frame (stream, err, size);
+	UNLOCK(stream);
+}
+
+#if defined(OSC_HOST)
+/* The writer thread of a stream, writes the queued frames until the stream is closed */
+static void *stream_writer (void *arg)
+{
+	JPG_STREAM *stream = (JPG_STREAM *)arg;
+
+	LOCK(stream);
+	for (;;)
+	{
+		while (stream->queueLength == 0 && !stream->closing)
+			pthread_cond_wait (&stream->cond, &stream->lock);
+		if (stream->queueLength == 0)
+			break;
+
+		UNLOCK(stream);
+		write_queued_frame (stream);
+		LOCK(stream);
+	}
+	UNLOCK(stream);
+	return NULL;
+}
+#endif /* OSC_HOST */
+
+OSC_ERR OscJpgStreamOpenFd(void **phStream, int fd, enum EnOscJpgStreamFormat format, uint32 bufferSize, uint32 framesPerSecond)
+{
+	JPG_STREAM *stream;
+	OSC_ERR err;
+
+	if (phStream == NULL || fd < 0 || bufferSize == 0 ||
+			(format != OSC_JPG_STREAM_MULTIPART && format != OSC_JPG_STREAM_AVI) ||
+			(format == OSC_JPG_STREAM_AVI && framesPerSecond == 0))
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	stream = malloc(sizeof(JPG_STREAM));
+	if (stream == NULL)
+	{
+		OscLog(ERROR, "%s: Could not allocate memory!\n", __func__);
+		return -EOUT_OF_MEMORY;
+	}
+	memset(stream, 0, sizeof(JPG_STREAM));
+	stream->fd = fd;
+	stream->format = format;
+	stream->framesPerSecond = framesPerSecond;
+	stream->bufferSize = bufferSize;
+
+	if (format == OSC_JPG_STREAM_AVI)
+	{
+		/* The headers are completed when the stream is closed */
+		stream->start = lseek(fd, 0, SEEK_CUR);
+		if (stream->start < 0)
+		{
+			OscLog(ERROR, "%s: AVI streams need a seekable file!\n", __func__);
+			err = -EUNSUPPORTED;
+			goto exit_fail;
+		}
+	}
+
+	stream->buffer = malloc(bufferSize);
+	if (stream->buffer == NULL)
+	{
+		OscLog(ERROR, "%s: Could not allocate memory!\n", __func__);
+		err = -EOUT_OF_MEMORY;
+		goto exit_fail;
+	}
+
+	err = OscJpgCreateEncoder(&stream->hEncoder);
+	if (err != SUCCESS)
+		goto exit_fail;
+
+#if defined(OSC_HOST)
+	pthread_mutex_init(&stream->lock, NULL);
+	pthread_cond_init(&stream->cond, NULL);
+	if (pthread_create(&stream->thread, NULL, stream_writer, stream) != 0)
+	{
+		OscLog(ERROR, "%s: Could not start the writer thread!\n", __func__);
+		pthread_cond_destroy(&stream->cond);
+		pthread_mutex_destroy(&stream->lock);
+		OscJpgDestroyEncoder(stream->hEncoder);
+		err = -EDEVICE;
+		goto exit_fail;
+	}
+#endif
+
+	*phStream = stream;
+	return SUCCESS;
+
+exit_fail:
+	free(stream->buffer);
+	free(stream);
+	return err;
+}
+
+OSC_ERR OscJpgStreamOpen(void **phStream, const char *strFileName, enum EnOscJpgStreamFormat format, uint32 bufferSize, uint32 framesPerSecond)
+{
+	int fd;
+	OSC_ERR err;
+
+	if (phStream == NULL || strFileName == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	fd = open(strFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+	{
+		OscLog(ERROR, "%s: Unable to open file %s!\n", __func__, strFileName);
+		return -EUNABLE_TO_OPEN_FILE;
+	}
+
+	err = OscJpgStreamOpenFd(phStream, fd, format, bufferSize, framesPerSecond);
+	if (err != SUCCESS)
+	{
+		close(fd);
+		return err;
+	}
+
+	((JPG_STREAM *) *phStream)->closeFd = TRUE;
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgStreamGetEncoder(void *hStream, void **phEncoder)
+{
+	JPG_STREAM *stream = (JPG_STREAM *)hStream;
+
+	if (stream == NULL || phEncoder == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	*phEncoder = stream->hEncoder;
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgStreamWriteFrame(void *hStream, const struct OSC_PICTURE *pic, uint32 quality_factor)
+{
+	JPG_STREAM *stream = (JPG_STREAM *)hStream;
+	JPG_STREAM_FRAME frame;
+	uint32 endSpace, startSpace, used, startCyc, encodeTime;
+	OSC_ERR err;
+
+	if (stream == NULL || pic == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	if (stream->format == OSC_JPG_STREAM_AVI)
+	{
+		if (stream->stats.frames == 0)
+		{
+			stream->width = pic->width;
+			stream->height = pic->height;
+		}
+		else if (pic->width != stream->width || pic->height != stream->height)
+		{
+			OscLog(ERROR, "%s: All frames of an AVI stream must have the same size!\n", __func__);
+			return -EINVALID_PARAMETER;
+		}
+	}
+
+	/* Find the free space, which only grows while the frame is encoded */
+	LOCK(stream);
+	err = stream->stats.writeError;
+	used = stream->used;
+	if (used == 0)
+		stream->head = stream->tail = 0;
+
+	if (stream->queueLength == STREAM_QUEUE_SIZE)
+		endSpace = startSpace = 0;
+	else if (stream->head > stream->tail || used == 0)
+	{
+		endSpace = stream->bufferSize - stream->head;
+		startSpace = stream->tail;
+	}
+	else
+	{
+		endSpace = stream->tail - stream->head;
+		startSpace = 0;
+	}
+	UNLOCK(stream);
+
+	if (err != SUCCESS)
+		return err;
+
+	startCyc = OscSupCycGet();
+	frame.offset = stream->head;
+	frame.skip = 0;
+	err = -EBUFFER_TOO_SMALL;
+	if (endSpace > 0)
+		err = OscJpgEncodePictureToBuffer(stream->hEncoder, pic, stream->buffer + frame.offset, endSpace, quality_factor, &frame.size);
+
+	if (err == -EBUFFER_TOO_SMALL && startSpace > 0)
+	{
+		/* Leave the end of the buffer unused and continue at its beginning */
+		frame.offset = 0;
+		frame.skip = stream->bufferSize - stream->head;
+		err = OscJpgEncodePictureToBuffer(stream->hEncoder, pic, stream->buffer, startSpace, quality_factor, &frame.size);
+	}
+	encodeTime = OscSupCycToMicroSecs(OscSupCycGet() - startCyc);
+
+	if (err == -EBUFFER_TOO_SMALL && used > 0)
+	{
+		/* The writer is behind */
+		LOCK(stream);
+		stream->stats.droppedFrames++;
+		UNLOCK(stream);
+		return -EDEVICE_BUSY;
+	}
+	if (err != SUCCESS)
+		return err;
+
+	LOCK(stream);
+	stream->queue [(stream->queueHead + stream->queueLength) % STREAM_QUEUE_SIZE] = frame;
+	stream->queueLength++;
+	stream->used += frame.skip + frame.size;
+	stream->head = frame.offset + frame.size;
+
+	stream->stats.frames++;
+	stream->stats.lastEncodeTime = encodeTime;
+	stream->stats.maxEncodeTime = MAX(stream->stats.maxEncodeTime, encodeTime);
+	stream->stats.lastFrameSize = frame.size;
+	stream->stats.queuedBytes = stream->used;
+#if defined(OSC_HOST)
+	pthread_cond_signal(&stream->cond);
+	UNLOCK(stream);
+#else
+	/* No writer thread on the target */
+	write_queued_frame (stream);
+#endif
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgStreamGetStats(void *hStream, struct OSC_JPG_STREAM_STATS *pStats)
+{
+	JPG_STREAM *stream = (JPG_STREAM *)hStream;
+
+	if (stream == NULL || pStats == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+	LOCK(stream);
+	*pStats = stream->stats;
+	UNLOCK(stream);
+	return SUCCESS;
+}
+
+/* Append the index to an AVI file and rewrite the headers with the final sizes */
+static OSC_ERR finish_avi (JPG_STREAM *stream)
+{
+	uint8 header [AVI_HEADER_SIZE], chunk [8];
+	struct iovec iov [2];
+	uint32 i, size = 16 * stream->stats.framesWritten;
+	uint8 *index;
+	OSC_ERR err;
+
+	index = malloc(size + 1);
+	if (index == NULL)
+		return -EOUT_OF_MEMORY;
+
+	for (i = 0; i < stream->stats.framesWritten; i++)
+	{
+		FOURCC (index + 16 * i, "00dc");
+		ST_INT32 (index + 16 * i + 4, 0x10);	/* AVIIF_KEYFRAME */
+		ST_INT32 (index + 16 * i + 8, stream->index [2 * i]);
+		ST_INT32 (index + 16 * i + 12, stream->index [2 * i + 1]);
+	}
+
+	FOURCC (chunk, "idx1");
+	ST_INT32 (chunk + 4, size);
+	iov [0].iov_base = chunk;
+	iov [0].iov_len = 8;
+	iov [1].iov_base = index;
+	iov [1].iov_len = size;
+	err = write_all (stream->fd, iov, 2);
+	free(index);
+	if (err != SUCCESS)
+		return err;
+
+	avi_header (stream, header);
+	if (pwrite(stream->fd, header, AVI_HEADER_SIZE, stream->start) != AVI_HEADER_SIZE)
+		return -EFILE_ERROR;
+	return SUCCESS;
+}
+
+OSC_ERR OscJpgStreamClose(void *hStream)
+{
+	JPG_STREAM *stream = (JPG_STREAM *)hStream;
+	OSC_ERR err;
+
+	if (stream == NULL)
+	{
+		OscLog(ERROR, "%s: Invalid parameter!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+
+#if defined(OSC_HOST)
+	/* The writer thread writes the remaining frames before it terminates */
+	LOCK(stream);
+	stream->closing = TRUE;
+	pthread_cond_signal(&stream->cond);
+	UNLOCK(stream);
+	pthread_join(stream->thread, NULL);
+	pthread_cond_destroy(&stream->cond);
+	pthread_mutex_destroy(&stream->lock);
+#endif
+
+	err = stream->stats.writeError;
+	if (err == SUCCESS && stream->format == OSC_JPG_STREAM_AVI && stream->stats.framesWritten > 0)
+	{
+		err = finish_avi (stream);
+		if (err != SUCCESS)
+			OscLog(ERROR, "%s: Could not complete the AVI file!\n", __func__);
+	}
+
+	if (stream->closeFd && close(stream->fd) != 0 && err == SUCCESS)
+		err = -EFILE_ERROR;
+
+	OscJpgDestroyEncoder(stream->hEncoder);
+	free(stream->index);
+	free(stream->buffer);
+	free(stream);
+	return err;
+}
@@ -22,9 +22,20 @@
  
 #include <stdio.h>
 #include <stdlib.h>
+#include <pthread.h>
 
 #include "vis.h"
 
+#if defined(OSC_HOST)
+/*! @brief Converts the start of an output row with the vectorized kernel of the function,
+ * if any. Evaluates to the number of raw columns done. */
+#define SIMD_ROW(kernel, in, width, y, pOut) \
+	(FastDebayerGetKernels()->kernel == NULL ? 0 : \
+		2 * FastDebayerGetKernels()->kernel((const uint8 *)&(in)[(y) * (width)], \
+			(const uint8 *)&(in)[((y) + 1) * (width)], (uint8 *)(pOut), (width) / 2))
+#else
+#define SIMD_ROW(kernel, in, width, y, pOut) 0
+#endif
 
 OSC_ERR OscVisFastDebayerBGR(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
 {
@@ -34,7 +45,9 @@ OSC_ERR OscVisFastDebayerBGR(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE
 	char *out = (char *)pOut->data;
 
 	for (y=0; y<pRaw->height; y+=2) {
-		for (x=0; x<pRaw->width; x+=2) {
+		x = SIMD_ROW(bgr, in, pRaw->width, y, &out[outPos]);
+		outPos += 3 * (x / 2);
+		for (; x<pRaw->width; x+=2) {
 			/* Blue */
 			out[outPos++]=in[y*pRaw->width+x];			
 			/* Green */
@@ -57,7 +70,9 @@ OSC_ERR OscVisFastDebayerRGB(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE
 	unsigned char *out = (unsigned char *)pOut->data;
 
 	for (y=0; y<pRaw->height; y+=2) {
-		for (x=0; x<pRaw->width; x+=2) {
+		x = SIMD_ROW(rgb, in, pRaw->width, y, &out[outPos]);
+		outPos += 3 * (x / 2);
+		for (; x<pRaw->width; x+=2) {
 			/* Red */
 			out[outPos++]=in[(y+1)*pRaw->width+x+1];
 			/* Green */
@@ -116,7 +131,9 @@ OSC_ERR OscVisFastDebayerGrey(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE
 	uint8 *out = (uint8 *)pOut->data;
 
 	for (y=0; y<pRaw->height; y+=2) {
-		for (x=0; x<pRaw->width; x+=2) {
+		x = SIMD_ROW(grey, in, pRaw->width, y, &out[outPos]);
+		outPos += x / 2;
+		for (; x<pRaw->width; x+=2) {
 			                /*     blue           +          2x green          +              red           */
 			out[outPos++] = (uint8)(( (uint16)in[y*pRaw->width+x] + 
 						  (uint16)in[y*pRaw->width+x+1] + 
@@ -141,7 +158,9 @@ OSC_ERR OscVisFastDebayerLumY(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE
 	unsigned char *out = (unsigned char *)pOut->data;
 
 	for (y=0; y<pRaw->height; y+=2) {
-		for (x=0; x<pRaw->width; x+=2) {
+		x = SIMD_ROW(lumY, in, pRaw->width, y, &out[outPos]);
+		outPos += x / 2;
+		for (; x<pRaw->width; x+=2) {
 			R = in[(y+1)*pRaw->width+x+1];
 			G = in[y*pRaw->width+x+1];
 			B = in[y*pRaw->width+x];
@@ -170,7 +189,9 @@ OSC_ERR OscVisFastDebayerChromU(const struct OSC_PICTURE *pRaw, struct OSC_PICTU
 	unsigned char *out = (unsigned char *)pOut->data;
 
 	for (y=0; y<pRaw->height; y+=2) {
-		for (x = 0; x<pRaw->width; x+=2) {
+		x = SIMD_ROW(chromU, in, pRaw->width, y, &out[outPos]);
+		outPos += x / 2;
+		for (; x<pRaw->width; x+=2) {
 			R = in[(y+1)*pRaw->width+x+1];
 			G = in[y*pRaw->width+x+1];
 			B = in[y*pRaw->width+x];
@@ -200,7 +221,9 @@ OSC_ERR OscVisFastDebayerChromV(const struct OSC_PICTURE *pRaw, struct OSC_PICTU
 	unsigned char *out = (unsigned char *)pOut->data;
 
 	for (y=0; y<pRaw->height; y+=2) {
-		for (x=0; x<pRaw->width; x+=2) {
+		x = SIMD_ROW(chromV, in, pRaw->width, y, &out[outPos]);
+		outPos += x / 2;
+		for (; x<pRaw->width; x+=2) {
 			R = in[(y+1)*pRaw->width+x+1];
 			G = in[y*pRaw->width+x+1];
 			B = in[y*pRaw->width+x];
@@ -230,7 +253,9 @@ OSC_ERR OscVisFastDebayerYUV422(const struct OSC_PICTURE *pRaw, struct OSC_PICTU
 	unsigned char *out = (unsigned char *)pOut->data;
 
 	for (y=0; y < pRaw->height; y+=2) {
-		for (x=0; x < pRaw->width; x+=4) {
+		x = SIMD_ROW(yuv422, in, pRaw->width, y, &out[outPos]);
+		outPos += x;
+		for (; x<pRaw->width; x+=4) {
 			R1 = in[(y+1)*pRaw->width+x+1];
 			G1 = in[y*pRaw->width+x+1];
 			B1 = in[y*pRaw->width+x];
@@ -260,152 +285,184 @@ OSC_ERR OscVisFastDebayerYUV422(const struct OSC_PICTURE *pRaw, struct OSC_PICTU
 }
 
 
-OSC_ERR OscVisFastDebayerHSL_H(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
+/*! @brief Fixed point precision of the hue reciprocals. */
+#define HSL_HUE_RECIP_SHIFT 16
+/*! @brief Fixed point precision of the saturation reciprocals. */
+#define HSL_SAT_RECIP_SHIFT 23
+
+/*! @brief Reciprocals ceil(10922 * 2^HSL_HUE_RECIP_SHIFT / (max - min)) for the hue. */
+static uint32 hslHueRecip[256];
+/*! @brief Reciprocals ceil(2^HSL_SAT_RECIP_SHIFT / d) for the saturation denominator d. */
+static uint32 hslSatRecip[257];
+/*! @brief Makes sure the reciprocal tables are filled exactly once. */
+static pthread_once_t hslTablesOnce = PTHREAD_ONCE_INIT;
+
+/*********************************************************************//*!
+ * @brief Fill the reciprocal tables of the HSL conversion.
+ * 
+ * The quotients of the HSL conversion are calculated by a multiplication
+ * with the reciprocal and a shift. The precisions are chosen so that the
+ * result equals the truncated integer division for all possible inputs
+ * and that the products fit into 32 bits. Run through pthread_once(),
+ * so a thread never sees half-filled tables.
+ *//*********************************************************************/
+static void InitHslTables(void)
 {
-	uint16 x,y;
-	uint32 outPos = 0;
-	uint8 max, min;
-	uint16 hue;
-	uint16 R, G, B;
-	unsigned char *in  = (unsigned char *)pRaw->data;
-	unsigned char *out = (unsigned char *)pOut->data;
+	uint32 d;
+	
+	hslHueRecip[0] = 0;
+	for (d = 1; d < 256; d++)
+		hslHueRecip[d] = ((10922 << HSL_HUE_RECIP_SHIFT) + d - 1) / d;
+	/* Only a black pixel has a denominator of 0, its saturation is 0. */
+	hslSatRecip[0] = 0;
+	for (d = 1; d < 257; d++)
+		hslSatRecip[d] = ((1 << HSL_SAT_RECIP_SHIFT) + d - 1) / d;
+}
 
-	for (y=0; y<pRaw->height; y+=2) {
-		for (x=0; x<pRaw->width; x+=2) {
-			R = in[(y+1)*pRaw->width+x+1];
-			G = in[y*pRaw->width+x+1];
-			B = in[y*pRaw->width+x];
-			
-			/* get max and min */
-			if( R > G ){
-				max = R;
-				min = G;
-			}else{
-				max = G;
-				min = R;
-			}
-			if( B > max ){
-				max = B;
-			}
-			if( B < min ){
-				min = B;
-			}
-
-			/* hue */
-			if(max == min){
-				hue = 0;
-			}else{
-				if(max == R){
-					hue = 10922 * (G - B) / (max - min) + 65536;
-				}else if(max == G){
-					hue = 10922 * (B - R) / (max - min) + 21845;
-				}else{
-					hue = 10922 * (R - G) / (max - min) + 43690;
-				}
-			}
-			out[outPos++] = (uint8)(hue >> 8);
-			
-		} /* for x */
-	} /* for y */
-	pOut->width  = pRaw->width/2;
-	pOut->height = pRaw->height/2; 
-	pOut->type  = OSC_PICTURE_HUE;
-	return SUCCESS;
+/*********************************************************************//*!
+ * @brief Convert a color to HSL without division.
+ * 
+ * The hue is mapped from [0, 360) to [0, 256), saturation and luminance
+ * are calculated in the same way as by the separate OscVisFastDebayerHSL_*
+ * functions.
+ * 
+ * @param R Red value.
+ * @param G Green value.
+ * @param B Blue value.
+ * @param pH Returns the hue.
+ * @param pS Returns the saturation.
+ * @param pL Returns the luminance.
+ *//*********************************************************************/
+static inline void FastDebayerHSL(uint16 R, uint16 G, uint16 B, uint8 *pH, uint8 *pS, uint8 *pL)
+{
+	uint16 max, min, delta, lum, hue;
+	uint32 quot;
+	
+	/* get max and min */
+	if( R > G ){
+		max = R;
+		min = G;
+	}else{
+		max = G;
+		min = R;
+	}
+	if( B > max ){
+		max = B;
+	}
+	if( B < min ){
+		min = B;
+	}
+	delta = max - min;
+	
+	/* hue, the quotient is truncated towards zero */
+	if(delta == 0){
+		hue = 0;
+	}else if(max == R){
+		quot = ((uint32)(G >= B ? G - B : B - G) * hslHueRecip[delta]) >> HSL_HUE_RECIP_SHIFT;
+		hue = (G >= B ? quot : -quot) + 65536;
+	}else if(max == G){
+		quot = ((uint32)(B >= R ? B - R : R - B) * hslHueRecip[delta]) >> HSL_HUE_RECIP_SHIFT;
+		hue = (B >= R ? quot : -quot) + 21845;
+	}else{
+		quot = ((uint32)(R >= G ? R - G : G - R) * hslHueRecip[delta]) >> HSL_HUE_RECIP_SHIFT;
+		hue = (R >= G ? quot : -quot) + 43690;
+	}
+	*pH = (uint8)(hue >> 8);
+	
+	/* luminance */
+	lum = (max + min) >> 1;
+	*pL = (uint8)lum;
+	
+	/* saturation */
+	*pS = (uint8)(((uint32)(delta << 8) * hslSatRecip[lum < 128 ? lum << 1 : 512 - (lum << 1)]) >> HSL_SAT_RECIP_SHIFT);
+}
+
+OSC_ERR OscVisFastDebayerHSL_H(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
+{
+	return OscVisFastDebayerHSL(pRaw, pOut, NULL, NULL);
 }
 
 
 OSC_ERR OscVisFastDebayerHSL_S(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
+{
+	return OscVisFastDebayerHSL(pRaw, NULL, pOut, NULL);
+}
+
+
+OSC_ERR OscVisFastDebayerHSL_L(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
+{
+	return OscVisFastDebayerHSL(pRaw, NULL, NULL, pOut);
+}
+
+
+OSC_ERR OscVisFastDebayerHSL(const struct OSC_PICTURE *pRaw,
+		struct OSC_PICTURE *pOutH,
+		struct OSC_PICTURE *pOutS,
+		struct OSC_PICTURE *pOutL)
 {
 	uint16 x,y;
 	uint32 outPos = 0;
-	uint8 max, min;
-	uint16 sat, lum;
-	uint16 R, G, B;
+	uint8 H, S, L;
 	unsigned char *in  = (unsigned char *)pRaw->data;
-	unsigned char *out = (unsigned char *)pOut->data;
+	unsigned char *outH = pOutH == NULL ? NULL : (unsigned char *)pOutH->data;
+	unsigned char *outS = pOutS == NULL ? NULL : (unsigned char *)pOutS->data;
+	unsigned char *outL = pOutL == NULL ? NULL : (unsigned char *)pOutL->data;
+	struct OSC_PICTURE *pOuts[3] = { pOutH, pOutS, pOutL };
+	uint16 i;
 
+	pthread_once(&hslTablesOnce, InitHslTables);
 	for (y=0; y<pRaw->height; y+=2) {
 		for (x=0; x<pRaw->width; x+=2) {
-			R = in[(y+1)*pRaw->width+x+1];
-			G = in[y*pRaw->width+x+1];
-			B = in[y*pRaw->width+x];
-			
-			/* get max and min */
-			if( R > G ){
-				max = R;
-				min = G;
-			}else{
-				max = G;
-				min = R;
-			}
-			if( B > max ){
-				max = B;
-			}
-			if( B < min ){
-				min = B;
-			}
-			
-			/* luminance */
-			lum = (max + min) >> 1;
-
-			/* saturation */
-			if(lum < 128){
-				sat = ((max - min) << 8) / (lum << 1);
-			}else{
-				sat = ((max - min) << 8) / (512 - (lum << 1));
-			}
-
-			out[outPos++] = (uint8)sat;
-			
+			FastDebayerHSL(in[(y+1)*pRaw->width+x+1], in[y*pRaw->width+x+1], in[y*pRaw->width+x], &H, &S, &L);
+			if (outH != NULL)
+				outH[outPos] = H;
+			if (outS != NULL)
+				outS[outPos] = S;
+			if (outL != NULL)
+				outL[outPos] = L;
+			outPos++;
 		} /* for x */
 	} /* for y */
-	pOut->width  = pRaw->width/2;
-	pOut->height = pRaw->height/2; 
-	pOut->type  = OSC_PICTURE_HUE;
+	for (i = 0; i < 3; i++) {
+		if (pOuts[i] != NULL) {
+			pOuts[i]->width  = pRaw->width/2;
+			pOuts[i]->height = pRaw->height/2; 
+			pOuts[i]->type  = OSC_PICTURE_HUE;
+		}
+	}
 	return SUCCESS;
 }
 
 
-OSC_ERR OscVisFastDebayerHSL_L(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
+OSC_ERR OscVisFastDebayerHSLPacked(const struct OSC_PICTURE *pRaw, struct OSC_PICTURE *pOut) 
 {
 	uint16 x,y;
 	uint32 outPos = 0;
-	uint8 max, min;
-	uint16 lum;
-	uint16 R, G, B;
 	unsigned char *in  = (unsigned char *)pRaw->data;
 	unsigned char *out = (unsigned char *)pOut->data;
 
+	pthread_once(&hslTablesOnce, InitHslTables);
 	for (y=0; y<pRaw->height; y+=2) {
 		for (x=0; x<pRaw->width; x+=2) {
-			R = in[(y+1)*pRaw->width+x+1];
-			G = in[y*pRaw->width+x+1];
-			B = in[y*pRaw->width+x];
-			
-			/* get max and min */
-			if( R > G ){
-				max = R;
-				min = G;
-			}else{
-				max = G;
-				min = R;
-			}
-			if( B > max ){
-				max = B;
-			}
-			if( B < min ){
-				min = B;
-			}
-			
-			/* luminance */
-			lum = (max + min) >> 1;
-
-			out[outPos++] = (uint8)lum;
-			
+			FastDebayerHSL(in[(y+1)*pRaw->width+x+1], in[y*pRaw->width+x+1], in[y*pRaw->width+x],
+					&out[outPos], &out[outPos + 1], &out[outPos + 2]);
+			outPos += 3;
 		} /* for x */
 	} /* for y */
 	pOut->width  = pRaw->width/2;
 	pOut->height = pRaw->height/2; 
-	pOut->type  = OSC_PICTURE_HUE;
+	pOut->type  = OSC_PICTURE_HSL_24;
 	return SUCCESS;
 }
+
+#if !defined(OSC_HOST)
+OSC_ERR OscVisSetSimd(enum EnOscVisSimd simd)
+{
+	return simd == OSC_VIS_SIMD_NONE ? SUCCESS : -EUNSUPPORTED;
+}
+
+enum EnOscVisSimd OscVisGetSimd(void)
+{
+	return OSC_VIS_SIMD_NONE;
+}
+#endif
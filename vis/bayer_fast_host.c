@@ -0,0 +1,479 @@
+/*	Oscar, a hardware abstraction framework for the LeanXcam and IndXcam.
+	Copyright (C) 2008 Supercomputing Systems AG
+
+	This library is free software; you can redistribute it and/or modify it
+	under the terms of the GNU Lesser General Public License as published by
+	the Free Software Foundation; either version 2.1 of the License, or (at
+	your option) any later version.
+
+	This library is distributed in the hope that it will be useful, but
+	WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser
+	General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public License
+	along with this library; if not, write to the Free Software Foundation,
+	Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+/*! @file
+ * @brief Vectorized row kernels for the fast debayering on the host.
+ *
+ * Every kernel converts the first output pixels of a pair of raw rows and
+ * returns how many it converted. The scalar code in bayer_fast.c does the
+ * rest of the row and is the reference the kernels must match bit by bit.
+ * The arithmetic is done in 16 bit lanes, values stored to the output are
+ * truncated to 8 bits like in the scalar code.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include "vis.h"
+
+/* Fixed-point factors * 128 of the conversion to YUV as used in bayer_fast.c. */
+#define LUM_R 38
+#define LUM_G 75
+#define LUM_B 15
+#define CHROM_U 63
+#define CHROM_V 112
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*============================== SSE2 ==================================*/
+
+/* Internal function: Luminance of 8 pixels in 16 bit lanes. */
+__attribute__((target("sse2")))
+static inline __m128i LumY_SSE2(__m128i r, __m128i g, __m128i b)
+{
+	__m128i y = _mm_mullo_epi16(r, _mm_set1_epi16(LUM_R));
+	y = _mm_add_epi16(y, _mm_mullo_epi16(g, _mm_set1_epi16(LUM_G)));
+	y = _mm_add_epi16(y, _mm_mullo_epi16(b, _mm_set1_epi16(LUM_B)));
+	return _mm_srli_epi16(y, 7);
+}
+
+/* Internal function: Chrominance (U or V) of 8 pixels in 16 bit lanes, truncated to 8 bits. */
+__attribute__((target("sse2")))
+static inline __m128i Chrom_SSE2(__m128i c, __m128i y, const int16 factor)
+{
+	__m128i d = _mm_mullo_epi16(_mm_sub_epi16(c, y), _mm_set1_epi16(factor));
+	d = _mm_add_epi16(_mm_srai_epi16(d, 7), _mm_set1_epi16(128));
+	return _mm_and_si128(d, _mm_set1_epi16(0xff));
+}
+
+/* Internal function: Splits 8 raw pixel pairs of both rows into their colors in 16 bit lanes. */
+__attribute__((target("sse2")))
+static inline void Load_SSE2(const uint8 *pRow0, const uint8 *pRow1, __m128i *pB, __m128i *pG, __m128i *pG2, __m128i *pR)
+{
+	const __m128i v0 = _mm_loadu_si128((const __m128i *)pRow0);
+	const __m128i v1 = _mm_loadu_si128((const __m128i *)pRow1);
+	const __m128i lowByte = _mm_set1_epi16(0xff);
+
+	*pB = _mm_and_si128(v0, lowByte);
+	*pG = _mm_srli_epi16(v0, 8);
+	*pG2 = _mm_and_si128(v1, lowByte);
+	*pR = _mm_srli_epi16(v1, 8);
+}
+
+/* Internal macro: Defines an SSE2 kernel producing one byte per pixel from the colors b, g, g2 and r. */
+#define DEFINE_KERNEL_SSE2(name, expr) \
+__attribute__((target("sse2"))) \
+static uint16 name(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix) \
+{ \
+	__m128i b, g, g2, r, lo, hi; \
+	uint16 i; \
+	for (i = 0; i + 16 <= noOfPix; i += 16) \
+	{ \
+		Load_SSE2(&pRow0[2 * i], &pRow1[2 * i], &b, &g, &g2, &r); \
+		lo = (expr); \
+		Load_SSE2(&pRow0[2 * i + 16], &pRow1[2 * i + 16], &b, &g, &g2, &r); \
+		hi = (expr); \
+		_mm_storeu_si128((__m128i *)&pOut[i], _mm_packus_epi16(lo, hi)); \
+	} \
+	return i; \
+}
+
+DEFINE_KERNEL_SSE2(FastDebayerGrey_SSE2,
+		_mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(b, g), _mm_add_epi16(g2, r)), 2))
+DEFINE_KERNEL_SSE2(FastDebayerLumY_SSE2, LumY_SSE2(r, g, b))
+DEFINE_KERNEL_SSE2(FastDebayerChromU_SSE2, Chrom_SSE2(b, LumY_SSE2(r, g, b), CHROM_U))
+DEFINE_KERNEL_SSE2(FastDebayerChromV_SSE2, Chrom_SSE2(r, LumY_SSE2(r, g, b), CHROM_V))
+
+/* Internal function: Packs U, Y and V of 8 pixels to 4 groups of U1 Y1 V1 Y2. */
+__attribute__((target("sse2")))
+static inline __m128i PackYUV422_SSE2(__m128i y, __m128i u, __m128i v)
+{
+	/* U1 | Y1 << 8 and V1 | Y2 << 8 in the lanes of the first pixel of a pair */
+	const __m128i uy = _mm_or_si128(u, _mm_slli_epi16(y, 8));
+	const __m128i vy = _mm_or_si128(v, _mm_slli_epi16(_mm_srli_epi32(y, 16), 8));
+	return _mm_or_si128(_mm_and_si128(uy, _mm_set1_epi32(0xffff)), _mm_slli_epi32(vy, 16));
+}
+
+__attribute__((target("sse2")))
+static uint16 FastDebayerYUV422_SSE2(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix)
+{
+	__m128i b, g, g2, r, y;
+	uint16 i;
+
+	for (i = 0; i + 8 <= noOfPix; i += 8)
+	{
+		Load_SSE2(&pRow0[2 * i], &pRow1[2 * i], &b, &g, &g2, &r);
+		y = LumY_SSE2(r, g, b);
+		_mm_storeu_si128((__m128i *)&pOut[2 * i],
+				PackYUV422_SSE2(_mm_and_si128(y, _mm_set1_epi16(0xff)), Chrom_SSE2(b, y, CHROM_U), Chrom_SSE2(r, y, CHROM_V)));
+	}
+	return i;
+}
+
+/*============================== SSSE3 =================================*/
+
+/* Positions of the colors of pixel p in the raw row pair, the second row is offset by 16. */
+#define SEL_B(p) (2 * (p))
+#define SEL_G(p) (2 * (p) + 1)
+#define SEL_R(p) (16 + 2 * (p) + 1)
+/* Shuffle indices for the first and second row, -1 gives 0. */
+#define SEL_ROW0(s) ((s) < 16 ? (s) : -1)
+#define SEL_ROW1(s) ((s) >= 16 ? (s) - 16 : -1)
+#define SEL_PIX(row, c0, c1, c2, p) row(c0(p)), row(c1(p)), row(c2(p))
+#define SEL_24(row, c0, c1, c2) \
+	SEL_PIX(row, c0, c1, c2, 0), SEL_PIX(row, c0, c1, c2, 1), SEL_PIX(row, c0, c1, c2, 2), \
+	SEL_PIX(row, c0, c1, c2, 3), SEL_PIX(row, c0, c1, c2, 4), SEL_PIX(row, c0, c1, c2, 5), \
+	SEL_PIX(row, c0, c1, c2, 6), SEL_PIX(row, c0, c1, c2, 7), -1, -1, -1, -1, -1, -1, -1, -1
+
+/* Internal macro: Defines an SSSE3 kernel producing packed 24 bit pixels. Each 8 pixels are
+ * gathered from 16 bytes of both rows into 16 + 8 output bytes. */
+#define DEFINE_KERNEL_SSSE3_24(name, c0, c1, c2) \
+__attribute__((target("ssse3"))) \
+static uint16 name(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix) \
+{ \
+	static const int8 sel0[32] = { SEL_24(SEL_ROW0, c0, c1, c2) }; \
+	static const int8 sel1[32] = { SEL_24(SEL_ROW1, c0, c1, c2) }; \
+	const __m128i idx0Lo = _mm_loadu_si128((const __m128i *)&sel0[0]); \
+	const __m128i idx0Hi = _mm_loadu_si128((const __m128i *)&sel0[16]); \
+	const __m128i idx1Lo = _mm_loadu_si128((const __m128i *)&sel1[0]); \
+	const __m128i idx1Hi = _mm_loadu_si128((const __m128i *)&sel1[16]); \
+	__m128i v0, v1; \
+	uint16 i; \
+	for (i = 0; i + 8 <= noOfPix; i += 8) \
+	{ \
+		v0 = _mm_loadu_si128((const __m128i *)&pRow0[2 * i]); \
+		v1 = _mm_loadu_si128((const __m128i *)&pRow1[2 * i]); \
+		_mm_storeu_si128((__m128i *)&pOut[3 * i], \
+				_mm_or_si128(_mm_shuffle_epi8(v0, idx0Lo), _mm_shuffle_epi8(v1, idx1Lo))); \
+		_mm_storel_epi64((__m128i *)&pOut[3 * i + 16], \
+				_mm_or_si128(_mm_shuffle_epi8(v0, idx0Hi), _mm_shuffle_epi8(v1, idx1Hi))); \
+	} \
+	return i; \
+}
+
+DEFINE_KERNEL_SSSE3_24(FastDebayerBGR_SSSE3, SEL_B, SEL_G, SEL_R)
+DEFINE_KERNEL_SSSE3_24(FastDebayerRGB_SSSE3, SEL_R, SEL_G, SEL_B)
+
+/*============================== AVX2 ==================================*/
+
+__attribute__((target("avx2")))
+static inline __m256i LumY_AVX2(__m256i r, __m256i g, __m256i b)
+{
+	__m256i y = _mm256_mullo_epi16(r, _mm256_set1_epi16(LUM_R));
+	y = _mm256_add_epi16(y, _mm256_mullo_epi16(g, _mm256_set1_epi16(LUM_G)));
+	y = _mm256_add_epi16(y, _mm256_mullo_epi16(b, _mm256_set1_epi16(LUM_B)));
+	return _mm256_srli_epi16(y, 7);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i Chrom_AVX2(__m256i c, __m256i y, const int16 factor)
+{
+	__m256i d = _mm256_mullo_epi16(_mm256_sub_epi16(c, y), _mm256_set1_epi16(factor));
+	d = _mm256_add_epi16(_mm256_srai_epi16(d, 7), _mm256_set1_epi16(128));
+	return _mm256_and_si256(d, _mm256_set1_epi16(0xff));
+}
+
+__attribute__((target("avx2")))
+static inline void Load_AVX2(const uint8 *pRow0, const uint8 *pRow1, __m256i *pB, __m256i *pG, __m256i *pG2, __m256i *pR)
+{
+	const __m256i v0 = _mm256_loadu_si256((const __m256i *)pRow0);
+	const __m256i v1 = _mm256_loadu_si256((const __m256i *)pRow1);
+	const __m256i lowByte = _mm256_set1_epi16(0xff);
+
+	*pB = _mm256_and_si256(v0, lowByte);
+	*pG = _mm256_srli_epi16(v0, 8);
+	*pG2 = _mm256_and_si256(v1, lowByte);
+	*pR = _mm256_srli_epi16(v1, 8);
+}
+
+/* Internal macro: Defines an AVX2 kernel producing one byte per pixel. The packing works
+ * within 128 bit lanes and is reordered by a permutation. */
+#define DEFINE_KERNEL_AVX2(name, expr) \
+__attribute__((target("avx2"))) \
+static uint16 name(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix) \
+{ \
+	__m256i b, g, g2, r, lo, hi; \
+	uint16 i; \
+	for (i = 0; i + 32 <= noOfPix; i += 32) \
+	{ \
+		Load_AVX2(&pRow0[2 * i], &pRow1[2 * i], &b, &g, &g2, &r); \
+		lo = (expr); \
+		Load_AVX2(&pRow0[2 * i + 32], &pRow1[2 * i + 32], &b, &g, &g2, &r); \
+		hi = (expr); \
+		_mm256_storeu_si256((__m256i *)&pOut[i], \
+				_mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xd8)); \
+	} \
+	return i; \
+}
+
+DEFINE_KERNEL_AVX2(FastDebayerGrey_AVX2,
+		_mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(b, g), _mm256_add_epi16(g2, r)), 2))
+DEFINE_KERNEL_AVX2(FastDebayerLumY_AVX2, LumY_AVX2(r, g, b))
+DEFINE_KERNEL_AVX2(FastDebayerChromU_AVX2, Chrom_AVX2(b, LumY_AVX2(r, g, b), CHROM_U))
+DEFINE_KERNEL_AVX2(FastDebayerChromV_AVX2, Chrom_AVX2(r, LumY_AVX2(r, g, b), CHROM_V))
+
+__attribute__((target("avx2")))
+static uint16 FastDebayerYUV422_AVX2(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix)
+{
+	__m256i b, g, g2, r, y, u, v, uy, vy;
+	uint16 i;
+
+	for (i = 0; i + 16 <= noOfPix; i += 16)
+	{
+		Load_AVX2(&pRow0[2 * i], &pRow1[2 * i], &b, &g, &g2, &r);
+		y = LumY_AVX2(r, g, b);
+		u = Chrom_AVX2(b, y, CHROM_U);
+		v = Chrom_AVX2(r, y, CHROM_V);
+		y = _mm256_and_si256(y, _mm256_set1_epi16(0xff));
+		/* see PackYUV422_SSE2() */
+		uy = _mm256_or_si256(u, _mm256_slli_epi16(y, 8));
+		vy = _mm256_or_si256(v, _mm256_slli_epi16(_mm256_srli_epi32(y, 16), 8));
+		_mm256_storeu_si256((__m256i *)&pOut[2 * i],
+				_mm256_or_si256(_mm256_and_si256(uy, _mm256_set1_epi32(0xffff)), _mm256_slli_epi32(vy, 16)));
+	}
+	return i;
+}
+
+#endif /* x86 */
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+/*============================== NEON ==================================*/
+
+/* Internal function: Luminance of 8 pixels in 16 bit lanes. */
+static inline uint16x8_t LumY_NEON(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+	uint16x8_t y = vmull_u8(r, vdup_n_u8(LUM_R));
+	y = vmlal_u8(y, g, vdup_n_u8(LUM_G));
+	y = vmlal_u8(y, b, vdup_n_u8(LUM_B));
+	return vshrq_n_u16(y, 7);
+}
+
+/* Internal function: Chrominance (U or V) of 8 pixels, truncated to 8 bits. */
+static inline uint8x8_t Chrom_NEON(uint8x8_t c, uint16x8_t y, const int16 factor)
+{
+	int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(c)), vreinterpretq_s16_u16(y));
+	d = vshrq_n_s16(vmulq_n_s16(d, factor), 7);
+	return vreinterpret_u8_s8(vmovn_s16(vaddq_s16(d, vdupq_n_s16(128))));
+}
+
+static uint16 FastDebayerBGR_NEON(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix)
+{
+	uint8x16x2_t v0, v1;
+	uint8x16x3_t out;
+	uint16 i;
+
+	for (i = 0; i + 16 <= noOfPix; i += 16)
+	{
+		v0 = vld2q_u8(&pRow0[2 * i]);
+		v1 = vld2q_u8(&pRow1[2 * i]);
+		out.val[0] = v0.val[0];
+		out.val[1] = v0.val[1];
+		out.val[2] = v1.val[1];
+		vst3q_u8(&pOut[3 * i], out);
+	}
+	return i;
+}
+
+static uint16 FastDebayerRGB_NEON(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix)
+{
+	uint8x16x2_t v0, v1;
+	uint8x16x3_t out;
+	uint16 i;
+
+	for (i = 0; i + 16 <= noOfPix; i += 16)
+	{
+		v0 = vld2q_u8(&pRow0[2 * i]);
+		v1 = vld2q_u8(&pRow1[2 * i]);
+		out.val[0] = v1.val[1];
+		out.val[1] = v0.val[1];
+		out.val[2] = v0.val[0];
+		vst3q_u8(&pOut[3 * i], out);
+	}
+	return i;
+}
+
+/* Internal macro: Defines a NEON kernel producing one byte per pixel from the colors b, g, g2
+ * and r of 8 pixels. */
+#define DEFINE_KERNEL_NEON(name, expr) \
+static uint16 name(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix) \
+{ \
+	uint8x8x2_t v0, v1; \
+	uint8x8_t b, g, g2, r; \
+	uint16 i; \
+	for (i = 0; i + 8 <= noOfPix; i += 8) \
+	{ \
+		v0 = vld2_u8(&pRow0[2 * i]); \
+		v1 = vld2_u8(&pRow1[2 * i]); \
+		b = v0.val[0]; \
+		g = v0.val[1]; \
+		g2 = v1.val[0]; \
+		r = v1.val[1]; \
+		vst1_u8(&pOut[i], (expr)); \
+	} \
+	return i; \
+}
+
+DEFINE_KERNEL_NEON(FastDebayerGrey_NEON,
+		vshrn_n_u16(vaddw_u8(vaddw_u8(vaddl_u8(b, g), g2), r), 2))
+DEFINE_KERNEL_NEON(FastDebayerLumY_NEON, vmovn_u16(LumY_NEON(r, g, b)))
+DEFINE_KERNEL_NEON(FastDebayerChromU_NEON, Chrom_NEON(b, LumY_NEON(r, g, b), CHROM_U))
+DEFINE_KERNEL_NEON(FastDebayerChromV_NEON, Chrom_NEON(r, LumY_NEON(r, g, b), CHROM_V))
+
+static uint16 FastDebayerYUV422_NEON(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix)
+{
+	uint8x8x4_t v0, v1, out;
+	uint16x8_t y1, y2;
+	uint16 i;
+
+	/* groups of two pixels: B1 G1 B2 G2 in the first and x R1 x R2 in the second row */
+	for (i = 0; i + 16 <= noOfPix; i += 16)
+	{
+		v0 = vld4_u8(&pRow0[2 * i]);
+		v1 = vld4_u8(&pRow1[2 * i]);
+		y1 = LumY_NEON(v1.val[1], v0.val[1], v0.val[0]);
+		y2 = LumY_NEON(v1.val[3], v0.val[3], v0.val[2]);
+		out.val[0] = Chrom_NEON(v0.val[0], y1, CHROM_U);
+		out.val[1] = vmovn_u16(y1);
+		out.val[2] = Chrom_NEON(v1.val[1], y1, CHROM_V);
+		out.val[3] = vmovn_u16(y2);
+		vst4_u8(&pOut[2 * i], out);
+	}
+	return i;
+}
+
+#endif /* NEON */
+
+/*! @brief The kernels of every instruction set, without kernel if there is none for the function. */
+static const struct FAST_DEBAYER_KERNELS fastDebayerKernels[] = {
+	[OSC_VIS_SIMD_NONE] = { NULL },
+#if defined(__x86_64__) || defined(__i386__)
+	[OSC_VIS_SIMD_SSE2] = {
+		.grey = FastDebayerGrey_SSE2,
+		.lumY = FastDebayerLumY_SSE2,
+		.chromU = FastDebayerChromU_SSE2,
+		.chromV = FastDebayerChromV_SSE2,
+		.yuv422 = FastDebayerYUV422_SSE2
+	},
+	[OSC_VIS_SIMD_SSSE3] = {
+		.bgr = FastDebayerBGR_SSSE3,
+		.rgb = FastDebayerRGB_SSSE3,
+		.grey = FastDebayerGrey_SSE2,
+		.lumY = FastDebayerLumY_SSE2,
+		.chromU = FastDebayerChromU_SSE2,
+		.chromV = FastDebayerChromV_SSE2,
+		.yuv422 = FastDebayerYUV422_SSE2
+	},
+	[OSC_VIS_SIMD_AVX2] = {
+		.bgr = FastDebayerBGR_SSSE3,
+		.rgb = FastDebayerRGB_SSSE3,
+		.grey = FastDebayerGrey_AVX2,
+		.lumY = FastDebayerLumY_AVX2,
+		.chromU = FastDebayerChromU_AVX2,
+		.chromV = FastDebayerChromV_AVX2,
+		.yuv422 = FastDebayerYUV422_AVX2
+	},
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	[OSC_VIS_SIMD_NEON] = {
+		.bgr = FastDebayerBGR_NEON,
+		.rgb = FastDebayerRGB_NEON,
+		.grey = FastDebayerGrey_NEON,
+		.lumY = FastDebayerLumY_NEON,
+		.chromU = FastDebayerChromU_NEON,
+		.chromV = FastDebayerChromV_NEON,
+		.yuv422 = FastDebayerYUV422_NEON
+	},
+#endif
+};
+
+/*! @brief The instruction set currently used. Set once by InitSimd() and only changed by
+ * OscVisSetSimd() afterwards, so the debayering threads just read it. */
+static enum EnOscVisSimd simdInUse = OSC_VIS_SIMD_NONE;
+/*! @brief Makes sure InitSimd() is run exactly once. */
+static pthread_once_t simdOnce = PTHREAD_ONCE_INIT;
+
+/* Internal function: Returns the best instruction set supported by the CPU. */
+static enum EnOscVisSimd DetectSimd(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		return OSC_VIS_SIMD_AVX2;
+	if (__builtin_cpu_supports("ssse3"))
+		return OSC_VIS_SIMD_SSSE3;
+	if (__builtin_cpu_supports("sse2"))
+		return OSC_VIS_SIMD_SSE2;
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	return OSC_VIS_SIMD_NEON;
+#endif
+	return OSC_VIS_SIMD_NONE;
+}
+
+/* Internal function: Returns whether the CPU can execute the kernels of an instruction set. */
+static bool IsSimdSupported(enum EnOscVisSimd simd)
+{
+	const enum EnOscVisSimd best = DetectSimd();
+
+	if (simd == OSC_VIS_SIMD_NONE)
+		return TRUE;
+	if (best == OSC_VIS_SIMD_NEON || simd == OSC_VIS_SIMD_NEON)
+		return simd == best;
+	return simd <= best;
+}
+
+/* Internal function: Selects the best instruction set of the CPU. */
+static void InitSimd(void)
+{
+	simdInUse = DetectSimd();
+}
+
+void FastDebayerInit(void)
+{
+	pthread_once(&simdOnce, InitSimd);
+}
+
+const struct FAST_DEBAYER_KERNELS *FastDebayerGetKernels(void)
+{
+	/* only needed if the vis module has not been created */
+	pthread_once(&simdOnce, InitSimd);
+	return &fastDebayerKernels[simdInUse];
+}
+
+OSC_ERR OscVisSetSimd(enum EnOscVisSimd simd)
+{
+	if ((unsigned int)simd > OSC_VIS_SIMD_NEON || !IsSimdSupported(simd))
+		return -EUNSUPPORTED;
+	pthread_once(&simdOnce, InitSimd);
+	simdInUse = simd;
+	return SUCCESS;
+}
+
+enum EnOscVisSimd OscVisGetSimd(void)
+{
+	pthread_once(&simdOnce, InitSimd);
+	return simdInUse;
+}
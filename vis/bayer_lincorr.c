@@ -23,6 +23,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#if defined(OSC_HOST)
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 #include "vis.h"
 
@@ -545,61 +549,30 @@ inline static void InterpRedAndBlue_FirstOrLastRow(
 	}
 }
 
-OSC_ERR OscVisDebayer(const uint8* pRaw,
+/* Interpolates the green color of the rows rowFirst to rowEnd - 1, which must lie in between
+ * the first two and the last two rows. Only reads the raw image. pOut points to the output
+ * row rowFirst, the output rows must follow each other. */
+static void InterpGreen_CenterRows(const uint8* pRaw,
 		const uint16 width,
-		const uint16 height,
-		enum EnBayerOrder enBayerOrderFirstRow,
+		const uint16 rowFirst,
+		const uint16 rowEnd,
+		const bool bTopLeftIsGreen,
 		uint8 *const pOut)
 {
-	bool        bTopLeftIsGreen, bTopRowIsRed, bFirstPixIsGreen, bRowIsRed, bLastRowIsRed;
-	uint8       *pOutPix, *pOutRow, *pOutPrefetch;
-	const uint8 *pRawPix, *pRawRow, *pRawPrefetch;
+	bool        bFirstPixIsGreen;
+	uint8       *pOutPix, *pOutPrefetch;
+	const uint8 *pRawPix, *pRawPrefetch;
 	uint16      row, col;
-#ifdef BENCHMARK
-	uint32      startCyc;
-#endif
-	
-	/*---------------------- Input validation. -------------------- */
-	if((pRaw == NULL) || (pOut == NULL) || (width == 0) || (height == 0))
-	{
-		OscLog(ERROR, "%s(0x%x, %d, %d, %d 0x%x): Invalid arguments!",
-				__func__, pRaw, width, height, enBayerOrderFirstRow, pOut);
-		return -EINVALID_PARAMETER;
-	}
-	
-	if((!IS_EVEN(width)) || (width < 4) || (height < 4))
-	{
-		OscLog(ERROR, "%s: Invalid parameter! Width: %d Height: %d\n"
-				"Width must be even and >=4 and height must be >=4.\n",
-				__func__, width, height);
-		return -EINVALID_PARAMETER;
-	}
-	
-	bTopLeftIsGreen = (enBayerOrderFirstRow == ROW_GBGB) ||
-						(enBayerOrderFirstRow == ROW_GRGR);
-	bTopRowIsRed = (enBayerOrderFirstRow == ROW_RGRG) ||
-						(enBayerOrderFirstRow == ROW_GRGR);
-	
-	/* -------------- Interpolate all green pixels. -----------------*/
-	
-	BENCH_START(startCyc);
-	/* The first and last two rows must be treated specially. */
-	InterpGreen_FirstTwoRows(pRaw,
-		width,
-		bTopLeftIsGreen,
-		pOut);
-	BENCH_STOP("Green_FirstTwoRows", startCyc);
 	
-	pRawPix = &pRaw[2*width];
+	pRawPix = &pRaw[(uint32)rowFirst*width];
 	pRawPrefetch = &pRawPix[2*width];
-	pOutPix = &pOut[2*BYTES_PER_PIX*width];
+	pOutPix = pOut;
 	pOutPrefetch = &pOutPix[2*width];
-	bFirstPixIsGreen = bTopLeftIsGreen;
+	bFirstPixIsGreen = IS_EVEN(rowFirst) ? bTopLeftIsGreen : !bTopLeftIsGreen;
 	
-	BENCH_START(startCyc);
 	PREFETCH(pRawPrefetch);
 	PREFETCH(pOutPrefetch);
-	for(row = 2; row < height - 2; row++)
+	for(row = rowFirst; row < rowEnd; row++)
 	{
 		/* Interpolate a single row. Copy the pixels that natively
 		 * represent green from the raw data and interpolate the
@@ -651,26 +624,31 @@ OSC_ERR OscVisDebayer(const uint8* pRaw,
 		 * and either blue or red. */
 		bFirstPixIsGreen = !bFirstPixIsGreen;
 	}
-	BENCH_STOP("Green_Center", startCyc);
-	
-	BENCH_START(startCyc);
-	bFirstPixIsGreen = IS_EVEN(height) ? bTopLeftIsGreen : !bTopLeftIsGreen;
-	InterpGreen_LastTwoRows(pRawPix,
-			width,
-			bFirstPixIsGreen,
-			pOutPix);
-	BENCH_STOP("Green_LastTwoRows", startCyc);
-	
-	/* ------------- Interpolate red and blue pixels. ---------------*/
+}
+
+/* Interpolates the red and blue colors of the rows rowFirst to rowEnd - 1, which must lie in
+ * between the first and the last row. Needs the green color of the rows rowFirst - 1 to rowEnd.
+ * pOut points to the output row rowFirst, the output rows must follow each other. */
+static void InterpRedAndBlue_CenterRows(const uint8* pRaw,
+		const uint16 width,
+		const uint16 rowFirst,
+		const uint16 rowEnd,
+		const bool bTopLeftIsGreen,
+		const bool bTopRowIsRed,
+		uint8 *const pOut)
+{
+	bool        bFirstPixIsGreen, bRowIsRed;
+	uint8       *pOutPix, *pOutRow;
+	const uint8 *pRawPix, *pRawRow;
+	uint16      row, col;
 	
-	BENCH_START(startCyc);
-	bFirstPixIsGreen = !bTopLeftIsGreen;
-	bRowIsRed = !bTopRowIsRed;
-	pRawPix = &pRaw[width];
-	pOutPix = &pOut[width*BYTES_PER_PIX];
+	bFirstPixIsGreen = IS_EVEN(rowFirst) ? bTopLeftIsGreen : !bTopLeftIsGreen;
+	bRowIsRed = IS_EVEN(rowFirst) ? bTopRowIsRed : !bTopRowIsRed;
+	pRawPix = &pRaw[(uint32)rowFirst*width];
+	pOutPix = pOut;
 	pOutRow = pOutPix;
 	pRawRow = pRawPix;
-	for(row = 1; row < height - 1; row++)
+	for(row = rowFirst; row < rowEnd; row++)
 	{
 		/* Interpolate a single row. Copy the pixels that natively
 		 * represent green from the raw data and interpolate the
@@ -825,6 +803,256 @@ OSC_ERR OscVisDebayer(const uint8* pRaw,
 		pOutRow += BYTES_PER_PIX*width;
 		pRawRow += width;
 	}
+}
+
+#if defined(OSC_HOST)
+/*! @brief Default height of the row bands processed by the threads of OscVisDebayerParallel(). */
+#define DEBAYER_DEFAULT_BAND_HEIGHT 32
+
+/* Internal structure: A debayering job shared by the threads of OscVisDebayerParallel(). */
+struct DEBAYER_JOB {
+	const uint8 *pRaw;
+	uint16 width, height;
+	bool bTopLeftIsGreen, bTopRowIsRed;
+	uint8 *pOut;
+	uint16 bandHeight;
+	uint32 noOfBands;
+	bool bRedAndBlue;		/* The pass being run: FALSE for green, TRUE for red and blue. */
+	uint32 nextBand;		/* The next band to be taken by a thread. */
+};
+
+/* Internal function: Thread taking row bands of the current pass until all are done. */
+static void *DebayerWorker(void *pArg)
+{
+	struct DEBAYER_JOB *pJob = (struct DEBAYER_JOB *)pArg;
+	uint32 band, rowFirst, rowEnd;
+	
+	while ((band = __sync_fetch_and_add(&pJob->nextBand, 1)) < pJob->noOfBands)
+	{
+		if (!pJob->bRedAndBlue)
+		{
+			/* green of the rows 2 to height - 3 */
+			rowFirst = 2 + band * pJob->bandHeight;
+			rowEnd = MIN(rowFirst + pJob->bandHeight, pJob->height - 2);
+			InterpGreen_CenterRows(pJob->pRaw, pJob->width, rowFirst, rowEnd, pJob->bTopLeftIsGreen,
+					&pJob->pOut[rowFirst * pJob->width * BYTES_PER_PIX]);
+		} else {
+			/* red and blue of the rows 1 to height - 2 */
+			rowFirst = 1 + band * pJob->bandHeight;
+			rowEnd = MIN(rowFirst + pJob->bandHeight, pJob->height - 1);
+			InterpRedAndBlue_CenterRows(pJob->pRaw, pJob->width, rowFirst, rowEnd, pJob->bTopLeftIsGreen,
+					pJob->bTopRowIsRed, &pJob->pOut[rowFirst * pJob->width * BYTES_PER_PIX]);
+		}
+	}
+	return NULL;
+}
+
+/* Internal structure: The threads helping OscVisDebayerParallel(). They are started when first
+ * needed and kept until the vis module is destroyed, see DebayerStopThreads(). */
+static struct DEBAYER_POOL {
+	pthread_mutex_t busy;		/* Held by the caller whose pass the threads run */
+	pthread_mutex_t lock;
+	pthread_cond_t start;		/* Signalled when a pass is handed out or the threads are stopped */
+	pthread_cond_t done;		/* Signalled when the last busy thread has finished */
+	pthread_t threads[OSC_VIS_DEBAYER_MAX_THREADS - 1];
+	bool bBusy[OSC_VIS_DEBAYER_MAX_THREADS - 1];	/* The thread takes part in the current pass */
+	uint16 noOfStarted;
+	uint16 pending;				/* Number of busy threads */
+	struct DEBAYER_JOB *pJob;	/* The job of the current pass */
+	bool bStop;
+} debayerPool = {
+	.busy = PTHREAD_MUTEX_INITIALIZER,
+	.lock = PTHREAD_MUTEX_INITIALIZER,
+	.start = PTHREAD_COND_INITIALIZER,
+	.done = PTHREAD_COND_INITIALIZER
+};
+
+/* Internal function: A thread of the pool, takes part in the passes handed to it until stopped. */
+static void *DebayerPoolThread(void *pArg)
+{
+	const uint16 index = (uint16)(uintptr_t)pArg;
+	struct DEBAYER_JOB *pJob;
+	
+	pthread_mutex_lock(&debayerPool.lock);
+	for (;;)
+	{
+		while (!debayerPool.bBusy[index] && !debayerPool.bStop)
+			pthread_cond_wait(&debayerPool.start, &debayerPool.lock);
+		if (!debayerPool.bBusy[index])
+			break;
+		
+		pJob = debayerPool.pJob;
+		pthread_mutex_unlock(&debayerPool.lock);
+		DebayerWorker(pJob);
+		pthread_mutex_lock(&debayerPool.lock);
+		
+		debayerPool.bBusy[index] = FALSE;
+		if (--debayerPool.pending == 0)
+			pthread_cond_signal(&debayerPool.done);
+	}
+	pthread_mutex_unlock(&debayerPool.lock);
+	return NULL;
+}
+
+/* Internal function: Runs one pass of a debayering job on the calling thread and up to
+ * noOfThreads - 1 threads of the pool. The red and blue pass needs the green of the neighboring
+ * rows, so every pass completes before the next one starts. While the pool runs the pass of
+ * another caller, the calling thread does all the bands itself. */
+static void DebayerRunPass(struct DEBAYER_JOB *pJob, bool bRedAndBlue, uint16 noOfThreads)
+{
+	uint16 i, noOfHelpers;
+	
+	pJob->bRedAndBlue = bRedAndBlue;
+	pJob->nextBand = 0;
+	pJob->noOfBands = ((bRedAndBlue ? pJob->height - 2 : pJob->height - 4) + pJob->bandHeight - 1) / pJob->bandHeight;
+	
+	noOfHelpers = pJob->noOfBands > 1 ? MIN(noOfThreads, pJob->noOfBands) - 1 : 0;
+	if (noOfHelpers == 0 || pthread_mutex_trylock(&debayerPool.busy) != 0)
+	{
+		DebayerWorker(pJob);
+		return;
+	}
+	
+	pthread_mutex_lock(&debayerPool.lock);
+	/* a thread that cannot be started only slows the job down, the bands are taken dynamically */
+	while (debayerPool.noOfStarted < noOfHelpers &&
+			pthread_create(&debayerPool.threads[debayerPool.noOfStarted], NULL, DebayerPoolThread,
+				(void *)(uintptr_t)debayerPool.noOfStarted) == 0)
+		debayerPool.noOfStarted++;
+	noOfHelpers = MIN(noOfHelpers, debayerPool.noOfStarted);
+	
+	debayerPool.pJob = pJob;
+	for (i = 0; i < noOfHelpers; i++)
+		debayerPool.bBusy[i] = TRUE;
+	debayerPool.pending = noOfHelpers;
+	pthread_cond_broadcast(&debayerPool.start);
+	pthread_mutex_unlock(&debayerPool.lock);
+	
+	DebayerWorker(pJob);
+	
+	pthread_mutex_lock(&debayerPool.lock);
+	while (debayerPool.pending > 0)
+		pthread_cond_wait(&debayerPool.done, &debayerPool.lock);
+	pthread_mutex_unlock(&debayerPool.lock);
+	pthread_mutex_unlock(&debayerPool.busy);
+}
+
+void DebayerStopThreads(void)
+{
+	uint16 i;
+	
+	pthread_mutex_lock(&debayerPool.busy);
+	pthread_mutex_lock(&debayerPool.lock);
+	debayerPool.bStop = TRUE;
+	pthread_cond_broadcast(&debayerPool.start);
+	pthread_mutex_unlock(&debayerPool.lock);
+	
+	for (i = 0; i < debayerPool.noOfStarted; i++)
+		pthread_join(debayerPool.threads[i], NULL);
+	debayerPool.noOfStarted = 0;
+	debayerPool.bStop = FALSE;
+	pthread_mutex_unlock(&debayerPool.busy);
+}
+#endif /* OSC_HOST */
+
+/* Internal function: Debayers the image using up to noOfThreads threads for the inner rows. */
+static OSC_ERR Debayer(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pOut,
+		uint16 noOfThreads,
+		uint16 bandHeight)
+{
+	bool        bTopLeftIsGreen, bTopRowIsRed, bFirstPixIsGreen, bLastRowIsRed;
+#if defined(OSC_HOST)
+	struct DEBAYER_JOB job;
+#endif
+#ifdef BENCHMARK
+	uint32      startCyc;
+#endif
+	
+	/*---------------------- Input validation. -------------------- */
+	if((pRaw == NULL) || (pOut == NULL) || (width == 0) || (height == 0))
+	{
+		OscLog(ERROR, "%s(0x%x, %d, %d, %d 0x%x): Invalid arguments!",
+				__func__, pRaw, width, height, enBayerOrderFirstRow, pOut);
+		return -EINVALID_PARAMETER;
+	}
+	
+	if((!IS_EVEN(width)) || (width < 4) || (height < 4))
+	{
+		OscLog(ERROR, "%s: Invalid parameter! Width: %d Height: %d\n"
+				"Width must be even and >=4 and height must be >=4.\n",
+				__func__, width, height);
+		return -EINVALID_PARAMETER;
+	}
+	
+	bTopLeftIsGreen = (enBayerOrderFirstRow == ROW_GBGB) ||
+						(enBayerOrderFirstRow == ROW_GRGR);
+	bTopRowIsRed = (enBayerOrderFirstRow == ROW_RGRG) ||
+						(enBayerOrderFirstRow == ROW_GRGR);
+	
+#if defined(OSC_HOST)
+	job.pRaw = pRaw;
+	job.width = width;
+	job.height = height;
+	job.bTopLeftIsGreen = bTopLeftIsGreen;
+	job.bTopRowIsRed = bTopRowIsRed;
+	job.pOut = pOut;
+	job.bandHeight = bandHeight;
+#else
+	/* the target has a single core */
+	noOfThreads = 1;
+#endif
+	
+	/* -------------- Interpolate all green pixels. -----------------*/
+	
+	BENCH_START(startCyc);
+	/* The first and last two rows must be treated specially. */
+	InterpGreen_FirstTwoRows(pRaw,
+		width,
+		bTopLeftIsGreen,
+		pOut);
+	BENCH_STOP("Green_FirstTwoRows", startCyc);
+	
+	BENCH_START(startCyc);
+#if defined(OSC_HOST)
+	if(noOfThreads > 1)
+		DebayerRunPass(&job, FALSE, noOfThreads);
+	else
+#endif
+	InterpGreen_CenterRows(pRaw,
+			width,
+			2,
+			height - 2,
+			bTopLeftIsGreen,
+			&pOut[2*width*BYTES_PER_PIX]);
+	BENCH_STOP("Green_Center", startCyc);
+	
+	BENCH_START(startCyc);
+	bFirstPixIsGreen = IS_EVEN(height) ? bTopLeftIsGreen : !bTopLeftIsGreen;
+	InterpGreen_LastTwoRows(&pRaw[(uint32)(height - 2)*width],
+			width,
+			bFirstPixIsGreen,
+			&pOut[(uint32)(height - 2)*width*BYTES_PER_PIX]);
+	BENCH_STOP("Green_LastTwoRows", startCyc);
+	
+	/* ------------- Interpolate red and blue pixels. ---------------*/
+	
+	BENCH_START(startCyc);
+#if defined(OSC_HOST)
+	if(noOfThreads > 1)
+		DebayerRunPass(&job, TRUE, noOfThreads);
+	else
+#endif
+	InterpRedAndBlue_CenterRows(pRaw,
+			width,
+			1,
+			height - 1,
+			bTopLeftIsGreen,
+			bTopRowIsRed,
+			&pOut[width*BYTES_PER_PIX]);
 	BENCH_STOP("RedBlue_Center", startCyc);
 	
 	/* Fill in the first and the last row as well as the corners.
@@ -855,6 +1083,238 @@ OSC_ERR OscVisDebayer(const uint8* pRaw,
 	return SUCCESS;
 }
 
+OSC_ERR OscVisDebayer(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pOut)
+{
+	return Debayer(pRaw, width, height, enBayerOrderFirstRow, pOut, 1, 0);
+}
+
+OSC_ERR OscVisDebayerParallel(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pOut,
+		uint16 noOfThreads,
+		uint16 bandHeight)
+{
+	if(noOfThreads > OSC_VIS_DEBAYER_MAX_THREADS)
+	{
+		OscLog(ERROR, "%s: Invalid parameter! At most %d threads are supported.\n",
+				__func__, OSC_VIS_DEBAYER_MAX_THREADS);
+		return -EINVALID_PARAMETER;
+	}
+	
+#if defined(OSC_HOST)
+	if(noOfThreads == 0)
+	{
+		long noOfCpus = sysconf(_SC_NPROCESSORS_ONLN);
+		noOfThreads = noOfCpus > 0 ? MIN(noOfCpus, OSC_VIS_DEBAYER_MAX_THREADS) : 1;
+	}
+	if(bandHeight == 0)
+		bandHeight = DEBAYER_DEFAULT_BAND_HEIGHT;
+#endif
+	return Debayer(pRaw, width, height, enBayerOrderFirstRow, pOut, noOfThreads, bandHeight);
+}
+
+/* Internal type: Output formats of the fused debayering pipelines. */
+enum DEBAYER_PIPELINE_OUTPUT {
+	PIPELINE_GREY,
+	PIPELINE_BW,
+	PIPELINE_YUV420
+};
+
+/*! @brief Clamp an int value to an uint8. */
+#define CLAMP_TO_UINT8(x) ((x) < 0 ? 0 : ((x) > 255 ? 255 : (x)))
+
+/* Internal function: Converts debayered BGR rows to the output of a fused pipeline. The grey
+ * value is calculated as by OscVisBGR2Grey(), the YUV values as by the JPEG encoder. */
+static void DebayerPipelineEmit(const uint8 *pBGR,
+		const uint16 width,
+		const uint16 rowFirst,
+		const uint16 rowEnd,
+		enum DEBAYER_PIPELINE_OUTPUT enOutput,
+		uint8 threshold,
+		bool bDarkIsForeground,
+		uint8 *const pOut)
+{
+	const uint32 stride = (uint32)width*BYTES_PER_PIX;
+	const uint8 foregroundValue = bDarkIsForeground ? 0 : 1;
+	uint16 row, col, k;
+	const uint8 *pIn;
+	uint8 *pOutPix, grey;
+	int32 Y[4], cb, cr;
+	
+	if(enOutput == PIPELINE_YUV420)
+	{
+		/* Every 2x2 block is stored as Y00 Y01 Y10 Y11 Cb Cr, row pair after row pair. */
+		for(row = rowFirst; row < rowEnd; row += 2)
+		{
+			pIn = pBGR;
+			pOutPix = &pOut[(uint32)(row / 2) * 3 * width];
+			for(col = 0; col < width; col += 2)
+			{
+				cb = 0;
+				cr = 0;
+				for(k = 0; k < 4; k++)
+				{
+					const uint8 *pPix = &pIn[(k >> 1) * stride + (k & 1) * BYTES_PER_PIX];
+					const int32 R = pPix[RED_OFF], G = pPix[GREEN_OFF], B = pPix[BLUE_OFF];
+					
+					Y[k] = (77 * R + 150 * G + 29 * B) >> 8;
+					cb += CLAMP_TO_UINT8(((-43 * R - 85 * G + 128 * B) >> 8) + 128);
+					cr += CLAMP_TO_UINT8(((128 * R - 107 * G - 21 * B) >> 8) + 128);
+				}
+				pOutPix[0] = CLAMP_TO_UINT8(Y[0]);
+				pOutPix[1] = CLAMP_TO_UINT8(Y[1]);
+				pOutPix[2] = CLAMP_TO_UINT8(Y[2]);
+				pOutPix[3] = CLAMP_TO_UINT8(Y[3]);
+				pOutPix[4] = (cb + 2) >> 2;
+				pOutPix[5] = (cr + 2) >> 2;
+				pIn += 2*BYTES_PER_PIX;
+				pOutPix += 6;
+			}
+			pBGR += 2*stride;
+		}
+		return;
+	}
+	
+	for(row = rowFirst; row < rowEnd; row++)
+	{
+		pIn = pBGR;
+		pOutPix = &pOut[(uint32)row * width];
+		for(col = 0; col < width; col++)
+		{
+			grey = (15*pIn[BLUE_OFF] + 75*pIn[GREEN_OFF] + 38*pIn[RED_OFF]) >> 7;
+			if(enOutput == PIPELINE_GREY)
+				pOutPix[col] = grey;
+			else
+				pOutPix[col] = grey > threshold ? foregroundValue : !foregroundValue;
+			pIn += BYTES_PER_PIX;
+		}
+		pBGR += stride;
+	}
+}
+
+/* Internal function: Debayers the image strip by strip into the temporary buffer and converts
+ * every strip to the output right away. The result is the one of OscVisDebayer() followed by
+ * the conversion. The green color of the row above and below a strip is calculated twice. */
+static OSC_ERR DebayerPipeline(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		enum DEBAYER_PIPELINE_OUTPUT enOutput,
+		uint8 threshold,
+		bool bDarkIsForeground,
+		uint8 *const pOut)
+{
+	const uint32 stride = (uint32)width*BYTES_PER_PIX;
+	bool bTopLeftIsGreen, bTopRowIsRed;
+	uint16 rowFirst, rowEnd, tempFirst, tempEnd, first, end;
+	
+	if((pRaw == NULL) || (pOut == NULL) || (pTemp == NULL))
+	{
+		OscLog(ERROR, "%s: Invalid arguments!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+	if((!IS_EVEN(width)) || (width < 4) || (height < 4) ||
+			(enOutput == PIPELINE_YUV420 && !IS_EVEN(height)))
+	{
+		OscLog(ERROR, "%s: Invalid parameter! Width: %d Height: %d\n"
+				"Width must be even and >=4 and height must be >=4 (and even for YUV 4:2:0).\n",
+				__func__, width, height);
+		return -EINVALID_PARAMETER;
+	}
+	
+	bTopLeftIsGreen = (enBayerOrderFirstRow == ROW_GBGB) ||
+						(enBayerOrderFirstRow == ROW_GRGR);
+	bTopRowIsRed = (enBayerOrderFirstRow == ROW_RGRG) ||
+						(enBayerOrderFirstRow == ROW_GRGR);
+	
+	for(rowFirst = 0; rowFirst < height; rowFirst = rowEnd)
+	{
+		/* The last two rows are only handled together with the rows before them. */
+		rowEnd = MIN(rowFirst + OSC_VIS_DEBAYER_STRIP_HEIGHT, height);
+		if(height - rowEnd < 3)
+			rowEnd = height;
+		/* The temporary buffer holds the strip and the rows next to it. */
+		tempFirst = rowFirst == 0 ? 0 : rowFirst - 1;
+		tempEnd = rowEnd == height ? height : rowEnd + 1;
+#define TEMP_ROW(row) (&pTemp[((row) - tempFirst) * stride])
+		
+		/* Green of the strip and the rows next to it. */
+		if(tempFirst == 0)
+			InterpGreen_FirstTwoRows(pRaw, width, bTopLeftIsGreen, TEMP_ROW(0));
+		first = MAX(tempFirst, 2);
+		end = MIN(tempEnd, height - 2);
+		if(first < end)
+			InterpGreen_CenterRows(pRaw, width, first, end, bTopLeftIsGreen, TEMP_ROW(first));
+		if(tempEnd == height)
+			InterpGreen_LastTwoRows(&pRaw[(uint32)(height - 2)*width],
+					width,
+					IS_EVEN(height) ? bTopLeftIsGreen : !bTopLeftIsGreen,
+					TEMP_ROW(height - 2));
+		
+		/* Red and blue of the strip. */
+		first = MAX(rowFirst, 1);
+		end = MIN(rowEnd, height - 1);
+		InterpRedAndBlue_CenterRows(pRaw, width, first, end, bTopLeftIsGreen, bTopRowIsRed, TEMP_ROW(first));
+		if(rowEnd == height)
+			InterpRedAndBlue_FirstOrLastRow(&pRaw[(uint32)(height - 1)*width],
+					width,
+					IS_EVEN(height) ? !bTopRowIsRed : bTopRowIsRed,
+					IS_EVEN(height) ? !bTopLeftIsGreen : bTopLeftIsGreen,
+					TEMP_ROW(height - 2),
+					TEMP_ROW(height - 1));
+		if(rowFirst == 0)
+			InterpRedAndBlue_FirstOrLastRow(pRaw,
+					width,
+					bTopRowIsRed,
+					bTopLeftIsGreen,
+					TEMP_ROW(1),
+					TEMP_ROW(0));
+		
+		DebayerPipelineEmit(TEMP_ROW(rowFirst), width, rowFirst, rowEnd, enOutput, threshold, bDarkIsForeground, pOut);
+#undef TEMP_ROW
+	}
+	return SUCCESS;
+}
+
+OSC_ERR OscVisDebayerGrey(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		uint8 *const pOut)
+{
+	return DebayerPipeline(pRaw, width, height, enBayerOrderFirstRow, pTemp, PIPELINE_GREY, 0, FALSE, pOut);
+}
+
+OSC_ERR OscVisDebayerBW(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		uint8 threshold,
+		bool bDarkIsForeground,
+		uint8 *const pOut)
+{
+	return DebayerPipeline(pRaw, width, height, enBayerOrderFirstRow, pTemp, PIPELINE_BW, threshold, bDarkIsForeground, pOut);
+}
+
+OSC_ERR OscVisDebayerYUV420(const uint8* pRaw,
+		const uint16 width,
+		const uint16 height,
+		enum EnBayerOrder enBayerOrderFirstRow,
+		uint8 *const pTemp,
+		uint8 *const pOut)
+{
+	return DebayerPipeline(pRaw, width, height, enBayerOrderFirstRow, pTemp, PIPELINE_YUV420, 0, FALSE, pOut);
+}
+
 OSC_ERR OscVisDebayerGreyscaleHalfSize(uint8 const * const pRaw, uint16 const width, uint16 const height, enum EnBayerOrder const enBayerOrderFirstRow, uint8 * const pOut)
 {
 	bool bTopLeftIsGreen;
@@ -23,6 +23,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "vis.h"
 
@@ -41,13 +42,15 @@ int8 aGauss5x5[25] = { 1, 4, 6, 4, 1,
 				       1, 4, 6, 4, 1 };				    
 struct OSC_VIS_FILTER_KERNEL GAUSS5X5 = {5, 5, 256, aGauss5x5};
 
-/* Realization of a 3x3 Median filter kernel */
+/* Realization of a 3x3 Median filter kernel. Used with OscVisFilter2D(), this computes the
+ * mean of the neighbourhood. Use OscVisMedianFilter() for a rank-order median. */
 int8 aMedian3x3[9] = { 1,  1,  1,
 				       1,  1,  1,
 				       1,  1,  1 };				    
 struct OSC_VIS_FILTER_KERNEL MEDIAN3X3 = {3, 3, 9, aMedian3x3};
 
-/* Realization of a 5x5 Median filter kernel */
+/* Realization of a 5x5 Median filter kernel. Used with OscVisFilter2D(), this computes the
+ * mean of the neighbourhood. Use OscVisMedianFilter() for a rank-order median. */
 int8 aMedian5x5[25] = { 1, 1, 1, 1, 1,
 				       1, 1, 1, 1, 1,
 				       1, 1, 1, 1, 1,
@@ -57,6 +60,137 @@ struct OSC_VIS_FILTER_KERNEL MEDIAN5X5 = {5, 5, 25, aMedian5x5};
 
 
 
+/* Internal function: Checks whether the kernel is the outer product of a column and a row vector
+ * with non-negative integer entries. On success, the vectors are written to pCol and pRow. */
+static bool SplitKernel(const struct OSC_VIS_FILTER_KERNEL *pKernel, uint16 *pCol, uint16 *pRow)
+{
+	const uint8 kw = pKernel->kernelWidth;
+	const uint8 kh = pKernel->kernelHeight;
+	const int8 *k = pKernel->kernelArray;
+	uint16 x, y, r0 = 0, c0 = 0, g = 0, a, b, t;
+	
+	/* only odd kernel sizes with non-negative coefficients are handled */
+	if ((kw & 1) == 0 || (kh & 1) == 0)
+		return FALSE;
+	for (y = 0; y < kh * kw; y++)
+		if (k[y] < 0)
+			return FALSE;
+	
+	/* find the first non-zero coefficient */
+	for (y = 0; y < kh * kw && k[y] == 0; y++);
+	if (y == kh * kw)
+		return FALSE;
+	r0 = y / kw;
+	c0 = y % kw;
+	
+	/* the row vector is the row r0 divided by the gcd of its coefficients */
+	for (x = 0; x < kw; x++)
+	{
+		a = g;
+		b = k[r0 * kw + x];
+		while (b != 0)
+		{
+			t = a % b;
+			a = b;
+			b = t;
+		}
+		g = a;
+	}
+	for (x = 0; x < kw; x++)
+		pRow[x] = k[r0 * kw + x] / g;
+	
+	/* the column vector follows from the column c0, then verify the outer product */
+	for (y = 0; y < kh; y++)
+	{
+		pCol[y] = k[y * kw + c0] / pRow[c0];
+		for (x = 0; x < kw; x++)
+			if (pCol[y] * pRow[x] != k[y * kw + x])
+				return FALSE;
+	}
+	return TRUE;
+}
+
+/* Internal function: Separable filter engine. Sums up the kernel rows for every column first
+ * (vertical pass) and then applies the row vector to these column sums (horizontal pass). Uniform
+ * (box) kernels update both sums incrementally instead of recomputing them. */
+static void Filter2DSeparable(const uint8 *pIn, uint8 *pOut, const uint16 width, const uint16 height,
+		const struct OSC_VIS_FILTER_KERNEL *pKernel, const uint16 *pCol, const uint16 *pRow)
+{
+	const uint8 kw = pKernel->kernelWidth;
+	const uint8 kh = pKernel->kernelHeight;
+	const uint16 weight = pKernel->kernelWeight;
+	const uint16 yOffset = (kh - 1) >> 1;
+	const uint16 xOffset = (kw - 1) >> 1;
+	const bool isPow2 = (weight & (weight - 1)) == 0;
+	uint32 colSum[width];
+	uint32 sum, tempVal;
+	uint16 x, y, kx, ky;
+	uint8 shift = 0;
+	bool isBox = TRUE;
+	
+	for (ky = 1; ky < kh; ky++)
+		isBox = isBox && pCol[ky] == pCol[0];
+	for (kx = 1; kx < kw; kx++)
+		isBox = isBox && pRow[kx] == pRow[0];
+	
+	/* divisions by a power of two are done by shifting */
+	if (isPow2)
+		while ((1 << shift) < weight)
+			shift++;
+	
+	for (y = yOffset; y < (height - yOffset); y++)
+	{
+		const uint8 *pLine;
+		
+		/* vertical pass */
+		if (isBox && y > yOffset)
+		{
+			const uint8 *pAdd = &pIn[(y + yOffset) * width];
+			const uint8 *pSub = &pIn[(y - yOffset - 1) * width];
+			for (x = 0; x < width; x++)
+				colSum[x] += pAdd[x] - pSub[x];
+		}
+		else
+		{
+			memset(colSum, 0, sizeof colSum);
+			for (ky = 0; ky < kh; ky++)
+			{
+				const uint16 c = isBox ? 1 : pCol[ky];
+				pLine = &pIn[(y - yOffset + ky) * width];
+				for (x = 0; x < width; x++)
+					colSum[x] += c * pLine[x];
+			}
+		}
+		
+		/* horizontal pass */
+		sum = 0;
+		if (isBox)
+			for (kx = 0; kx < kw - 1; kx++)
+				sum += colSum[kx];
+		for (x = xOffset; x < (width - xOffset); x++)
+		{
+			if (isBox)
+			{
+				sum += colSum[x + xOffset];
+				tempVal = sum * pCol[0] * pRow[0];
+				sum -= colSum[x - xOffset];
+			}
+			else
+			{
+				const uint32 *pSum = &colSum[x - xOffset];
+				tempVal = 0;
+				for (kx = 0; kx < kw; kx++)
+					tempVal += pRow[kx] * pSum[kx];
+			}
+			
+			if (isPow2)
+				pOut[y * width + x] = tempVal >> shift;
+			else
+				pOut[y * width + x] = tempVal / weight;
+		}
+	}
+}
+
 /* A generic 2D filter for grayscale images */
 OSC_ERR OscVisFilter2D(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_FILTER_KERNEL *pKernel)
 {
@@ -68,6 +202,7 @@ OSC_ERR OscVisFilter2D(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, ui
 	uint16 x,y,kx,ky;
 	uint16 yOffset, xOffset;
 	uint32 tempVal;
+	uint16 aCol[256], aRow[256];
 	
 	/* move the initial start pixel according to the size of the kernel (boundary condition). */			
 	if (pKernel->kernelHeight > 0)
@@ -78,24 +213,36 @@ OSC_ERR OscVisFilter2D(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, ui
 		xOffset = (pKernel->kernelWidth-1) >> 1;
 	else xOffset = 0;
 	
-	/* copy the input image to the temporary buffer */
-	memcpy_inline(pTemp, pIn, ((sizeof(uint8)*width*height) >> 2));
-	/* safe area computation */
-	for(y = yOffset; y < (height - yOffset); y++)
+	/* copy the input image to the temporary buffer if operating in-place */
+	if (picIn->data == picOut->data)
 	{
-		for(x = xOffset; x < (width - xOffset); x++)
-		{		
-			tempVal = 0;
-			for(ky = 0; ky < pKernel->kernelHeight; ky++)
-			{
-				for(kx = 0; kx < pKernel->kernelWidth; kx++)
+		memcpy(pTemp, pIn, sizeof(uint8)*width*height);
+		pIn = pTemp;
+	}
+	
+	if (pKernel->kernelWeight != 0 && SplitKernel(pKernel, aCol, aRow))
+	{
+		Filter2DSeparable(pIn, pOut, width, height, pKernel, aCol, aRow);
+	}
+	else
+	{
+		/* safe area computation */
+		for(y = yOffset; y < (height - yOffset); y++)
+		{
+			for(x = xOffset; x < (width - xOffset); x++)
+			{		
+				tempVal = 0;
+				for(ky = 0; ky < pKernel->kernelHeight; ky++)
 				{
-					tempVal = tempVal + (pTemp[(y-yOffset+ky) * width + (x-xOffset+kx)] * pKernel->kernelArray[ky * pKernel->kernelWidth + kx]);
+					for(kx = 0; kx < pKernel->kernelWidth; kx++)
+					{
+						tempVal = tempVal + (pIn[(y-yOffset+ky) * width + (x-xOffset+kx)] * pKernel->kernelArray[ky * pKernel->kernelWidth + kx]);
+					}
 				}
+				pOut[y * width + x] = tempVal/pKernel->kernelWeight;	
 			}
-			pOut[y * width + x] = tempVal/pKernel->kernelWeight;	
 		}
-	}	
+	}
 	/* finalize picture */
 	picOut->width = width;
 	picOut->height = height;
@@ -103,10 +250,215 @@ OSC_ERR OscVisFilter2D(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, ui
 	return SUCCESS;	
 }
 
+/* Internal macro: Orders two pixel values so that a <= b. Written as min/max to compile without branches. */
+#define PIX_SORT(a, b) { const uint8 lo = MIN(a, b), hi = MAX(a, b); (a) = lo; (b) = hi; }
 
+/* Internal function: Median of 9 values using a sorting network with 19 exchanges. */
+static inline uint8 Median9(uint8 *p)
+{
+	PIX_SORT(p[1], p[2]); PIX_SORT(p[4], p[5]); PIX_SORT(p[7], p[8]);
+	PIX_SORT(p[0], p[1]); PIX_SORT(p[3], p[4]); PIX_SORT(p[6], p[7]);
+	PIX_SORT(p[1], p[2]); PIX_SORT(p[4], p[5]); PIX_SORT(p[7], p[8]);
+	PIX_SORT(p[0], p[3]); PIX_SORT(p[5], p[8]); PIX_SORT(p[4], p[7]);
+	PIX_SORT(p[3], p[6]); PIX_SORT(p[1], p[4]); PIX_SORT(p[2], p[5]);
+	PIX_SORT(p[4], p[7]); PIX_SORT(p[4], p[2]); PIX_SORT(p[6], p[4]);
+	PIX_SORT(p[4], p[2]);
+	return p[4];
+}
 
+/* Internal function: Median of 25 values using a sorting network with 99 exchanges. */
+static inline uint8 Median25(uint8 *p)
+{
+	PIX_SORT(p[0], p[1]);   PIX_SORT(p[3], p[4]);   PIX_SORT(p[2], p[4]);
+	PIX_SORT(p[2], p[3]);   PIX_SORT(p[6], p[7]);   PIX_SORT(p[5], p[7]);
+	PIX_SORT(p[5], p[6]);   PIX_SORT(p[9], p[10]);  PIX_SORT(p[8], p[10]);
+	PIX_SORT(p[8], p[9]);   PIX_SORT(p[12], p[13]); PIX_SORT(p[11], p[13]);
+	PIX_SORT(p[11], p[12]); PIX_SORT(p[15], p[16]); PIX_SORT(p[14], p[16]);
+	PIX_SORT(p[14], p[15]); PIX_SORT(p[18], p[19]); PIX_SORT(p[17], p[19]);
+	PIX_SORT(p[17], p[18]); PIX_SORT(p[21], p[22]); PIX_SORT(p[20], p[22]);
+	PIX_SORT(p[20], p[21]); PIX_SORT(p[23], p[24]); PIX_SORT(p[2], p[5]);
+	PIX_SORT(p[3], p[6]);   PIX_SORT(p[0], p[6]);   PIX_SORT(p[0], p[3]);
+	PIX_SORT(p[4], p[7]);   PIX_SORT(p[1], p[7]);   PIX_SORT(p[1], p[4]);
+	PIX_SORT(p[11], p[14]); PIX_SORT(p[8], p[14]);  PIX_SORT(p[8], p[11]);
+	PIX_SORT(p[12], p[15]); PIX_SORT(p[9], p[15]);  PIX_SORT(p[9], p[12]);
+	PIX_SORT(p[13], p[16]); PIX_SORT(p[10], p[16]); PIX_SORT(p[10], p[13]);
+	PIX_SORT(p[20], p[23]); PIX_SORT(p[17], p[23]); PIX_SORT(p[17], p[20]);
+	PIX_SORT(p[21], p[24]); PIX_SORT(p[18], p[24]); PIX_SORT(p[18], p[21]);
+	PIX_SORT(p[19], p[22]); PIX_SORT(p[8], p[17]);  PIX_SORT(p[9], p[18]);
+	PIX_SORT(p[0], p[18]);  PIX_SORT(p[0], p[9]);   PIX_SORT(p[10], p[19]);
+	PIX_SORT(p[1], p[19]);  PIX_SORT(p[1], p[10]);  PIX_SORT(p[11], p[20]);
+	PIX_SORT(p[2], p[20]);  PIX_SORT(p[2], p[11]);  PIX_SORT(p[12], p[21]);
+	PIX_SORT(p[3], p[21]);  PIX_SORT(p[3], p[12]);  PIX_SORT(p[13], p[22]);
+	PIX_SORT(p[4], p[22]);  PIX_SORT(p[4], p[13]);  PIX_SORT(p[14], p[23]);
+	PIX_SORT(p[5], p[23]);  PIX_SORT(p[5], p[14]);  PIX_SORT(p[15], p[24]);
+	PIX_SORT(p[6], p[24]);  PIX_SORT(p[6], p[15]);  PIX_SORT(p[7], p[16]);
+	PIX_SORT(p[7], p[19]);  PIX_SORT(p[13], p[21]); PIX_SORT(p[15], p[23]);
+	PIX_SORT(p[7], p[13]);  PIX_SORT(p[7], p[15]);  PIX_SORT(p[1], p[9]);
+	PIX_SORT(p[3], p[11]);  PIX_SORT(p[5], p[17]);  PIX_SORT(p[11], p[17]);
+	PIX_SORT(p[9], p[17]);  PIX_SORT(p[4], p[10]);  PIX_SORT(p[6], p[12]);
+	PIX_SORT(p[7], p[14]);  PIX_SORT(p[4], p[6]);   PIX_SORT(p[4], p[7]);
+	PIX_SORT(p[12], p[14]); PIX_SORT(p[10], p[14]); PIX_SORT(p[6], p[7]);
+	PIX_SORT(p[10], p[12]); PIX_SORT(p[6], p[10]);  PIX_SORT(p[6], p[17]);
+	PIX_SORT(p[12], p[17]); PIX_SORT(p[7], p[17]);  PIX_SORT(p[7], p[10]);
+	PIX_SORT(p[12], p[18]); PIX_SORT(p[7], p[12]);  PIX_SORT(p[10], p[18]);
+	PIX_SORT(p[12], p[20]); PIX_SORT(p[10], p[20]); PIX_SORT(p[10], p[12]);
+	return p[12];
+}
 
+/* Internal function: Median filter for 3x3 and 5x5 windows based on sorting networks. */
+static void MedianFilterNetwork(const uint8 *pIn, uint8 *pOut, const uint16 width, const uint16 height, const uint8 kernelSize)
+{
+	const uint16 r = kernelSize >> 1;
+	uint16 x, y, kx, ky;
+	uint8 p[25];
+	
+	for (y = r; y < height - r; y++)
+	{
+		for (x = r; x < width - r; x++)
+		{
+			const uint8 *pWin = &pIn[(y - r) * width + x - r];
+			for (ky = 0; ky < kernelSize; ky++)
+				for (kx = 0; kx < kernelSize; kx++)
+					p[ky * kernelSize + kx] = pWin[ky * width + kx];
+			if (kernelSize == 3)
+				pOut[y * width + x] = Median9(p);
+			else
+				pOut[y * width + x] = Median25(p);
+		}
+	}
+}
 
+/* Internal structure: Histogram of one image column split into 16 coarse and 16x16 fine bins. */
+struct MEDIAN_COLUMN_HIST {
+	uint8 coarse[16];
+	uint8 fine[16][16];
+};
 
+/* Internal function: Median filter with a per-pixel cost independent of the window size. Based on
+ * S. Perreault and P. Hebert, "Median Filtering in Constant Time", IEEE TIP, 2007: Every column
+ * keeps a histogram over the rows of the window, which is updated with one addition and one removal
+ * per row. The window histogram is updated by adding and removing column histograms. Of the fine
+ * bins, only the block containing the median is brought up to date, when it is needed.
+ * The column histograms are stored in pCols, which holds width entries. */
+static void MedianFilterHistogram(const uint8 *pIn, uint8 *pOut, struct MEDIAN_COLUMN_HIST *pCols, const uint16 width, const uint16 height, const uint8 kernelSize)
+{
+	const uint16 r = kernelSize >> 1;
+	const uint32 rank = ((uint32)kernelSize * kernelSize) >> 1;
+	uint16 coarse[16];
+	uint16 fine[16][16];
+	int32 lastUpdated[16];
+	uint32 sum;
+	uint16 x, y, c, b, i;
+	
+	/* initialize the column histograms with the first kernelSize rows */
+	memset(pCols, 0, sizeof(struct MEDIAN_COLUMN_HIST) * width);
+	for (y = 0; y < kernelSize; y++)
+	{
+		for (x = 0; x < width; x++)
+		{
+			const uint8 v = pIn[y * width + x];
+			pCols[x].coarse[v >> 4]++;
+			pCols[x].fine[v >> 4][v & 0xf]++;
+		}
+	}
+	
+	for (y = r; y < height - r; y++)
+	{
+		/* slide the column histograms down by one row */
+		if (y > r)
+		{
+			const uint8 *pSub = &pIn[(y - r - 1) * width];
+			const uint8 *pAdd = &pIn[(y + r) * width];
+			for (x = 0; x < width; x++)
+			{
+				pCols[x].coarse[pSub[x] >> 4]--;
+				pCols[x].fine[pSub[x] >> 4][pSub[x] & 0xf]--;
+				pCols[x].coarse[pAdd[x] >> 4]++;
+				pCols[x].fine[pAdd[x] >> 4][pAdd[x] & 0xf]++;
+			}
+		}
+		
+		/* window histogram at the start of the row, the fine bins are filled on demand */
+		memset(coarse, 0, sizeof coarse);
+		for (c = 0; c < kernelSize; c++)
+			for (b = 0; b < 16; b++)
+				coarse[b] += pCols[c].coarse[b];
+		for (b = 0; b < 16; b++)
+			lastUpdated[b] = -1;
+		
+		for (x = r; x < width - r; x++)
+		{
+			if (x > r)
+			{
+				for (b = 0; b < 16; b++)
+					coarse[b] += pCols[x + r].coarse[b] - pCols[x - r - 1].coarse[b];
+			}
+			
+			/* find the coarse bin containing the median */
+			sum = 0;
+			for (b = 0; b < 15 && sum + coarse[b] <= rank; b++)
+				sum += coarse[b];
+			
+			/* bring the fine bins of this block up to date */
+			if (lastUpdated[b] < 0 || x - lastUpdated[b] > 2 * r)
+			{
+				memset(fine[b], 0, sizeof fine[b]);
+				for (c = x - r; c <= x + r; c++)
+					for (i = 0; i < 16; i++)
+						fine[b][i] += pCols[c].fine[b][i];
+			}
+			else
+			{
+				for (c = lastUpdated[b] + 1; c <= x; c++)
+					for (i = 0; i < 16; i++)
+						fine[b][i] += pCols[c + r].fine[b][i] - pCols[c - r - 1].fine[b][i];
+			}
+			lastUpdated[b] = x;
+			
+			/* find the median within the block */
+			for (i = 0; i < 15 && sum + fine[b][i] <= rank; i++)
+				sum += fine[b][i];
+			pOut[y * width + x] = (b << 4) | i;
+		}
+	}
+}
 
-
+/* Rank-order median filter for grayscale images */
+OSC_ERR OscVisMedianFilter(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, uint8 kernelSize)
+{
+	const uint8 *pIn = (uint8*)picIn->data;
+	uint8 *pOut = (uint8*)picOut->data;
+	const uint16 width = picIn->width;
+	const uint16 height = picIn->height;
+	
+	if ((kernelSize & 1) == 0 || kernelSize > width || kernelSize > height)
+	{
+		OscLog(ERROR, "%s: Invalid kernel size %u for a %ux%u image!\n",
+				__func__, kernelSize, width, height);
+		return -EINVALID_PARAMETER;
+	}
+	if (pTemp == NULL && (picIn->data == picOut->data || kernelSize > 5))
+	{
+		OscLog(ERROR, "%s: A temporary buffer is needed!\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+	
+	/* copy the input image to the temporary buffer if operating in-place */
+	if (picIn->data == picOut->data)
+	{
+		memcpy(pTemp, pIn, sizeof(uint8)*width*height);
+		pIn = pTemp;
+		pTemp += width*height;
+	}
+	
+	if (kernelSize == 3 || kernelSize == 5)
+		MedianFilterNetwork(pIn, pOut, width, height, kernelSize);
+	else
+		MedianFilterHistogram(pIn, pOut, (struct MEDIAN_COLUMN_HIST *)pTemp, width, height, kernelSize);
+	
+	/* finalize picture */
+	picOut->width = width;
+	picOut->height = height;
+	picOut->type = OSC_PICTURE_GREYSCALE;
+	return SUCCESS;
+}
@@ -180,3 +180,403 @@ OSC_ERR OscVisDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint
 
 
 
+
+/* Internal function: Returns word k of a packed row, with the bits past the image width and the
+ * words outside the row set to the fill value. */
+static inline uint32 PackedWord(const uint32 *pRow, int32 k, const uint16 nWords, const uint32 lastMask, const uint32 fill)
+{
+	if (k < 0 || k >= nWords)
+		return fill;
+	if (k == nWords - 1)
+		return (pRow[k] & lastMask) | (fill & ~lastMask);
+	return pRow[k];
+}
+
+/* Internal function: Returns word k of a packed row moved by dx pixels, so that bit i holds the
+ * pixel at column 32 * k + i + dx. */
+static inline uint32 PackedShiftedWord(const uint32 *pRow, const int32 k, const int32 dx, const uint16 nWords, const uint32 lastMask, const uint32 fill)
+{
+	const int32 q = k + (dx >> 5);
+	const uint8 s = dx & 31;
+	
+	if (s == 0)
+		return PackedWord(pRow, q, nWords, lastMask, fill);
+	return (PackedWord(pRow, q, nWords, lastMask, fill) >> s) |
+		(PackedWord(pRow, q + 1, nWords, lastMask, fill) << (32 - s));
+}
+
+/* Internal function: One erosion or dilation of a packed binary image with a (sub) structuring
+ * element. 32 pixels are combined with a single AND resp. OR per offset vector. Pixels outside of
+ * the image are treated as foreground for erosion and as background for dilation. */
+static void PackedMorphPass(const uint32 *pSrc, uint32 *pDst, const uint16 width, const uint16 height, const struct OSC_VIS_SUBSTREL *pSubStrEl, const bool isErosion)
+{
+	const uint16 nWords = OSC_VIS_PACKED_WORDS_PER_ROW(width);
+	const uint32 lastMask = (width & 31) ? ((uint32)1 << (width & 31)) - 1 : ~(uint32)0;
+	const uint32 fill = isErosion ? ~(uint32)0 : 0;
+	int32 y, k;
+	uint16 t;
+	
+	for (y = 0; y < height; y++)
+	{
+		uint32 *pOut = &pDst[y * nWords];
+		
+		/* start with the center pixel */
+		for (k = 0; k < nWords; k++)
+			pOut[k] = pSrc[y * nWords + k];
+		
+		for (t = 0; t < pSubStrEl->arrayLength; t += 2)
+		{
+			const int32 dx = pSubStrEl->kernelArray[t];
+			const int32 dy = pSubStrEl->kernelArray[t + 1];
+			const uint32 *pRow;
+			uint16 nRowWords = nWords;
+			
+			if (y + dy < 0 || y + dy >= height)
+			{
+				/* rows outside of the image only consist of fill words */
+				pRow = NULL;
+				nRowWords = 0;
+			}
+			else
+				pRow = &pSrc[(y + dy) * nWords];
+			
+			if (isErosion)
+			{
+				for (k = 0; k < nWords; k++)
+					pOut[k] &= PackedShiftedWord(pRow, k, dx, nRowWords, lastMask, fill);
+			}
+			else
+			{
+				for (k = 0; k < nWords; k++)
+					pOut[k] |= PackedShiftedWord(pRow, k, dx, nRowWords, lastMask, fill);
+			}
+		}
+		/* keep the padding bits cleared */
+		pOut[nWords - 1] &= lastMask;
+	}
+}
+
+/* Internal function: Applies a sequence of erosions and dilations to a packed image. The passes
+ * alternate between the output and the temporary buffer, so that no intermediate copies are needed. */
+static OSC_ERR PackedMorph(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, const uint8 nRepetitions, const bool isErosionFirst, const bool isCompound)
+{
+	const uint16 width = picIn->width;
+	const uint16 height = picIn->height;
+	const uint8 nSubElements = pStrEl->isDecomposed ? pStrEl->numberOfSubElements : 1;
+	const uint32 nPasses = (isCompound ? 2 : 1) * nRepetitions * nSubElements;
+	const uint32 *pSrc = (uint32*)picIn->data;
+	uint32 *pOut = (uint32*)picOut->data;
+	uint32 *pDst;
+	uint32 pass;
+	
+	if (picIn->type != OSC_PICTURE_BINARY_PACKED)
+		return -EINVALID_PARAMETER;
+	
+	for (pass = 0; pass < nPasses; pass++)
+	{
+		/* the last pass has to write to the output buffer */
+		pDst = ((nPasses - pass) & 1) ? pOut : pTempBuffer;
+		if (pDst == pSrc)
+			pDst = (pDst == pOut) ? pTempBuffer : pOut;
+		
+		PackedMorphPass(pSrc, pDst, width, height, &pStrEl->subStrEl[pass % nSubElements],
+				isErosionFirst == (pass < nPasses / (isCompound ? 2 : 1)));
+		pSrc = pDst;
+	}
+	if (pSrc != pOut)
+		memcpy(pOut, pSrc, sizeof(uint32) * OSC_VIS_PACKED_WORDS_PER_ROW(width) * height);
+	
+	/* finalize picture */
+	picOut->height = height;
+	picOut->width = width;
+	picOut->type = OSC_PICTURE_BINARY_PACKED;
+	return SUCCESS;
+}
+
+OSC_ERR OscVisBinaryPack(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut)
+{
+	const uint8 *pIn = (uint8*)picIn->data;
+	uint32 *pOut = (uint32*)picOut->data;
+	const uint16 width = picIn->width;
+	const uint16 height = picIn->height;
+	uint16 x, y, b;
+	
+	if (picIn->type != OSC_PICTURE_BINARY)
+		return -EINVALID_PARAMETER;
+	
+	for (y = 0; y < height; y++)
+	{
+		for (x = 0; x < width; x += 32)
+		{
+			const uint16 n = MIN(32, width - x);
+			uint32 word = 0;
+			for (b = 0; b < n; b++)
+				word |= (uint32)(pIn[b] != 0) << b;
+			*pOut++ = word;
+			pIn += n;
+		}
+	}
+	/* finalize picture */
+	picOut->height = height;
+	picOut->width = width;
+	picOut->type = OSC_PICTURE_BINARY_PACKED;
+	return SUCCESS;
+}
+
+OSC_ERR OscVisBinaryUnpack(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut)
+{
+	const uint32 *pIn = (uint32*)picIn->data;
+	uint8 *pOut = (uint8*)picOut->data;
+	const uint16 width = picIn->width;
+	const uint16 height = picIn->height;
+	uint16 x, y, b;
+	
+	if (picIn->type != OSC_PICTURE_BINARY_PACKED)
+		return -EINVALID_PARAMETER;
+	
+	for (y = 0; y < height; y++)
+	{
+		for (x = 0; x < width; x += 32)
+		{
+			const uint16 n = MIN(32, width - x);
+			const uint32 word = *pIn++;
+			for (b = 0; b < n; b++)
+				pOut[b] = (word >> b) & 1;
+			pOut += n;
+		}
+	}
+	/* finalize picture */
+	picOut->height = height;
+	picOut->width = width;
+	picOut->type = OSC_PICTURE_BINARY;
+	return SUCCESS;
+}
+
+OSC_ERR OscVisPackedErode(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions)
+{
+	return PackedMorph(picIn, picOut, pTempBuffer, pStrEl, nRepetitions, TRUE, FALSE);
+}
+
+OSC_ERR OscVisPackedDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions)
+{
+	return PackedMorph(picIn, picOut, pTempBuffer, pStrEl, nRepetitions, FALSE, FALSE);
+}
+
+OSC_ERR OscVisPackedOpen(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions)
+{
+	return PackedMorph(picIn, picOut, pTempBuffer, pStrEl, nRepetitions, TRUE, TRUE);
+}
+
+OSC_ERR OscVisPackedClose(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint32 *pTempBuffer, struct OSC_VIS_STREL *pStrEl, uint8 nRepetitions)
+{
+	return PackedMorph(picIn, picOut, pTempBuffer, pStrEl, nRepetitions, FALSE, TRUE);
+}
+
+/* Internal function: Erosion or dilation along one line of pixels with the van Herk/Gil-Werman
+ * algorithm. The padded line is split into blocks of the window length k. For every block, the
+ * running minimum (maximum) is computed from the left (pPrefix) and from the right (pSuffix), a
+ * window then covers the end of one block and the start of the next: out[i] = min(pSuffix[i],
+ * pPrefix[i + k - 1]). pBuf must hold 3 * (n + 2 * k) bytes. */
+static void GreyMorphLine(uint8 *pLine, const ptrdiff_t stride, const uint16 n, const uint16 k, const bool isErosion, uint8 *pBuf)
+{
+	const uint16 a = (k - 1) >> 1;
+	const uint32 len = ((n + k - 1 + k - 1) / k) * k;
+	const uint8 fill = isErosion ? 255 : 0;
+	uint8 *pPadded = pBuf;
+	uint8 *pPrefix = &pBuf[len];
+	uint8 *pSuffix = &pBuf[2 * len];
+	uint32 i, j, block;
+	
+	/* gather the line, padded with the neutral element */
+	memset(pPadded, fill, a);
+	for (i = 0; i < n; i++)
+		pPadded[a + i] = pLine[i * stride];
+	memset(&pPadded[a + n], fill, len - a - n);
+	
+	for (block = 0; block < len; block += k)
+	{
+		const uint8 *pIn = &pPadded[block];
+		uint8 *pPre = &pPrefix[block];
+		uint8 *pSuf = &pSuffix[block];
+		
+		pPre[0] = pIn[0];
+		pSuf[k - 1] = pIn[k - 1];
+		if (isErosion)
+		{
+			for (j = 1; j < k; j++)
+				pPre[j] = MIN(pPre[j - 1], pIn[j]);
+			for (j = k - 1; j > 0; j--)
+				pSuf[j - 1] = MIN(pSuf[j], pIn[j - 1]);
+		}
+		else
+		{
+			for (j = 1; j < k; j++)
+				pPre[j] = MAX(pPre[j - 1], pIn[j]);
+			for (j = k - 1; j > 0; j--)
+				pSuf[j - 1] = MAX(pSuf[j], pIn[j - 1]);
+		}
+	}
+	
+	/* scatter the result */
+	if (isErosion)
+	{
+		for (i = 0; i < n; i++)
+			pLine[i * stride] = MIN(pSuffix[i], pPrefix[i + k - 1]);
+	}
+	else
+	{
+		for (i = 0; i < n; i++)
+			pLine[i * stride] = MAX(pSuffix[i], pPrefix[i + k - 1]);
+	}
+}
+
+/* Internal function: Erosion or dilation of a greyscale image in-place. pBuf holds
+ * OSC_VIS_GREY_MORPH_TEMP_SIZE() bytes. */
+static OSC_ERR GreyMorph(uint8 *pImg, const uint16 width, const uint16 height, const struct OSC_VIS_GREY_STREL *pStrEl, const bool isErosion, uint8 *pBuf)
+{
+	uint16 lenH = 1, lenV = 1, lenD = 1;
+	bool isRising = FALSE;
+	uint32 x, y, c;
+	
+	switch (pStrEl->shape)
+	{
+	case OSC_VIS_GREY_STREL_RECT:
+		lenH = pStrEl->width;
+		lenV = pStrEl->height;
+		break;
+	case OSC_VIS_GREY_STREL_LINE_0:
+		lenH = pStrEl->width;
+		break;
+	case OSC_VIS_GREY_STREL_LINE_90:
+		lenV = pStrEl->width;
+		break;
+	case OSC_VIS_GREY_STREL_LINE_45:
+		lenD = pStrEl->width;
+		isRising = TRUE;
+		break;
+	case OSC_VIS_GREY_STREL_LINE_135:
+		lenD = pStrEl->width;
+		break;
+	default:
+		return -EINVALID_PARAMETER;
+	}
+	if (lenH == 0 || lenV == 0 || lenD == 0)
+		return -EINVALID_PARAMETER;
+	
+	if (lenH > 1)
+		for (y = 0; y < height; y++)
+			GreyMorphLine(&pImg[y * width], 1, width, lenH, isErosion, pBuf);
+	if (lenV > 1)
+		for (x = 0; x < width; x++)
+			GreyMorphLine(&pImg[x], width, height, lenV, isErosion, pBuf);
+	if (lenD > 1)
+	{
+		/* every diagonal starts in the first row or in the last (45 degrees) resp. first
+		 * (135 degrees) column and runs downwards */
+		const ptrdiff_t strideD = isRising ? (ptrdiff_t)width - 1 : (ptrdiff_t)width + 1;
+		for (c = 0; c < (uint32)width + height - 1; c++)
+		{
+			uint32 x0, y0, n;
+			if (c < width)
+			{
+				x0 = isRising ? c : width - 1 - c;
+				y0 = 0;
+			}
+			else
+			{
+				x0 = isRising ? width - 1 : 0;
+				y0 = c - width + 1;
+			}
+			if (isRising)
+				n = MIN(x0 + 1, height - y0);
+			else
+				n = MIN(width - x0, height - y0);
+			GreyMorphLine(&pImg[y0 * width + x0], strideD, n, lenD, isErosion, pBuf);
+		}
+	}
+	return SUCCESS;
+}
+
+/* Internal function: Applies a sequence of grey-level erosions and dilations. */
+static OSC_ERR GreyMorphSequence(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl, const bool isErosionFirst, const bool isCompound)
+{
+	const uint16 width = picIn->width;
+	const uint16 height = picIn->height;
+	OSC_ERR err;
+	
+	if (picIn->type != OSC_PICTURE_GREYSCALE || pTemp == NULL)
+		return -EINVALID_PARAMETER;
+	
+	if (picOut->data != picIn->data)
+		memcpy(picOut->data, picIn->data, sizeof(uint8) * width * height);
+	
+	err = GreyMorph((uint8*)picOut->data, width, height, pStrEl, isErosionFirst, pTemp);
+	if (err == SUCCESS && isCompound)
+		err = GreyMorph((uint8*)picOut->data, width, height, pStrEl, !isErosionFirst, pTemp);
+	if (err != SUCCESS)
+		return err;
+	
+	/* finalize picture */
+	picOut->height = height;
+	picOut->width = width;
+	picOut->type = OSC_PICTURE_GREYSCALE;
+	return SUCCESS;
+}
+
+OSC_ERR OscVisGreyErode(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl)
+{
+	return GreyMorphSequence(picIn, picOut, pTemp, pStrEl, TRUE, FALSE);
+}
+
+OSC_ERR OscVisGreyDilate(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl)
+{
+	return GreyMorphSequence(picIn, picOut, pTemp, pStrEl, FALSE, FALSE);
+}
+
+OSC_ERR OscVisGreyOpen(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl)
+{
+	return GreyMorphSequence(picIn, picOut, pTemp, pStrEl, TRUE, TRUE);
+}
+
+OSC_ERR OscVisGreyClose(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl)
+{
+	return GreyMorphSequence(picIn, picOut, pTemp, pStrEl, FALSE, TRUE);
+}
+
+OSC_ERR OscVisGreyTopHat(struct OSC_PICTURE *picIn, struct OSC_PICTURE *picOut, uint8 *pTemp, struct OSC_VIS_GREY_STREL *pStrEl, bool bDarkIsForeground)
+{
+	const uint32 nPixels = picIn->width * picIn->height;
+	const uint8 *pIn = (uint8*)picIn->data;
+	uint8 *pOut = (uint8*)picOut->data;
+	struct OSC_PICTURE picSrc = *picIn;
+	uint32 i;
+	OSC_ERR err;
+	
+	if (pTemp == NULL)
+		return -EINVALID_PARAMETER;
+	
+	/* keep a copy of the input if operating in-place, the line buffers follow it */
+	if (picIn->data == picOut->data)
+	{
+		memcpy(pTemp, pIn, sizeof(uint8) * nPixels);
+		pIn = pTemp;
+		picSrc.data = pTemp;
+		pTemp += nPixels;
+	}
+	
+	err = GreyMorphSequence(&picSrc, picOut, pTemp, pStrEl, !bDarkIsForeground, TRUE);
+	if (err != SUCCESS)
+		return err;
+	
+	if (bDarkIsForeground)
+	{
+		for (i = 0; i < nPixels; i++)
+			pOut[i] = pOut[i] - pIn[i];
+	}
+	else
+	{
+		for (i = 0; i < nPixels; i++)
+			pOut[i] = pIn[i] - pOut[i];
+	}
+	return SUCCESS;
+}
@@ -24,9 +24,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
 
 #include "vis.h"
 
+/* Internal structure: Statistics accumulated for a run and, after merging, for its root. */
+struct REGION_ACCU {
+	uint32 area;
+	int32 perimeter;
+	uint64_t sumX, sumY, sumXX, sumYY, sumXY;
+	uint32 sumGrey;
+	uint16 top, bottom, left, right;
+};
+
 /* Internal debug function. Prints the object properties to the console. */
 void PrintObjectProperties(struct OSC_VIS_REGIONS *regions)
 {
@@ -172,12 +182,57 @@ struct OSC_VIS_REGIONS_RUN * findLastChainNode(struct OSC_VIS_REGIONS_RUN *node)
 	return node;
 }
 
-/* Internal function: Checks the connectedness of the current detect run to the run(s) in the previous row */
-void checkConnectedness(struct OSC_VIS_REGIONS_RUN *runArray, uint16 currentRun, uint16 lastRowRunOffset, uint16 lastRowRunCount)
+/* Internal function: Initializes the accumulator of a run. */
+static void InitAccu(struct REGION_ACCU *pAccu, const struct OSC_VIS_REGIONS_RUN *pRun, const uint8 *pGreyRow)
+{
+	const uint64_t s = pRun->startColumn, e = pRun->endColumn, r = pRun->row;
+	const uint32 len = e - s + 1;
+	uint32 x;
+	
+	pAccu->area = len;
+	/* every run has 2 * len + 2 pixel edges, the edges shared with the previous row are subtracted later */
+	pAccu->perimeter = 2 * len + 2;
+	pAccu->sumX = (s + e) * len / 2;
+	/* sum of x^2 for x = s .. e */
+	pAccu->sumXX = (e * (e + 1) * (2 * e + 1) - (s == 0 ? 0 : (s - 1) * s * (2 * s - 1))) / 6;
+	pAccu->sumY = r * len;
+	pAccu->sumYY = r * r * len;
+	pAccu->sumXY = r * pAccu->sumX;
+	pAccu->sumGrey = 0;
+	if (pGreyRow != NULL)
+		for (x = s; x <= e; x++)
+			pAccu->sumGrey += pGreyRow[x];
+	pAccu->top = r;
+	pAccu->bottom = r + 1;
+	pAccu->left = s;
+	pAccu->right = e;
+}
+
+/* Internal function: Adds the accumulator of a root that has been unioned to the one of its new root. */
+static void MergeAccu(struct REGION_ACCU *pDst, const struct REGION_ACCU *pSrc)
+{
+	pDst->area += pSrc->area;
+	pDst->perimeter += pSrc->perimeter;
+	pDst->sumX += pSrc->sumX;
+	pDst->sumY += pSrc->sumY;
+	pDst->sumXX += pSrc->sumXX;
+	pDst->sumYY += pSrc->sumYY;
+	pDst->sumXY += pSrc->sumXY;
+	pDst->sumGrey += pSrc->sumGrey;
+	pDst->top = MIN(pDst->top, pSrc->top);
+	pDst->bottom = MAX(pDst->bottom, pSrc->bottom);
+	pDst->left = MIN(pDst->left, pSrc->left);
+	pDst->right = MAX(pDst->right, pSrc->right);
+}
+
+/* Internal function: Checks the connectedness of the current detect run to the run(s) in the previous row.
+ * If pAccus is not NULL, the accumulators of unioned roots are merged. */
+void checkConnectedness(struct OSC_VIS_REGIONS_RUN *runArray, struct REGION_ACCU *pAccus, uint32 currentRun, uint32 lastRowRunOffset, uint32 lastRowRunCount)
 {
 	bool isOverlap = FALSE;
 	struct OSC_VIS_REGIONS_RUN *rootA, *rootB, *lastNode;
-	uint16 i;
+	uint32 i;
+	int32 sharedEdges = 0;
 	/*printf("Compare %u [%u] (%u-times, offset %u) with\n ",currentRun+1, (uint)&runArray[currentRun], lastRowRunCount, lastRowRunOffset);*/
 	for(i = 0; i < lastRowRunCount; i++)
 	{
@@ -189,11 +244,16 @@ void checkConnectedness(struct OSC_VIS_REGIONS_RUN *runArray, uint16 currentRun,
 			/*printf("%u [%u] \n",lastRowRunOffset+i+1, (uint)&runArray[lastRowRunOffset+i]);*/
 			rootA = findRoot(&runArray[currentRun]);
 			rootB = findRoot(&runArray[lastRowRunOffset+i]);
+			/* pixel edges shared with the previous row (4 connectedness) */
+			sharedEdges += MAX(0, (int32)MIN(runArray[currentRun].endColumn, runArray[lastRowRunOffset+i].endColumn) -
+					(int32)MAX(runArray[currentRun].startColumn, runArray[lastRowRunOffset+i].startColumn) + 1);
 			if (isOverlap == FALSE)
 			{				
 				if (rootA != rootB)
 				{
 					unionNodes(&runArray[currentRun],rootB);
+					if (pAccus != NULL)
+						MergeAccu(&pAccus[rootB - runArray], &pAccus[currentRun]);
 					if (runArray[lastRowRunOffset+i].next == NULL)
 						runArray[lastRowRunOffset+i].next = &runArray[currentRun];
 					else
@@ -211,6 +271,8 @@ void checkConnectedness(struct OSC_VIS_REGIONS_RUN *runArray, uint16 currentRun,
 				if (rootA != rootB)
 				{
 					unionNodes(rootB,rootA);
+					if (pAccus != NULL)
+						MergeAccu(&pAccus[rootA - runArray], &pAccus[rootB - runArray]);
 					if (runArray[currentRun].next == NULL)
 						runArray[currentRun].next = rootB;
 					else
@@ -223,138 +285,431 @@ void checkConnectedness(struct OSC_VIS_REGIONS_RUN *runArray, uint16 currentRun,
 		}
 		
 	}
+	if (pAccus != NULL && sharedEdges > 0)
+		pAccus[findRoot(&runArray[currentRun]) - runArray].perimeter -= 2 * sharedEdges;
 	/*printf("\n");*/
 }
 
 
-/* Internal function: Labels all the regions incrementally */
-uint16 LabelRegions(struct OSC_VIS_REGIONS *regions)
+/* Internal function: Makes room for more runs in a growable region set. The runs are linked by
+ * pointers, which are moved to the new storage along with the runs. */
+static bool GrowRuns(struct OSC_VIS_REGION_SET *pSet)
 {
-	uint16 label = 1;
-	uint16 k = 0;
-	struct OSC_VIS_REGIONS_RUN *root;
-	uint16 i;
+	const uint32 newMax = pSet->maxNoOfRuns ? 2 * pSet->maxNoOfRuns : 256;
+	struct OSC_VIS_REGIONS_RUN *oldRuns = pSet->runs;
+	struct OSC_VIS_REGIONS_RUN *newRuns;
+	struct REGION_ACCU *newAccus;
+	uint32 i;
+	
+	if (!pSet->isGrowable)
+		return FALSE;
+	if (pSet->stats != NULL)
+	{
+		newAccus = realloc(pSet->pAccus, sizeof(struct REGION_ACCU) * newMax);
+		if (newAccus == NULL)
+			return FALSE;
+		pSet->pAccus = newAccus;
+	}
+	newRuns = malloc(sizeof(struct OSC_VIS_REGIONS_RUN) * newMax);
+	if (newRuns == NULL)
+		return FALSE;
+	
+	for (i = 0; i < pSet->noOfRuns; i++)
+	{
+		newRuns[i] = oldRuns[i];
+		if (oldRuns[i].parent != NULL)
+			newRuns[i].parent = &newRuns[oldRuns[i].parent - oldRuns];
+		if (oldRuns[i].next != NULL)
+			newRuns[i].next = &newRuns[oldRuns[i].next - oldRuns];
+	}
+	free(oldRuns);
+	pSet->runs = newRuns;
+	pSet->maxNoOfRuns = newMax;
+	return TRUE;
+}
+
+/* Internal function: Makes room for more objects in a growable region set. */
+static bool GrowObjects(struct OSC_VIS_REGION_SET *pSet)
+{
+	const uint32 newMax = pSet->maxNoOfObjects ? 2 * pSet->maxNoOfObjects : 64;
+	struct OSC_VIS_REGIONS_OBJECT *newObjects;
+	struct OSC_VIS_REGION_STATS *newStats;
 	
+	if (!pSet->isGrowable)
+		return FALSE;
+	if (pSet->stats != NULL)
+	{
+		newStats = realloc(pSet->stats, sizeof(struct OSC_VIS_REGION_STATS) * newMax);
+		if (newStats == NULL)
+			return FALSE;
+		pSet->stats = newStats;
+	}
+	newObjects = realloc(pSet->objects, sizeof(struct OSC_VIS_REGIONS_OBJECT) * newMax);
+	if (newObjects == NULL)
+		return FALSE;
+	pSet->objects = newObjects;
+	pSet->maxNoOfObjects = newMax;
+	return TRUE;
+}
+
+/* Internal function: Derives the statistics and properties of an object from the accumulator of its root. */
+static void FillObjectStats(struct OSC_VIS_REGIONS_OBJECT *pObject, struct OSC_VIS_REGION_STATS *pStats, const struct REGION_ACCU *pAccu)
+{
+	const double area = pAccu->area;
+	const double cx = pAccu->sumX / area, cy = pAccu->sumY / area;
+	double mu20, mu02, mu11, common, lambda1, lambda2;
+	
+	mu20 = pAccu->sumXX / area - cx * cx;
+	mu02 = pAccu->sumYY / area - cy * cy;
+	mu11 = pAccu->sumXY / area - cx * cy;
+	/* eigenvalues of the covariance matrix */
+	common = sqrt((mu20 - mu02) * (mu20 - mu02) / 4 + mu11 * mu11);
+	lambda1 = (mu20 + mu02) / 2 + common;
+	lambda2 = (mu20 + mu02) / 2 - common;
+	
+	pStats->area = pAccu->area;
+	pStats->perimeter = pAccu->perimeter;
+	pStats->centroidX = cx;
+	pStats->centroidY = cy;
+	pStats->bboxTop = pAccu->top;
+	pStats->bboxBottom = pAccu->bottom;
+	pStats->bboxLeft = pAccu->left;
+	pStats->bboxRight = pAccu->right;
+	pStats->mu20 = mu20;
+	pStats->mu02 = mu02;
+	pStats->mu11 = mu11;
+	pStats->orientation = 0.5 * atan2(2 * mu11, mu20 - mu02);
+	pStats->eccentricity = lambda1 > 0 ? sqrt(1 - MAX(lambda2, 0) / lambda1) : 0;
+	pStats->meanIntensity = (pAccu->sumGrey + pAccu->area / 2) / pAccu->area;
+	
+	pObject->area = MIN(pAccu->area, UINT16_MAX);
+	pObject->perimeter = MIN(pAccu->perimeter, UINT16_MAX);
+	pObject->centroidX = pAccu->sumX / pAccu->area;
+	pObject->centroidY = pAccu->sumY / pAccu->area;
+	pObject->bboxTop = pAccu->top;
+	pObject->bboxBottom = pAccu->bottom;
+	pObject->bboxLeft = pAccu->left;
+	pObject->bboxRight = pAccu->right;
+}
+
+/* Internal function: Labels all the regions incrementally. Returns FALSE if the object storage is
+ * exhausted, the runs of the objects stored so far are labeled nevertheless. */
+static bool LabelRegions(struct OSC_VIS_REGION_SET *pSet)
+{
+	const struct REGION_ACCU *pAccus = pSet->pAccus;
+	struct OSC_VIS_REGIONS_RUN *root;
+	bool bComplete = TRUE;
+	uint32 i;
 	
+	pSet->noOfObjects = 0;
 	/* search for roots */
-	for(i = 0; i < regions->noOfRuns; i++)
+	for(i = 0; i < pSet->noOfRuns; i++)
 	{
-		if (regions->runs[i].parent == NULL)
+		if (pSet->runs[i].parent == NULL)
 		{
-			regions->runs[i].label = label;
-			regions->objects[k].root = &regions->runs[i];
-			label++;
-			k++;
-			if(k == MAX_NO_OF_OBJECTS)
+			if (pSet->stats != NULL &&
+					(pAccus[i].area < pSet->minArea || (pSet->maxArea != 0 && pAccus[i].area > pSet->maxArea)))
+				continue;
+			if (pSet->noOfObjects == pSet->maxNoOfObjects && !GrowObjects(pSet))
+			{
+				bComplete = FALSE;
 				break;
+			}
+			pSet->objects[pSet->noOfObjects].root = &pSet->runs[i];
+			if (pSet->stats != NULL)
+				FillObjectStats(&pSet->objects[pSet->noOfObjects], &pSet->stats[pSet->noOfObjects], &pAccus[i]);
+			pSet->noOfObjects++;
+			pSet->runs[i].label = pSet->noOfObjects;
 		}
-		else
+	}
+	/* a root may come after some of its runs, so the labels are propagated afterwards. Roots
+	 * without an object have label 0, which their runs keep. */
+	for(i = 0; i < pSet->noOfRuns; i++)
+	{
+		if (pSet->runs[i].parent != NULL)
 		{
-			root = findRoot(&regions->runs[i]);
-			regions->runs[i].label = root->label;
+			root = findRoot(&pSet->runs[i]);
+			pSet->runs[i].label = root->label;
 		}
 	}
-	return label-1;	
+	return bComplete;
 }
 
-/* The actual API function providing connected component labeling */
-OSC_ERR OscVisLabelBinary(struct OSC_PICTURE *picIn, struct OSC_VIS_REGIONS *regions)
+/* Internal type: Machine word used to scan rows of binary images. */
+typedef uintptr_t __attribute__((__may_alias__)) SCAN_WORD;
+
+/* Internal function: Returns TRUE if a machine word contains a zero byte. */
+static inline bool HasZeroByte(const SCAN_WORD word)
+{
+	const SCAN_WORD ones = ~(SCAN_WORD)0 / 0xff;
+	
+	return ((word - ones) & ~word & (ones << 7)) != 0;
+}
+
+/* Internal function: Returns the index of the first pixel at or after i that is foreground
+ * (any nonzero value) if bForeground is FALSE, or background (zero) if bForeground is TRUE.
+ * Whole machine words of skipped pixels are skipped at once. */
+static inline uint16 ScanRow(const uint8 *pRow, uint16 i, const uint16 width, const bool bForeground)
+{
+	/* byte-wise up to the next word boundary */
+	while (i < width && ((uintptr_t)&pRow[i] & (sizeof(SCAN_WORD) - 1)) != 0)
+	{
+		if ((pRow[i] != 0) != bForeground)
+			return i;
+		i++;
+	}
+	/* word-wise */
+	if (bForeground)
+	{
+		while (i + sizeof(SCAN_WORD) <= width && !HasZeroByte(*(const SCAN_WORD *)&pRow[i]))
+			i += sizeof(SCAN_WORD);
+	}
+	else
+	{
+		while (i + sizeof(SCAN_WORD) <= width && *(const SCAN_WORD *)&pRow[i] == 0)
+			i += sizeof(SCAN_WORD);
+	}
+	/* byte-wise for the rest */
+	while (i < width && (pRow[i] != 0) == bForeground)
+		i++;
+	return i;
+}
+
+uint32 OscVisRegionSetArenaSize(uint32 noOfRuns, bool bStatistics)
 {
-	bool lastRowIsEmpty; 
-	uint16 i,r;
-	uint16 lastRowRunOffset = 0;
-	uint16 lastRowRunCount = 0;
-	uint16 actRowRunCount = 0;
-	uint16 noOfRegions = 0;	
-	uint8 *pBinImgIn = (uint8*)picIn->data;
+	uint32 size = sizeof(struct OSC_VIS_REGIONS_RUN) + sizeof(struct OSC_VIS_REGIONS_OBJECT);
+	
+	if (bStatistics)
+		size += sizeof(struct REGION_ACCU) + sizeof(struct OSC_VIS_REGION_STATS);
+	return noOfRuns * size;
+}
+
+OSC_ERR OscVisRegionSetInit(struct OSC_VIS_REGION_SET *pSet, void *pArena, uint32 arenaSize, bool bStatistics)
+{
+	const uint32 n = arenaSize / OscVisRegionSetArenaSize(1, bStatistics);
+	
+	if (pSet == NULL || pArena == NULL || n == 0)
+		return -EINVALID_PARAMETER;
+	
+	/* there cannot be more objects than runs, the arrays are ordered by alignment */
+	pSet->runs = (struct OSC_VIS_REGIONS_RUN *)pArena;
+	pSet->objects = (struct OSC_VIS_REGIONS_OBJECT *)&pSet->runs[n];
+	pSet->pAccus = NULL;
+	pSet->stats = NULL;
+	if (bStatistics)
+	{
+		pSet->pAccus = &pSet->objects[n];
+		pSet->stats = (struct OSC_VIS_REGION_STATS *)&((struct REGION_ACCU *)pSet->pAccus)[n];
+	}
+	pSet->maxNoOfRuns = n;
+	pSet->maxNoOfObjects = n;
+	pSet->noOfRuns = 0;
+	pSet->noOfObjects = 0;
+	pSet->noOfRunsRequired = 0;
+	pSet->isGrowable = FALSE;
+	pSet->pGreyImg = NULL;
+	pSet->minArea = 0;
+	pSet->maxArea = 0;
+	return SUCCESS;
+}
+
+OSC_ERR OscVisRegionSetCreate(struct OSC_VIS_REGION_SET *pSet, uint32 initialNoOfRuns, bool bStatistics)
+{
+	if (pSet == NULL)
+		return -EINVALID_PARAMETER;
+	
+	pSet->noOfRuns = 0;
+	pSet->noOfObjects = 0;
+	pSet->noOfRunsRequired = 0;
+	pSet->maxNoOfRuns = 0;
+	pSet->maxNoOfObjects = 0;
+	pSet->runs = NULL;
+	pSet->objects = NULL;
+	pSet->pAccus = NULL;
+	pSet->stats = NULL;
+	pSet->isGrowable = TRUE;
+	pSet->pGreyImg = NULL;
+	pSet->minArea = 0;
+	pSet->maxArea = 0;
+	
+	/* at least one entry is allocated, as the statistics pointer also marks whether statistics are enabled */
+	initialNoOfRuns = MAX(initialNoOfRuns, 1);
+	pSet->runs = malloc(sizeof(struct OSC_VIS_REGIONS_RUN) * initialNoOfRuns);
+	pSet->objects = malloc(sizeof(struct OSC_VIS_REGIONS_OBJECT) * initialNoOfRuns);
+	if (bStatistics)
+	{
+		pSet->pAccus = malloc(sizeof(struct REGION_ACCU) * initialNoOfRuns);
+		pSet->stats = malloc(sizeof(struct OSC_VIS_REGION_STATS) * initialNoOfRuns);
+	}
+	if (pSet->runs == NULL || pSet->objects == NULL || (bStatistics && (pSet->pAccus == NULL || pSet->stats == NULL)))
+	{
+		OscVisRegionSetDestroy(pSet);
+		return -EOUT_OF_MEMORY;
+	}
+	pSet->maxNoOfRuns = initialNoOfRuns;
+	pSet->maxNoOfObjects = initialNoOfRuns;
+	return SUCCESS;
+}
+
+OSC_ERR OscVisRegionSetDestroy(struct OSC_VIS_REGION_SET *pSet)
+{
+	if (pSet == NULL)
+		return -EINVALID_PARAMETER;
+	
+	/* storage in a caller-provided arena belongs to the caller */
+	if (pSet->isGrowable)
+	{
+		free(pSet->runs);
+		free(pSet->objects);
+		free(pSet->pAccus);
+		free(pSet->stats);
+	}
+	pSet->runs = NULL;
+	pSet->objects = NULL;
+	pSet->pAccus = NULL;
+	pSet->stats = NULL;
+	pSet->maxNoOfRuns = 0;
+	pSet->maxNoOfObjects = 0;
+	pSet->noOfRuns = 0;
+	pSet->noOfObjects = 0;
+	return SUCCESS;
+}
+
+/* Connected component labeling into a region set */
+OSC_ERR OscVisLabelBinarySet(struct OSC_PICTURE *picIn, struct OSC_VIS_REGION_SET *pSet)
+{
+	uint16 i, r, start;
+	uint32 lastRowRunOffset = 0;
+	uint32 lastRowRunCount = 0;
+	uint32 actRowRunCount = 0;
+	bool isOverflow = FALSE;
+	const uint8 *pBinImgIn = (uint8*)picIn->data;
 	const uint16 width = picIn->width;
 	const uint16 height = picIn->height;
-	regions->noOfRuns = 0;
-	lastRowIsEmpty = TRUE;
+	struct REGION_ACCU *pAccus = NULL;
+	const uint8 *pGreyImg = NULL;
 	
+	if (pSet->stats != NULL)
+	{
+		if (pSet->pGreyImg != NULL)
+		{
+			if (pSet->pGreyImg->width != width || pSet->pGreyImg->height != height)
+				return -EINVALID_PARAMETER;
+			pGreyImg = (const uint8*)pSet->pGreyImg->data;
+		}
+	}
+	else if (pSet->minArea != 0 || pSet->maxArea != 0)
+	{
+		OscLog(ERROR, "%s: Filtering by area needs a region set with statistics.\n", __func__);
+		return -EINVALID_PARAMETER;
+	}
+	
+	pSet->noOfRuns = 0;
+	pSet->noOfObjects = 0;
+	pSet->noOfRunsRequired = 0;
 	
 	/* run length encode image and initial labeling */
 	for(r = 0; r < height; r++)
 	{
-		/*printf("--- Row #: %d\n",r);*/
+		const uint8 *pRow = &pBinImgIn[r * width];
+		
 		i = 0;
-		/*if (r > 0)
-			printf("lastRowRunCount = %u\n",actRowRunCount);*/
-		lastRowRunCount = actRowRunCount;	
-		actRowRunCount = 0;	
-		while(regions->noOfRuns < MAX_NO_OF_RUNS)
+		lastRowRunCount = actRowRunCount;
+		actRowRunCount = 0;
+		loop
 		{
 			/* search first foreground pixels in the row */
-			while(i < width && pBinImgIn[r * width + i] == 0)
-				i++;
+			i = ScanRow(pRow, i, width, FALSE);
 			/* end of row? */
 			if (i == width)
-			{
-				lastRowIsEmpty = TRUE;
 				break;
-			}
-			/* first foreground pixel found */
-			/*printf("Start Pixel \t Row: %d ; Column: %d\n",r,i);*/
-			regions->runs[regions->noOfRuns].row = r;
-			regions->runs[regions->noOfRuns].startColumn = i;
-			regions->runs[regions->noOfRuns].label = 0;
-			regions->runs[regions->noOfRuns].parent = NULL;
-			regions->runs[regions->noOfRuns].next = NULL;
-			/* search last foreground pixels in the row */
-			while(i < width && pBinImgIn[r * width + i] == 1)
-				i++;		
-			/* last foreground pixel found or reached end of line, finalize run! */
-			/*printf("End Pixel \t Row: %d ; Column: %d\n",r,i-1);*/
-			regions->runs[regions->noOfRuns].endColumn = i-1;
+			start = i;
+			/* search last foreground pixels in the row, any nonzero value is foreground and
+			 * pixel i is one, so i always advances */
+			i = ScanRow(pRow, i, width, TRUE);
 			
-			actRowRunCount++;
-			/* check connectedness only after having scanned the first line */
-			if (lastRowIsEmpty == FALSE && regions->noOfRuns > 0)
-			{									
-				/*regions->runs[regions->noOfRuns].label = label;
-				label++;*/
-				checkConnectedness(regions->runs, regions->noOfRuns, lastRowRunOffset, lastRowRunCount);	
-			}		
-			regions->noOfRuns++;					
+			pSet->noOfRunsRequired++;
+			/* when out of storage, only count the remaining runs */
+			if (!isOverflow && pSet->noOfRuns == pSet->maxNoOfRuns && !GrowRuns(pSet))
+				isOverflow = TRUE;
+			if (isOverflow)
+				continue;
 			
+			pSet->runs[pSet->noOfRuns].row = r;
+			pSet->runs[pSet->noOfRuns].startColumn = start;
+			pSet->runs[pSet->noOfRuns].endColumn = i-1;
+			pSet->runs[pSet->noOfRuns].label = 0;
+			pSet->runs[pSet->noOfRuns].parent = NULL;
+			pSet->runs[pSet->noOfRuns].next = NULL;
+			actRowRunCount++;
+			/* the accumulators may have been moved by GrowRuns() */
+			if (pSet->stats != NULL)
+			{
+				pAccus = pSet->pAccus;
+				InitAccu(&pAccus[pSet->noOfRuns], &pSet->runs[pSet->noOfRuns], pGreyImg ? &pGreyImg[r * width] : NULL);
+			}
+			/* check connectedness with the runs of the previous row */
+			if (lastRowRunCount > 0)
+				checkConnectedness(pSet->runs, pAccus, pSet->noOfRuns, lastRowRunOffset, lastRowRunCount);
+			pSet->noOfRuns++;
 		}
 		
-		if (r == 0)
-			lastRowRunOffset = 0;
-		else lastRowRunOffset = lastRowRunOffset+lastRowRunCount;				
-		lastRowIsEmpty = FALSE;		
-	}	
-	/*printf("Number of detected runs: %d\n",regions->noOfRuns);*/
-	noOfRegions = LabelRegions(regions);
-	regions->noOfObjects = noOfRegions;
-	/*printf("Number of connected components (regions): %d\n", noOfRegions);*/
-	/*PrintRegionsStruct(regions);*/
-
+		if (r > 0)
+			lastRowRunOffset = lastRowRunOffset+lastRowRunCount;
+	}
+	
+	if (!LabelRegions(pSet))
+		isOverflow = TRUE;
+	if (isOverflow)
+	{
+		OscLog(WARN, "%s: Region storage exhausted: %u runs and %u objects stored, %u runs found.\n",
+				__func__, pSet->noOfRuns, pSet->noOfObjects, pSet->noOfRunsRequired);
+		return -EBUFFER_TOO_SMALL;
+	}
 	return SUCCESS;
 }
 
+/* The actual API function providing connected component labeling */
+OSC_ERR OscVisLabelBinary(struct OSC_PICTURE *picIn, struct OSC_VIS_REGIONS *regions)
+{
+	struct OSC_VIS_REGION_SET set = {
+		.maxNoOfRuns = MAX_NO_OF_RUNS,
+		.maxNoOfObjects = MAX_NO_OF_OBJECTS,
+		.runs = regions->runs,
+		.objects = regions->objects,
+		.isGrowable = FALSE,
+		.stats = NULL
+	};
+	OSC_ERR err;
+	
+	err = OscVisLabelBinarySet(picIn, &set);
+	regions->noOfRuns = set.noOfRuns;
+	regions->noOfObjects = set.noOfObjects;
+	/*PrintRegionsStruct(regions);*/
+	return err;
+}
 
-/* Calculates several properties of the individual regions */
-OSC_ERR OscVisGetRegionProperties(struct OSC_VIS_REGIONS *regions)
+/* Internal function: Calculates the properties of the given objects by walking their run chains. */
+static void GetObjectProperties(struct OSC_VIS_REGIONS_OBJECT *objects, const uint32 noOfObjects)
 {
-	uint16 i,k;
+	uint32 i,k;
 	uint32 AreaAccu, CxAccu, CyAccu;
 	uint32 currArea, currCx, currCy, tempX;
 	struct OSC_VIS_REGIONS_RUN *currentRun;
 	
 	/* do stuff */
-	for(i = 0; i < regions->noOfObjects; i++)
+	for(i = 0; i < noOfObjects; i++)
 	{
-		currentRun = regions->objects[i].root;
+		currentRun = objects[i].root;
 		/* Init accumulators */
 		AreaAccu = 0;
 		CxAccu = 0;
 		CyAccu = 0;
 		/* Init bounding box */
-		regions->objects[i].bboxTop = currentRun->row;
-		regions->objects[i].bboxBottom = currentRun->row+1;
-		regions->objects[i].bboxLeft = currentRun->startColumn;
-		regions->objects[i].bboxRight = currentRun->endColumn;
+		objects[i].bboxTop = currentRun->row;
+		objects[i].bboxBottom = currentRun->row+1;
+		objects[i].bboxLeft = currentRun->startColumn;
+		objects[i].bboxRight = currentRun->endColumn;
 	
 		do 
 		{
@@ -373,21 +728,37 @@ OSC_ERR OscVisGetRegionProperties(struct OSC_VIS_REGIONS *regions)
 			CxAccu = CxAccu + currCx;
 			CyAccu = CyAccu + currCy;
 			/* update bounding box values */
-			regions->objects[i].bboxTop = MIN(regions->objects[i].bboxTop, currentRun->row);
-			regions->objects[i].bboxBottom = MAX(regions->objects[i].bboxBottom, currentRun->row+1);
-			regions->objects[i].bboxLeft = MIN(regions->objects[i].bboxLeft, currentRun->startColumn);
-			regions->objects[i].bboxRight = MAX(regions->objects[i].bboxRight, currentRun->endColumn); 		
+			objects[i].bboxTop = MIN(objects[i].bboxTop, currentRun->row);
+			objects[i].bboxBottom = MAX(objects[i].bboxBottom, currentRun->row+1);
+			objects[i].bboxLeft = MIN(objects[i].bboxLeft, currentRun->startColumn);
+			objects[i].bboxRight = MAX(objects[i].bboxRight, currentRun->endColumn); 		
 			currentRun = currentRun->next;
 		} while(currentRun != NULL);
 		
-		regions->objects[i].area = AreaAccu;
-		regions->objects[i].centroidX = CxAccu / AreaAccu;
-		regions->objects[i].centroidY = CyAccu / AreaAccu;
+		objects[i].area = AreaAccu;
+		objects[i].centroidX = CxAccu / AreaAccu;
+		objects[i].centroidY = CyAccu / AreaAccu;
 	}
+}
+
+/* Calculates several properties of the individual regions */
+OSC_ERR OscVisGetRegionProperties(struct OSC_VIS_REGIONS *regions)
+{
+	GetObjectProperties(regions->objects, regions->noOfObjects);
 	/*PrintObjectProperties(regions);*/
 	return SUCCESS;
 }
 
+/* Calculates several properties of the individual regions of a region set */
+OSC_ERR OscVisGetRegionSetProperties(struct OSC_VIS_REGION_SET *pSet)
+{
+	/* already filled while labeling */
+	if (pSet->stats != NULL)
+		return SUCCESS;
+	GetObjectProperties(pSet->objects, pSet->noOfObjects);
+	return SUCCESS;
+}
+
 /* Drawing Function for Centroids. Colored in red.*/
 OSC_ERR OscVisDrawCentroidMarkers(struct OSC_PICTURE *picIn, struct OSC_VIS_REGIONS *regions)
 {
@@ -25,8 +25,36 @@
 
 #include "vis.h"
 
+/*********************************************************************//*!
+ * @brief Constructor of the vis module.
+ * 
+ * @return SUCCESS
+ *//*********************************************************************/
+static OSC_ERR OscVisCreate()
+{
+#if defined(OSC_HOST)
+	FastDebayerInit();
+#endif
+	return SUCCESS;
+}
+
+/*********************************************************************//*!
+ * @brief Destructor of the vis module.
+ * 
+ * @return SUCCESS
+ *//*********************************************************************/
+static OSC_ERR OscVisDestroy()
+{
+#if defined(OSC_HOST)
+	DebayerStopThreads();
+#endif
+	return SUCCESS;
+}
+
 struct OscModule OscModule_vis = {
 	.name = "vis",
+	.create = OscVisCreate,
+	.destroy = OscVisDestroy,
 	.dependencies = {
 		&OscModule_log,
 		&OscModule_dma,
@@ -42,4 +42,24 @@ extern void debayer_grey(unsigned char *pDst,
                          unsigned int width,
                          unsigned int height);
 
+#if defined(OSC_HOST)
+/*! @brief Vectorized row kernel of the fast debayering. Converts the first pixels of the output
+ * row from the raw rows pRow0 and pRow1 and returns their number, the caller converts the rest. */
+typedef uint16 (*FAST_DEBAYER_ROW)(const uint8 *pRow0, const uint8 *pRow1, uint8 *pOut, uint16 noOfPix);
+
+/*! @brief The row kernels of an instruction set, NULL where there is none. */
+struct FAST_DEBAYER_KERNELS {
+	FAST_DEBAYER_ROW bgr, rgb, grey, lumY, chromU, chromV, yuv422;
+};
+
+/*! @brief Selects the instruction set of the fast debayering, called when the vis module is created. */
+void FastDebayerInit(void);
+
+/*! @brief Returns the row kernels of the instruction set in use, see OscVisSetSimd(). */
+const struct FAST_DEBAYER_KERNELS *FastDebayerGetKernels(void);
+
+/*! @brief Stops the threads of OscVisDebayerParallel(), which are started again when needed. */
+void DebayerStopThreads(void);
+#endif /* OSC_HOST */
+
 #endif /*VIS_PRIV_H_*/